@@ -54,6 +54,10 @@ public:
 
     /// Build SVF loops based on llvm loops
     virtual void buildSVFLoops(ICFG *icfg, std::vector<const Loop *> &llvmLoops);
+
+private:
+    /// Maximum trip counts of the loops of the current function, 0 if unknown
+    Map<const Loop *, u32_t> tripCounts;
 };
 } // End namespace SVF
 
@@ -32,6 +32,9 @@
 #include "Util/Options.h"
 #include "SVF-LLVM/LLVMUtil.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
 
 #include "llvm/Transforms/Utils/Mem2Reg.h"
 #include "llvm/Passes/PassBuilder.h"
@@ -52,6 +55,8 @@ void LLVMLoopAnalysis::buildLLVMLoops(SVFModule *mod, ICFG* icfg)
     std::vector<const Loop *> loop_stack;
     for (Module& M : LLVMModuleSet::getLLVMModuleSet()->getLLVMModules())
     {
+        llvm::TargetLibraryInfoImpl TLII(llvm::Triple(M.getTargetTriple()));
+        llvm::TargetLibraryInfo TLI(TLII);
         for (Module::const_iterator F = M.begin(), E = M.end(); F != E; ++F)
         {
             const Function* func = &*F;
@@ -59,10 +64,21 @@ void LLVMLoopAnalysis::buildLLVMLoops(SVFModule *mod, ICFG* icfg)
             if (func->isDeclaration()) continue;
             // do not analyze external call
             if (SVFUtil::isExtCall(svffun)) continue;
-            DT.recalculate(const_cast<Function&>(*func));
-            llvm::LoopInfoBase<llvm::BasicBlock, llvm::Loop> loopInfo;
+            Function& fun = const_cast<Function&>(*func);
+            DT.recalculate(fun);
+            llvm::LoopInfo loopInfo;
             std::vector<const Loop*> llvmLoops;
             loopInfo.analyze(DT);
+            // trip counts are taken as loop bounds where scalar evolution can compute them,
+            // only with -ae-exact-loop-iter, the loop bounds stay Options::LoopBound() otherwise
+            std::unique_ptr<llvm::AssumptionCache> AC;
+            std::unique_ptr<llvm::ScalarEvolution> SE;
+            if (Options::AEExactLoopIter() > 0 && !loopInfo.empty())
+            {
+                AC = std::make_unique<llvm::AssumptionCache>(fun);
+                SE = std::make_unique<llvm::ScalarEvolution>(fun, TLI, *AC, DT, loopInfo);
+            }
+            tripCounts.clear();
             for (const auto &loop: loopInfo)
             {
                 loop_stack.push_back(loop);
@@ -73,6 +89,8 @@ void LLVMLoopAnalysis::buildLLVMLoops(SVFModule *mod, ICFG* icfg)
                 const Loop *loop = loop_stack.back();
                 loop_stack.pop_back();
                 llvmLoops.push_back(loop);
+                if (SE)
+                    tripCounts[loop] = SE->getSmallConstantMaxTripCount(const_cast<Loop*>(loop));
                 for (const auto &subloop: loop->getSubLoops())
                 {
                     loop_stack.push_back(subloop);
@@ -115,7 +133,9 @@ void LLVMLoopAnalysis::buildSVFLoops(ICFG *icfg, std::vector<const Loop *> &llvm
                 nodes.insert(icfg->getICFGNode(svfInst));
             }
         }
-        SVFLoop *svf_loop = new SVFLoop(nodes, Options::LoopBound());
+        auto tripCount = tripCounts.find(llvmLoop);
+        u32_t bound = tripCount != tripCounts.end() && tripCount->second > 0 ? tripCount->second : Options::LoopBound();
+        SVFLoop *svf_loop = new SVFLoop(nodes, bound);
         for (const auto &node: nodes)
         {
             icfg->addNodeToSVFLoop(node, svf_loop);
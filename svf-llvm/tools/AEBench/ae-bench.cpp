@@ -0,0 +1,199 @@
+//===- ae-bench.cpp -- Microbenchmark of interval arithmetic -----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Microbenchmark of the IntervalValue operators used by abstract execution.
+ // Applies each operator to pairs of random finite intervals and reports the
+ // time per operation, e.g., ./ae-bench -bench-intervals=65536 -bench-rounds=20
+ // add(old) and mul(old) time a reference copy of the arithmetic before the
+ // finite fast path, so that both versions are measured in the same run.
+ */
+// before NumericValue.h, which defines an epsilon macro
+#include <chrono>
+#include <random>
+
+#include "Util/CommandLine.h"
+#include "Util/SVFUtil.h"
+#include "AE/Core/IntervalValue.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+static Option<u32_t> BenchIntervals(
+    "bench-intervals",
+    "Number of random interval pairs",
+    65536
+);
+
+static Option<u32_t> BenchRounds(
+    "bench-rounds",
+    "Number of passes over the intervals per operator",
+    20
+);
+
+static Option<u32_t> BenchBound(
+    "bench-bound",
+    "Random bounds are taken from [-bench-bound, bench-bound]",
+    1000000
+);
+
+/// Random finite intervals, with a fixed seed so that runs are comparable
+static std::vector<IntervalValue> randomIntervals(u32_t num, s64_t bound, std::mt19937_64& rng)
+{
+    std::uniform_int_distribution<s64_t> dist(-bound, bound);
+    std::vector<IntervalValue> intervals;
+    intervals.reserve(num);
+    for (u32_t i = 0; i < num; ++i)
+    {
+        s64_t a = dist(rng), b = dist(rng);
+        intervals.push_back(IntervalValue(std::min(a, b), std::max(a, b)));
+    }
+    return intervals;
+}
+
+/// Reference copy of BoundedInt::safeAdd before the finite fast path
+static BoundedInt oldSafeAdd(const BoundedInt& lhs, const BoundedInt& rhs)
+{
+    if ((lhs.is_plus_infinity() && rhs.is_minus_infinity()) ||
+            (lhs.is_minus_infinity() && rhs.is_plus_infinity()))
+    {
+        assert(false && "invalid add");
+    }
+    if (lhs.is_plus_infinity() || rhs.is_plus_infinity())
+        return BoundedInt::plus_infinity();
+    if (lhs.is_minus_infinity() || rhs.is_minus_infinity())
+        return BoundedInt::minus_infinity();
+    s64_t l = lhs.getNumeral(), r = rhs.getNumeral();
+    if (l > 0 && r > 0 && (std::numeric_limits<s64_t>::max() - l) < r)
+        return BoundedInt::plus_infinity();
+    if (l < 0 && r < 0 && (-std::numeric_limits<s64_t>::max() - l) > r)
+        return BoundedInt::minus_infinity();
+    return l + r;
+}
+
+/// Reference copy of BoundedInt::safeMul before the finite fast path
+static BoundedInt oldSafeMul(const BoundedInt& lhs, const BoundedInt& rhs)
+{
+    // an infinite bound is stored as +1/-1
+    s64_t l = lhs.is_infinity() ? (lhs.is_plus_infinity() ? 1 : -1) : lhs.getNumeral();
+    s64_t r = rhs.is_infinity() ? (rhs.is_plus_infinity() ? 1 : -1) : rhs.getNumeral();
+    if (l == 0 || r == 0)
+        return 0;
+    if (lhs.is_infinity() || rhs.is_infinity())
+    {
+        if ((l > 0) == (r > 0))
+            return BoundedInt::plus_infinity();
+        else
+            return BoundedInt::minus_infinity();
+    }
+    if (l > 0 && r > 0 && (std::numeric_limits<s64_t>::max() / l) < r)
+        return BoundedInt::plus_infinity();
+    if (l < 0 && r < 0 && (std::numeric_limits<s64_t>::max() / l) > r)
+        return BoundedInt::plus_infinity();
+    if ((l > 0 && r < 0 && (-std::numeric_limits<s64_t>::max() / l) > r) ||
+            (l < 0 && r > 0 && (-std::numeric_limits<s64_t>::max() / r) > l))
+        return BoundedInt::minus_infinity();
+    return l * r;
+}
+
+/// Reference copy of interval + before the finite fast path
+static IntervalValue oldAdd(const IntervalValue& lhs, const IntervalValue& rhs)
+{
+    if (lhs.isBottom() || rhs.isBottom())
+        return IntervalValue::bottom();
+    else if (lhs.isTop() || rhs.isTop())
+        return IntervalValue::top();
+    else
+        return IntervalValue(oldSafeAdd(lhs.lb(), rhs.lb()), oldSafeAdd(lhs.ub(), rhs.ub()));
+}
+
+/// Reference copy of interval * before the finite fast path, including the
+/// vector of the four bounds
+static IntervalValue oldMul(const IntervalValue& lhs, const IntervalValue& rhs)
+{
+    if (lhs.isBottom() || rhs.isBottom())
+        return IntervalValue::bottom();
+    std::vector<BoundedInt> bounds{oldSafeMul(lhs.lb(), rhs.lb()), oldSafeMul(lhs.lb(), rhs.ub()),
+                                   oldSafeMul(lhs.ub(), rhs.lb()), oldSafeMul(lhs.ub(), rhs.ub())};
+    return IntervalValue(BoundedInt::min(bounds), BoundedInt::max(bounds));
+}
+
+/// Time op over all pairs, print ns/op
+template <typename BinaryOp>
+static void bench(const std::string& name, const std::vector<IntervalValue>& lhs,
+                  const std::vector<IntervalValue>& rhs, BinaryOp op)
+{
+    std::vector<IntervalValue> res(lhs.size());
+    // untimed pass to warm up caches
+    for (u32_t i = 0; i < lhs.size(); ++i)
+        res[i] = op(lhs[i], rhs[i]);
+    u32_t numOfTop = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (u32_t r = 0; r < BenchRounds(); ++r)
+    {
+        for (u32_t i = 0; i < lhs.size(); ++i)
+            res[i] = op(lhs[i], rhs[i]);
+        // keep the results alive
+        numOfTop += res[r % res.size()].isTop();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double ops = (double) lhs.size() * BenchRounds();
+    outs() << name << "\t" << ns / ops << " ns/op\t(" << numOfTop << " top)\n";
+}
+
+int main(int argc, char** argv)
+{
+    OptionBase::parseOptions(argc, argv, "Interval Arithmetic Benchmark", "[options]");
+    if (BenchIntervals() == 0)
+        return 0;
+
+    std::mt19937_64 rng(0);
+    std::vector<IntervalValue> lhs = randomIntervals(BenchIntervals(), BenchBound(), rng);
+    std::vector<IntervalValue> rhs = randomIntervals(BenchIntervals(), BenchBound(), rng);
+
+    bench("add(old)", lhs, rhs, oldAdd);
+    bench("add", lhs, rhs, [](const IntervalValue& a, const IntervalValue& b)
+    {
+        return a + b;
+    });
+    bench("sub", lhs, rhs, [](const IntervalValue& a, const IntervalValue& b)
+    {
+        return a - b;
+    });
+    bench("mul(old)", lhs, rhs, oldMul);
+    bench("mul", lhs, rhs, [](const IntervalValue& a, const IntervalValue& b)
+    {
+        return a * b;
+    });
+    bench("div", lhs, rhs, [](const IntervalValue& a, const IntervalValue& b)
+    {
+        return a / b;
+    });
+    bench("join", lhs, rhs, [](const IntervalValue& a, const IntervalValue& b)
+    {
+        IntervalValue res = a;
+        res.join_with(b);
+        return res;
+    });
+    return 0;
+}
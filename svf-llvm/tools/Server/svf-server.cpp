@@ -0,0 +1,387 @@
+//===- svf-server.cpp -- Pointer analysis query server ------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ // Pointer analysis query server
+ //
+ // Loads a module once, keeps its SVFIR, Andersen's results and optionally the
+ // SVFG resident, and answers queries read from stdin or from the clients of a
+ // Unix socket. Every request is one line, every response is one line:
+ //
+ //   alias <ptr> <ptr>        -> ok <us> NoAlias|MayAlias|MustAlias|PartialAlias
+ //   pts <ptr>                -> ok <us> <obj> ...
+ //   find <name>              -> ok <us> <node> ...   (SVFIR nodes of a value name)
+ //   callees <callsite>       -> ok <us> <function> ... (callsite is an ICFG node)
+ //   callers <function>       -> ok <us> <callsite> ...
+ //   reach <src> <dst>        -> ok <us> 1|0   (value-flow on the SVFG with -server-svfg,
+ //                                              control-flow on the ICFG otherwise)
+ //   stats                    -> ok <us> <command>:<count>:<avg us>:<max us> ...
+ //   quit
+ //
+ // Errors are reported as "err <message>".
+ //
+ // Requests of all clients are answered one at a time: the analysis results keep
+ // mutable caches (e.g., the cursors of bit vectors) even when only read, so they
+ // cannot be shared by concurrent readers. The reported <us> is the time spent
+ // answering the request, without the wait for requests of other clients.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "WPA/Andersen.h"
+#include "MSSA/SVFGBuilder.h"
+#include "Util/CommandLine.h"
+#include "Util/Options.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace std;
+using namespace SVF;
+
+static Option<std::string> ServerSocket(
+    "server-socket",
+    "Serve clients of this Unix socket instead of stdin/stdout",
+    ""
+);
+
+static Option<bool> ServerSVFG(
+    "server-svfg",
+    "Build the SVFG and answer reach queries on value-flows",
+    false
+);
+
+/*!
+ * Resident analysis results answering one request at a time
+ */
+class QueryServer
+{
+public:
+    QueryServer(SVFIR* p, AndersenWaveDiff* a, SVFG* g) : pag(p), ander(a), svfg(g)
+    {
+        /// getPts may insert an empty set, create all of them before serving
+        for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+            ander->getPts(it->first);
+    }
+
+    /// Answer one request, return false if the client quits
+    bool answer(const std::string& request, std::string& response)
+    {
+        std::istringstream in(request);
+        std::string cmd;
+        in >> cmd;
+        if (cmd.empty())
+            return true;
+        if (cmd == "quit")
+            return false;
+
+        std::ostringstream out;
+        bool ok;
+        u64_t us;
+        {
+            /// queries read shared analysis state with mutable caches, e.g., bit vector iterators,
+            /// the latency is timed once the lock is held
+            std::lock_guard<std::mutex> guard(lock);
+            auto start = std::chrono::steady_clock::now();
+            ok = dispatch(cmd, in, out);
+            us = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start).count();
+        }
+
+        if (ok)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            Latency& lat = latencies[cmd];
+            lat.count++;
+            lat.total += us;
+            lat.max = std::max(lat.max, us);
+            response = "ok " + std::to_string(us) + out.str();
+        }
+        else
+            response = "err " + out.str();
+        return true;
+    }
+
+private:
+    struct Latency
+    {
+        u64_t count = 0;
+        u64_t total = 0;
+        u64_t max = 0;
+    };
+
+    bool dispatch(const std::string& cmd, std::istringstream& in, std::ostringstream& out)
+    {
+        NodeID src, dst;
+        std::string name;
+        if (cmd == "alias" && in >> src >> dst && pag->hasGNode(src) && pag->hasGNode(dst))
+            out << " " << aliasName(ander->alias(src, dst));
+        else if (cmd == "pts" && in >> src && pag->hasGNode(src))
+        {
+            for (NodeID o : ander->getPts(src))
+                out << " " << o;
+        }
+        else if (cmd == "find" && in >> name)
+        {
+            for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+                if (it->second->hasValue() && it->second->getValueName() == name)
+                    out << " " << it->first;
+        }
+        else if (cmd == "callees" && in >> src && pag->getICFG()->hasGNode(src) &&
+                 SVFUtil::isa<CallICFGNode>(pag->getICFG()->getGNode(src)))
+        {
+            CallGraph::FunctionSet callees;
+            ander->getCallGraph()->getCallees(SVFUtil::cast<CallICFGNode>(pag->getICFG()->getGNode(src)), callees);
+            for (const SVFFunction* fun : callees)
+                out << " " << fun->getName();
+        }
+        else if (cmd == "callers" && in >> name && pag->getModule()->getSVFFunction(name))
+        {
+            CallGraphEdge::CallInstSet callsites;
+            ander->getCallGraph()->getAllCallSitesInvokingCallee(pag->getModule()->getSVFFunction(name), callsites);
+            for (const CallICFGNode* cs : callsites)
+                out << " " << cs->getId();
+        }
+        else if (cmd == "reach" && in >> src >> dst)
+        {
+            if (svfg)
+            {
+                if (!svfg->hasGNode(src) || !svfg->hasGNode(dst))
+                    return error(out, "unknown SVFG node");
+                out << " " << reach(svfg, src, dst);
+            }
+            else
+            {
+                if (!pag->getICFG()->hasGNode(src) || !pag->getICFG()->hasGNode(dst))
+                    return error(out, "unknown ICFG node");
+                out << " " << reach(pag->getICFG(), src, dst);
+            }
+        }
+        else if (cmd == "stats")
+        {
+            for (const auto& it : latencies)
+                out << " " << it.first << ":" << it.second.count << ":" << it.second.total / it.second.count
+                    << ":" << it.second.max;
+        }
+        else
+            return error(out, "bad request");
+        return true;
+    }
+
+    static bool error(std::ostringstream& out, const std::string& msg)
+    {
+        out << msg;
+        return false;
+    }
+
+    static const char* aliasName(AliasResult res)
+    {
+        switch (res)
+        {
+        case NoAlias:
+            return "NoAlias";
+        case MustAlias:
+            return "MustAlias";
+        case PartialAlias:
+            return "PartialAlias";
+        default:
+            return "MayAlias";
+        }
+    }
+
+    /// Forward reachability from src to dst along the edges of a graph
+    template <class GraphType>
+    static bool reach(GraphType* graph, NodeID src, NodeID dst)
+    {
+        FIFOWorkList<NodeID> worklist;
+        NodeBS visited;
+        worklist.push(src);
+        visited.set(src);
+        while (!worklist.empty())
+        {
+            NodeID id = worklist.pop();
+            if (id == dst)
+                return true;
+            for (const auto* edge : graph->getGNode(id)->getOutEdges())
+            {
+                if (!visited.test(edge->getDstID()))
+                {
+                    visited.set(edge->getDstID());
+                    worklist.push(edge->getDstID());
+                }
+            }
+        }
+        return false;
+    }
+
+    SVFIR* pag;
+    AndersenWaveDiff* ander;
+    SVFG* svfg;
+    std::mutex lock;
+    OrderedMap<std::string, Latency> latencies;
+};
+
+/// Write a whole response. A client that has gone away only closes its own
+/// connection: MSG_NOSIGNAL turns SIGPIPE into EPIPE.
+static bool sendAll(int fd, const std::string& data)
+{
+    std::string::size_type sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
+
+/// Answer the requests of one client, one line each
+static void serveClient(QueryServer& server, int fd)
+{
+    std::string buffer, response;
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+    {
+        buffer.append(chunk, n);
+        std::string::size_type pos;
+        while ((pos = buffer.find('\n')) != std::string::npos)
+        {
+            std::string request = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            if (!server.answer(request, response))
+            {
+                close(fd);
+                return;
+            }
+            if (!response.empty())
+            {
+                response += "\n";
+                if (!sendAll(fd, response))
+                {
+                    close(fd);
+                    return;
+                }
+                response.clear();
+            }
+        }
+    }
+    close(fd);
+}
+
+/// Accept clients of a Unix socket, each served by its own thread
+static int serveSocket(QueryServer& server, const std::string& path)
+{
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (listener == -1 || path.size() >= sizeof(addr.sun_path))
+    {
+        SVFUtil::errs() << "cannot create socket " << path << "\n";
+        return 1;
+    }
+    path.copy(addr.sun_path, path.size());
+    unlink(path.c_str());
+    if (bind(listener, (struct sockaddr*) &addr, sizeof(addr)) == -1 || listen(listener, SOMAXCONN) == -1)
+    {
+        SVFUtil::errs() << "cannot listen on socket " << path << "\n";
+        close(listener);
+        return 1;
+    }
+    SVFUtil::outs() << "listening on " << path << "\n";
+    while (true)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if (client != -1)
+        {
+            std::thread(serveClient, std::ref(server), client).detach();
+            continue;
+        }
+        switch (errno)
+        {
+        /// the connection or the call was interrupted, accept the next one
+        case EINTR:
+        case ECONNABORTED:
+        case EPROTO:
+            break;
+        /// out of descriptors or memory until clients leave, back off
+        case EMFILE:
+        case ENFILE:
+        case ENOBUFS:
+        case ENOMEM:
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            break;
+        default:
+            SVFUtil::errs() << "cannot accept clients on socket " << path << ": " << strerror(errno) << "\n";
+            close(listener);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    auto moduleNameVec =
+        OptionBase::parseOptions(argc, argv, "Pointer Analysis Query Server",
+                                 "[options] <input-bitcode...>");
+
+    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder(svfModule);
+    SVFIR* pag = builder.build();
+
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    SVFGBuilder svfBuilder;
+    SVFG* svfg = ServerSVFG() ? svfBuilder.buildFullSVFG(ander) : nullptr;
+
+    QueryServer server(pag, ander, svfg);
+    int ret = 0;
+    if (!ServerSocket().empty())
+        ret = serveSocket(server, ServerSocket());
+    else
+    {
+        std::string request, response;
+        while (std::getline(std::cin, request) && server.answer(request, response))
+        {
+            if (!response.empty())
+                std::cout << response << std::endl;
+            response.clear();
+        }
+    }
+
+    AndersenWaveDiff::releaseAndersenWaveDiff();
+    SVFIR::releaseSVFIR();
+    LLVMModuleSet::releaseLLVMModuleSet();
+    return ret;
+}
@@ -50,6 +50,7 @@
 #include "AE/Core/IntervalValue.h"
 #include "SVFIR/SVFVariables.h"
 #include "Util/Z3Expr.h"
+#include "Util/PersistentMap.h"
 
 #include <iomanip>
 
@@ -60,7 +61,9 @@ class AbstractState
     friend class SVFIR2AbsState;
     friend class RelationSolver;
 public:
-    typedef Map<u32_t, AbstractValue> VarToAbsValMap;
+    /// Copies share their entries and copy the updated ones only, so states
+    /// are copied in O(1) at every control-flow merge and call
+    typedef PersistentMap<AbstractValue> VarToAbsValMap;
 
     typedef VarToAbsValMap AddrToAbsValMap;
 
@@ -121,7 +124,7 @@ public:
 
     AbstractState&operator=(const AbstractState&rhs)
     {
-        if (rhs != *this)
+        if (&rhs != this)
         {
             _varToAbsVal = rhs._varToAbsVal;
             _addrToAbsVal = rhs._addrToAbsVal;
@@ -151,11 +154,11 @@ public:
     AbstractState bottom() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        inv._varToAbsVal.updateAll([](AbstractValue& val)
         {
-            if (item.second.isInterval())
-                item.second.getInterval().set_to_bottom();
-        }
+            if (val.isInterval())
+                val.getInterval().set_to_bottom();
+        });
         return inv;
     }
 
@@ -163,11 +166,11 @@ public:
     AbstractState top() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        inv._varToAbsVal.updateAll([](AbstractValue& val)
         {
-            if (item.second.isInterval())
-                item.second.getInterval().set_to_top();
-        }
+            if (val.isInterval())
+                val.getInterval().set_to_top();
+        });
         return inv;
     }
 
@@ -182,29 +185,99 @@ public:
         return inv;
     }
 
+    /// Entries of this state not shared with base, i.e., the ones updated or accessed
+    /// through the non-const operator[] since this state was copied from base
+    AbstractState updatedSince(const AbstractState& base) const;
+
+    /// Entries of this state whose keys are in the state keys, a missing entry is bottom
+    AbstractState projectTo(const AbstractState& keys) const;
+
+    /// Entries of this state whose keys satisfy pred
+    template <typename P>
+    AbstractState select(P pred) const
+    {
+        AbstractState res;
+        for (const auto& item : _varToAbsVal)
+        {
+            if (pred(item.first))
+                res._varToAbsVal[item.first] = item.second;
+        }
+        for (const auto& item : _addrToAbsVal)
+        {
+            if (pred(item.first))
+                res._addrToAbsVal[item.first] = item.second;
+        }
+        return res;
+    }
+
+    /// Overwrite the entries of this state by those of other
+    void updateWith(const AbstractState& other);
+
+    /// Whether every value of this state is subsumed by the one of other (a missing value is bottom)
+    bool containedWithin(const AbstractState& other) const;
+
+    /// Keys of the variables and addresses accessed in any state of this thread while recorded
+    struct ReadSet
+    {
+        NodeBS vars;
+        NodeBS addrs;
+    };
+
+    /// Record the accesses through operator[], load and the in*Table queries into reads,
+    /// including the read-only ones that updatedSince misses, e.g., when the callee of a
+    /// summary is analysed. Return the previous recorder, nullptr stops recording
+    static inline ReadSet* setReadRecorder(ReadSet* reads)
+    {
+        ReadSet* prev = _readRecorder;
+        _readRecorder = reads;
+        return prev;
+    }
+
+    static inline ReadSet* getReadRecorder()
+    {
+        return _readRecorder;
+    }
+
 protected:
     VarToAbsValMap _varToAbsVal; ///< Map a variable (symbol) to its abstract value
     AddrToAbsValMap
     _addrToAbsVal; ///< Map a memory address to its stored abstract value
 
+    static thread_local ReadSet* _readRecorder;
+
+    inline static void recordVar(u32_t id)
+    {
+        if (_readRecorder)
+            _readRecorder->vars.set(id);
+    }
+
+    inline static void recordAddr(u32_t id)
+    {
+        if (_readRecorder)
+            _readRecorder->addrs.set(id);
+    }
+
 public:
 
 
     /// get abstract value of variable
     inline virtual AbstractValue &operator[](u32_t varId)
     {
+        recordVar(varId);
         return _varToAbsVal[varId];
     }
 
     /// get abstract value of variable
     inline virtual const AbstractValue &operator[](u32_t varId) const
     {
+        recordVar(varId);
         return _varToAbsVal.at(varId);
     }
 
     /// whether the variable is in varToAddrs table
     inline bool inVarToAddrsTable(u32_t id) const
     {
+        recordVar(id);
         if (_varToAbsVal.find(id)!= _varToAbsVal.end())
         {
             if (_varToAbsVal.at(id).isAddr())
@@ -218,6 +291,7 @@ public:
     /// whether the variable is in varToVal table
     inline virtual bool inVarToValTable(u32_t id) const
     {
+        recordVar(id);
         if (_varToAbsVal.find(id) != _varToAbsVal.end())
         {
             if (_varToAbsVal.at(id).isInterval())
@@ -231,6 +305,7 @@ public:
     /// whether the memory address stores memory addresses
     inline bool inAddrToAddrsTable(u32_t id) const
     {
+        recordAddr(id);
         if (_addrToAbsVal.find(id)!= _addrToAbsVal.end())
         {
             if (_addrToAbsVal.at(id).isAddr())
@@ -244,6 +319,7 @@ public:
     /// whether the memory address stores abstract value
     inline virtual bool inAddrToValTable(u32_t id) const
     {
+        recordAddr(id);
         if (_addrToAbsVal.find(id) != _addrToAbsVal.end())
         {
             if (_addrToAbsVal.at(id).isInterval())
@@ -268,11 +344,13 @@ public:
 
 public:
 
-    /// domain widen with other, and return the widened domain
-    AbstractState widening(const AbstractState&other);
+    /// domain widen with other, and return the widened domain,
+    /// growing bounds stop at the nearest of the thresholds (sorted) first
+    AbstractState widening(const AbstractState&other, const std::vector<s64_t>& thresholds = {});
 
-    /// domain narrow with other, and return the narrowed domain
-    AbstractState narrowing(const AbstractState&other);
+    /// domain narrow with other, and return the narrowed domain,
+    /// bounds at the thresholds are narrowed like infinite ones
+    AbstractState narrowing(const AbstractState&other, const std::vector<s64_t>& thresholds = {});
 
     /// domain join with other, important! other widen this.
     void joinWith(const AbstractState&other);
@@ -305,6 +383,7 @@ public:
     {
         assert(isVirtualMemAddress(addr) && "not virtual address?");
         u32_t objId = getInternalID(addr);
+        recordAddr(objId);
         return _addrToAbsVal[objId];
 
     }
@@ -322,19 +401,10 @@ public:
 
     static bool eqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
-        if (lhs.size() != rhs.size()) return false;
-        for (const auto &item: lhs)
+        return lhs.equals(rhs, [](const AbstractValue& l, const AbstractValue& r)
         {
-            auto it = rhs.find(item.first);
-            if (it == rhs.end())
-                return false;
-            if (!item.second.equals(it->second))
-                return false;
-            else
-            {
-            }
-        }
-        return true;
+            return l.equals(r);
+        });
     }
 
     static bool lessThanVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
@@ -353,7 +423,7 @@ public:
     // lhs >= rhs
     static bool geqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
-        if (rhs.empty()) return true;
+        if (rhs.empty() || lhs.sharesRoot(rhs)) return true;
         for (const auto &item: rhs)
         {
             auto it = lhs.find(item.first);
@@ -125,6 +125,19 @@ public:
         return interval.equals(rhs.interval) && addrs.equals(rhs.addrs);
     }
 
+    /// Whether this value is subsumed by rhs
+    bool containedWithin(const AbstractValue &rhs) const
+    {
+        if (!interval.containedWithin(rhs.interval))
+            return false;
+        for (u32_t addr : addrs)
+        {
+            if (!rhs.addrs.contains(addr))
+                return false;
+        }
+        return true;
+    }
+
     void join_with(const AbstractValue &other)
     {
         interval.join_with(other.interval);
@@ -149,6 +162,19 @@ public:
         // TODO: narrow Addrs
     }
 
+    /// Widen and narrow the interval with thresholds
+    //@{
+    void widen_with(const AbstractValue &other, const std::vector<s64_t> &thresholds)
+    {
+        interval.widen_with(other.interval, thresholds);
+    }
+
+    void narrow_with(const AbstractValue &other, const std::vector<s64_t> &thresholds)
+    {
+        interval.narrow_with(other.interval, thresholds);
+    }
+    //@}
+
     std::string toString() const
     {
         return "<" + interval.toString() + ", " + addrs.toString() + ">";
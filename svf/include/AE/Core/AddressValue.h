@@ -36,24 +36,51 @@
 #define BlackHoleAddr 0x7f000000 + 2
 
 #include "Util/GeneralType.h"
+#include <memory>
 #include <sstream>
 
 namespace SVF
 {
+/*!
+ * A set of addresses, kept in a bitvector that copies share until one of them is updated.
+ * Copies are O(1), and a join or comparison of copies of the same set is O(1). Other
+ * operations work on the words of the bitvectors, not by hashing each address.
+ */
 class AddressValue
 {
 public:
-    typedef Set<u32_t> AddrSet;
+    typedef NodeBS AddrSet;
 private:
-    AddrSet _addrs;
+    /// nullptr is the empty set, a shared set is copied before it is updated
+    std::shared_ptr<AddrSet> _addrs;
+
+    static inline const AddrSet& emptySet()
+    {
+        static const AddrSet empty;
+        return empty;
+    }
+
+    /// The set to update, owned by this value only
+    inline AddrSet& mutableAddrs()
+    {
+        if (!_addrs)
+            _addrs = std::make_shared<AddrSet>();
+        else if (_addrs.use_count() > 1)
+            _addrs = std::make_shared<AddrSet>(*_addrs);
+        return *_addrs;
+    }
+
 public:
     /// Default constructor
     AddressValue() {}
 
     /// Constructor
-    AddressValue(const Set<u32_t> &addrs) :  _addrs(addrs) {}
+    AddressValue(const AddrSet &addrs) : _addrs(addrs.empty() ? nullptr : std::make_shared<AddrSet>(addrs)) {}
 
-    AddressValue(u32_t addr) :  _addrs({addr}) {}
+    AddressValue(u32_t addr) : _addrs(std::make_shared<AddrSet>())
+    {
+        _addrs->set(addr);
+    }
 
     /// Default destructor
     ~AddressValue() = default;
@@ -67,10 +94,7 @@ public:
     /// Copy operator=
     AddressValue &operator=(const AddressValue &other)
     {
-        if (!this->equals(other))
-        {
-            _addrs = other._addrs;
-        }
+        _addrs = other._addrs;
         return *this;
     }
 
@@ -86,91 +110,97 @@ public:
 
     bool equals(const AddressValue &rhs) const
     {
-        return _addrs == rhs._addrs;
+        return _addrs == rhs._addrs || getVals() == rhs.getVals();
     }
 
-    AddrSet::const_iterator begin() const
+    AddrSet::iterator begin() const
     {
-        return _addrs.cbegin();
+        return getVals().begin();
     }
 
-    AddrSet::const_iterator end() const
+    AddrSet::iterator end() const
     {
-        return _addrs.cend();
+        return getVals().end();
     }
 
     bool empty() const
     {
-        return _addrs.empty();
+        return !_addrs || _addrs->empty();
     }
 
     u32_t size() const
     {
-        return _addrs.size();
+        return _addrs ? _addrs->count() : 0;
     }
 
-    std::pair<AddressValue::AddrSet::iterator, bool> insert(u32_t id)
+    /// Add an address, return whether it is new
+    bool insert(u32_t id)
     {
-        return _addrs.insert(id);
+        if (contains(id))
+            return false;
+        mutableAddrs().set(id);
+        return true;
     }
 
     const AddrSet &getVals() const
     {
-        return _addrs;
+        return _addrs ? *_addrs : emptySet();
     }
 
     void setVals(const AddrSet &vals)
     {
-        _addrs = vals;
+        *this = AddressValue(vals);
     }
 
     /// Current AddressValue joins with another AddressValue
     bool join_with(const AddressValue &other)
     {
-        bool changed = false;
-        for (const auto &addr: other)
+        if (_addrs == other._addrs || other.empty())
+            return false;
+        if (empty())
         {
-            if (!_addrs.count(addr))
-            {
-                if (insert(addr).second)
-                    changed = true;
-            }
+            _addrs = other._addrs;
+            return true;
         }
-        return changed;
+        if (_addrs->contains(*other._addrs))
+            return false;
+        mutableAddrs() |= *other._addrs;
+        return true;
     }
 
     /// Return a intersected AddressValue
     bool meet_with(const AddressValue &other)
     {
-        AddrSet s;
-        for (const auto &id: other._addrs)
+        if (_addrs == other._addrs || empty())
+            return false;
+        if (other.empty() || !_addrs->intersects(*other._addrs))
         {
-            if (_addrs.find(id) != _addrs.end())
-            {
-                s.insert(id);
-            }
+            _addrs = nullptr;
+            return true;
         }
-        bool changed = (_addrs != s);
-        _addrs = std::move(s);
-        return changed;
+        if (other._addrs->contains(*_addrs))
+            return false;
+        mutableAddrs() &= *other._addrs;
+        return true;
     }
 
-    /// Return true if the AddressValue contains n
+    /// Return true if the AddressValue contains n. Sets are shared by the states of
+    /// parallel workers, so this does not use NodeBS::test, which moves a cached cursor.
     bool contains(u32_t id) const
     {
-        return _addrs.count(id);
+        return _addrs && _addrs->test_uncached(id);
     }
 
     bool hasIntersect(const AddressValue &other)
     {
-        AddressValue v = *this;
-        v.meet_with(other);
-        return !v.empty();
+        return !empty() && !other.empty() && _addrs->intersects(*other._addrs);
     }
 
+    /// A set holding the black hole address is top, whether or not smaller
+    /// addresses (e.g., of the constant object) sort before it.
     inline bool isTop() const
     {
-        return *this->begin() == BlackHoleAddr;
+        return contains(BlackHoleAddr);
     }
 
     inline bool isBottom() const
@@ -185,7 +215,7 @@ public:
 
     inline void setBottom()
     {
-        _addrs.clear();
+        _addrs = nullptr;
     }
 
     const std::string toString() const
@@ -199,7 +229,7 @@ public:
         else
         {
             rawStr << "[";
-            for (auto it = _addrs.begin(), eit = _addrs.end(); it!= eit; ++it)
+            for (auto it = begin(), eit = end(); it!= eit; ++it)
             {
                 rawStr << *it << ", ";
             }
@@ -0,0 +1,156 @@
+//===- DenseAbstractState.h ----Dense Abstract States-------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * DenseAbstractState.h
+ *
+ * Abstract states of one function over a local numbering (slots) of its variables
+ * and memory objects. Intervals and address sets are kept in separate arrays indexed
+ * by slots, so a lookup is O(1) and containment is a linear scan over the arrays.
+ * A slot beyond the arrays or not defined in a state reads as bottom.
+ *
+ * These states are only the keys (inputs) of callee summaries, which are compared
+ * but never joined or widened. The analysis itself works on AbstractState.
+ */
+
+#ifndef INCLUDE_AE_CORE_DENSEABSTRACTSTATE_H_
+#define INCLUDE_AE_CORE_DENSEABSTRACTSTATE_H_
+
+#include "AE/Core/AbstractState.h"
+
+namespace SVF
+{
+
+/*!
+ * Slots of the top-level variables and memory objects of dense states
+ */
+class DenseStateIndex
+{
+public:
+    /// Slot of a variable (addr is false) or of a memory object, added if missing
+    u32_t addSlot(u32_t id, bool addr);
+
+    /// Slot of a variable or of a memory object, -1 if it has none
+    inline s32_t getSlot(u32_t id, bool addr) const
+    {
+        const Map<u32_t, u32_t>& slots = addr ? _addrToSlot : _varToSlot;
+        auto it = slots.find(id);
+        return it == slots.end() ? -1 : (s32_t) it->second;
+    }
+
+    inline u32_t size() const
+    {
+        return _slotToID.size();
+    }
+
+    inline u32_t getID(u32_t slot) const
+    {
+        return _slotToID[slot].first;
+    }
+
+    inline bool isAddr(u32_t slot) const
+    {
+        return _slotToID[slot].second;
+    }
+
+private:
+    Map<u32_t, u32_t> _varToSlot;
+    Map<u32_t, u32_t> _addrToSlot;
+    std::vector<std::pair<u32_t, bool>> _slotToID;
+};
+
+class DenseAbstractState
+{
+public:
+    DenseAbstractState() = default;
+
+    /// The values of as at all slots of index, a value missing in as is bottom
+    DenseAbstractState(const DenseStateIndex& index, const AbstractState& as);
+
+    /// The entries of as only, their slots are added to index
+    static DenseAbstractState fromEntries(DenseStateIndex& index, const AbstractState& as);
+
+    /// The defined slots as an AbstractState
+    AbstractState toAbstractState(const DenseStateIndex& index) const;
+
+    inline u32_t size() const
+    {
+        return _intervals.size();
+    }
+
+    inline bool isDefined(u32_t slot) const
+    {
+        return slot < size() && _defined[slot];
+    }
+
+    inline const IntervalValue& getInterval(u32_t slot) const
+    {
+        return slot < size() ? _intervals[slot] : bottomInterval();
+    }
+
+    /// Addresses at slot
+    inline const NodeBS& getAddrs(u32_t slot) const
+    {
+        return slot < size() ? _addrs[slot] : emptyAddrs();
+    }
+
+    AbstractValue getValue(u32_t slot) const;
+
+    void setValue(u32_t slot, const AbstractValue& val);
+
+    /// Whether every value of this state is subsumed by the one of other
+    bool containedWithin(const DenseAbstractState& other) const;
+
+    /// Whether the values of this state at the slots defined in other are subsumed by other,
+    /// i.e., AbstractState::projectTo followed by AbstractState::containedWithin
+    bool containedWithinAt(const DenseAbstractState& other) const;
+
+    bool equals(const DenseAbstractState& other) const;
+
+private:
+    void resize(u32_t n);
+
+    static inline const IntervalValue& bottomInterval()
+    {
+        static const IntervalValue bottom = IntervalValue::bottom();
+        return bottom;
+    }
+
+    static inline const NodeBS& emptyAddrs()
+    {
+        static const NodeBS empty;
+        return empty;
+    }
+
+    inline bool containedAt(u32_t slot, const DenseAbstractState& other) const
+    {
+        return getInterval(slot).containedWithin(other.getInterval(slot)) &&
+               other.getAddrs(slot).contains(getAddrs(slot));
+    }
+
+    std::vector<IntervalValue> _intervals;
+    std::vector<NodeBS> _addrs;
+    std::vector<bool> _defined;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_AE_CORE_DENSEABSTRACTSTATE_H_ */
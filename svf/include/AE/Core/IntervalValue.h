@@ -33,6 +33,7 @@
 #ifndef Z3_EXAMPLE_IntervalValue_H
 #define Z3_EXAMPLE_IntervalValue_H
 
+#include <algorithm>
 #include <sstream>
 #include "AE/Core/NumericValue.h"
 
@@ -471,6 +472,59 @@ public:
         }
     }
 
+    /// Widen with another IntervalValue, a growing bound moves to the nearest of the
+    /// thresholds (sorted) beyond the bound of other before going to infinity
+    void widen_with(const IntervalValue &other, const std::vector<s64_t> &thresholds)
+    {
+        if (this->isBottom() || other.isBottom())
+        {
+            widen_with(other);
+            return;
+        }
+        BoundedInt lb = this->lb();
+        BoundedInt ub = this->ub();
+        if (!lb.leq(other.lb()))
+        {
+            lb = minus_infinity();
+            for (auto it = thresholds.rbegin(); it != thresholds.rend(); ++it)
+            {
+                if (BoundedInt(*it).leq(other.lb()))
+                {
+                    lb = BoundedInt(*it);
+                    break;
+                }
+            }
+        }
+        if (!ub.geq(other.ub()))
+        {
+            ub = plus_infinity();
+            for (s64_t t : thresholds)
+            {
+                if (BoundedInt(t).geq(other.ub()))
+                {
+                    ub = BoundedInt(t);
+                    break;
+                }
+            }
+        }
+        setValue(lb, ub);
+    }
+
+    /// Narrow with another IntervalValue, bounds at thresholds are refined like infinite ones
+    void narrow_with(const IntervalValue &other, const std::vector<s64_t> &thresholds)
+    {
+        if (this->isBottom() || other.isBottom())
+        {
+            this->set_to_bottom();
+            return;
+        }
+        auto refinable = [&](const BoundedInt& b)
+        {
+            return is_infinite(b) || std::binary_search(thresholds.begin(), thresholds.end(), b.getIntNumeral());
+        };
+        setValue(refinable(this->lb()) ? other._lb : this->_lb, refinable(this->ub()) ? other._ub : this->_ub);
+    }
+
     /// Return a intersected IntervalValue
     void meet_with(const IntervalValue &other)
     {
@@ -497,6 +551,16 @@ public:
         return this->_lb.leq(n) && this->_ub.geq(n);
     }
 
+    /// Apply a binary operator to arrays of n intervals, res[i] = op(lhs[i], rhs[i]), e.g.,
+    /// batch(lhs, rhs, res, n, std::plus<IntervalValue>()) over the interval arrays of dense
+    /// states. res may be lhs or rhs, or an array of another type, e.g., the flags of a comparison
+    template <typename Res, typename BinaryOp>
+    static void batch(const IntervalValue* lhs, const IntervalValue* rhs, Res* res, u32_t n, BinaryOp op)
+    {
+        for (u32_t i = 0; i < n; ++i)
+            res[i] = op(lhs[i], rhs[i]);
+    }
+
     void dump(std::ostream &o) const
     {
         if (this->isBottom())
@@ -547,7 +611,12 @@ private:
 inline IntervalValue operator+(const IntervalValue &lhs,
                                const IntervalValue &rhs)
 {
-    if (lhs.isBottom() || rhs.isBottom())
+    // Finite bounds (the common case) are neither bottom nor top
+    if (!lhs.is_infinite() && !rhs.is_infinite())
+    {
+        return IntervalValue(lhs._lb + rhs._lb, lhs._ub + rhs._ub);
+    }
+    else if (lhs.isBottom() || rhs.isBottom())
     {
         return IntervalValue::bottom();
     }
@@ -565,7 +634,12 @@ inline IntervalValue operator+(const IntervalValue &lhs,
 inline IntervalValue operator-(const IntervalValue &lhs,
                                const IntervalValue &rhs)
 {
-    if (lhs.isBottom() || rhs.isBottom())
+    // Finite bounds (the common case) are neither bottom nor top
+    if (!lhs.is_infinite() && !rhs.is_infinite())
+    {
+        return IntervalValue(lhs._lb - rhs._ub, lhs._ub - rhs._lb);
+    }
+    else if (lhs.isBottom() || rhs.isBottom())
     {
         return IntervalValue::bottom();
     }
@@ -593,9 +667,8 @@ inline IntervalValue operator*(const IntervalValue &lhs,
         BoundedInt lu = lhs.lb() * rhs.ub();
         BoundedInt ul = lhs.ub() * rhs.lb();
         BoundedInt uu = lhs.ub() * rhs.ub();
-        std::vector<BoundedInt> vec{ll, lu, ul, uu};
-        return IntervalValue(BoundedInt::min(vec),
-                             BoundedInt::max(vec));
+        return IntervalValue(BoundedInt::min(ll, lu, ul, uu),
+                             BoundedInt::max(ll, lu, ul, uu));
     }
 }
 
@@ -633,11 +706,8 @@ inline IntervalValue operator/(const IntervalValue &lhs,
         BoundedInt lu = lhs.lb() / rhs.ub();
         BoundedInt ul = lhs.ub() / rhs.lb();
         BoundedInt uu = lhs.ub() / rhs.ub();
-        std::vector<BoundedInt> vec{ll, lu, ul, uu};
-
-        IntervalValue res =  IntervalValue(BoundedInt::min(vec),
-                                           BoundedInt::max(vec));
-        return res;
+        return IntervalValue(BoundedInt::min(ll, lu, ul, uu),
+                             BoundedInt::max(ll, lu, ul, uu));
     }
 }
 
@@ -951,9 +1021,8 @@ inline IntervalValue operator>>(const IntervalValue &lhs, const IntervalValue &r
             BoundedInt lu = lhs.lb() >> shift.ub();
             BoundedInt ul = lhs.ub() >> shift.lb();
             BoundedInt uu = lhs.ub() >> shift.ub();
-            std::vector<BoundedInt> vec{ll, lu, ul, uu};
-            return IntervalValue(BoundedInt::min(vec),
-                                 BoundedInt::max(vec));
+            return IntervalValue(BoundedInt::min(ll, lu, ul, uu),
+                                 BoundedInt::max(ll, lu, ul, uu));
         }
     }
 }
@@ -115,6 +115,12 @@ public:
         return is_plus_infinity() || is_minus_infinity();
     }
 
+    // Checks if the BoundedInt is a finite value, by its infinity flag only.
+    bool is_finite() const
+    {
+        return !_isInf;
+    }
+
     // Sets the BoundedInt to represent positive infinity.
     void set_plus_infinity()
     {
@@ -279,6 +285,12 @@ public:
      */
     static BoundedInt safeAdd(const BoundedInt& lhs, const BoundedInt& rhs)
     {
+        // If both numbers are finite (the common case), add them directly.
+        if (lhs.is_finite() && rhs.is_finite())
+        {
+            return finiteAdd(lhs._iVal, rhs._iVal);
+        }
+
         // If one number is positive infinity and the other is negative
         // infinity, this is an invalid operation, so we assert false.
         if ((lhs.is_plus_infinity() && rhs.is_minus_infinity()) ||
@@ -294,32 +306,26 @@ public:
             return plus_infinity();
         }
 
-        // If either number is negative infinity, the result is negative
-        // infinity.
-        if (lhs.is_minus_infinity() || rhs.is_minus_infinity())
-        {
-            return minus_infinity();
-        }
-
-        // If both numbers are positive and their sum would exceed the maximum
-        // representable number, the result is positive infinity.
-        if (lhs._iVal > 0 && rhs._iVal > 0 &&
-                (std::numeric_limits<s64_t>::max() - lhs._iVal) < rhs._iVal)
-        {
-            return plus_infinity();
-        }
+        // Otherwise, one number is negative infinity and so is the result.
+        return minus_infinity();
+    }
 
-        // If both numbers are negative and their sum would be less than the
-        // most negative representable number, the result is negative infinity.
-        if (lhs._iVal < 0 && rhs._iVal < 0 &&
-                (-std::numeric_limits<s64_t>::max() - lhs._iVal) > rhs._iVal)
-        {
+    /**
+     * Adds two finite values without branching on infinity flags.
+     *
+     * The overflow is checked by the compiler builtin. As in safeAdd, a sum
+     * greater than the maximum representable number is positive infinity, and
+     * a sum less than the negation of the maximum (including the minimum
+     * 64-bit integer) is negative infinity.
+     */
+    static inline BoundedInt finiteAdd(s64_t lhs, s64_t rhs)
+    {
+        s64_t res;
+        if (__builtin_add_overflow(lhs, rhs, &res))
+            return lhs > 0 ? plus_infinity() : minus_infinity();
+        if (res == std::numeric_limits<s64_t>::min() && lhs < 0 && rhs < 0)
             return minus_infinity();
-        }
-
-        // If none of the above conditions are met, the numbers can be safely
-        // added.
-        return lhs._iVal + rhs._iVal;
+        return res;
     }
 
     // Overloads the addition operator to safely add two BoundedInt objects.
@@ -363,57 +369,46 @@ public:
      */
     static BoundedInt safeMul(const BoundedInt& lhs, const BoundedInt& rhs)
     {
-        // If either number is zero, the result is zero.
-        if (lhs._iVal == 0 || rhs._iVal == 0)
-            return 0;
-
-        // If either number is infinity, the result depends on the signs of the
-        // numbers.
-        if (lhs.is_infinity() || rhs.is_infinity())
+        // If both numbers are finite (the common case), multiply them directly.
+        if (lhs.is_finite() && rhs.is_finite())
         {
-            // If the signs of the numbers are the same, the result is positive
-            // infinity. If the signs of the numbers are different, the result
-            // is negative infinity.
-            if (lhs._iVal * rhs._iVal > 0)
-            {
-                return plus_infinity();
-            }
-            else
-            {
-                return minus_infinity();
-            }
+            return finiteMul(lhs._iVal, rhs._iVal);
         }
 
-        // If both numbers are positive and their product would exceed the
-        // maximum representable number, the result is positive infinity.
-        if (lhs._iVal > 0 && rhs._iVal > 0 &&
-                (std::numeric_limits<s64_t>::max() / lhs._iVal) < rhs._iVal)
-        {
-            return plus_infinity();
-        }
+        // If either number is zero, the result is zero.
+        if (lhs._iVal == 0 || rhs._iVal == 0)
+            return 0;
 
-        // If both numbers are negative and their product would exceed the
-        // maximum representable number, the result is positive infinity.
-        if (lhs._iVal < 0 && rhs._iVal < 0 &&
-                (std::numeric_limits<s64_t>::max() / lhs._iVal) > rhs._iVal)
+        // Otherwise, either number is infinity and the result depends on the
+        // signs of the numbers. If the signs of the numbers are the same, the
+        // result is positive infinity. If the signs of the numbers are
+        // different, the result is negative infinity.
+        if ((lhs._iVal > 0) == (rhs._iVal > 0))
         {
             return plus_infinity();
         }
-
-        // If one number is positive and the other is negative and their product
-        // would be less than the most negative representable number, the result
-        // is negative infinity.
-        if ((lhs._iVal > 0 && rhs._iVal < 0 &&
-                (-std::numeric_limits<s64_t>::max() / lhs._iVal) > rhs._iVal) ||
-                (lhs._iVal < 0 && rhs._iVal > 0 &&
-                 (-std::numeric_limits<s64_t>::max() / rhs._iVal) > lhs._iVal))
+        else
         {
             return minus_infinity();
         }
+    }
 
-        // If none of the above conditions are met, the numbers can be safely
-        // multiplied.
-        return lhs._iVal * rhs._iVal;
+    /**
+     * Multiplies two finite values without branching on infinity flags.
+     *
+     * The overflow is checked by the compiler builtin. As in safeMul, a
+     * product greater than the maximum representable number is positive
+     * infinity, and a product less than the negation of the maximum
+     * (including the minimum 64-bit integer) is negative infinity.
+     */
+    static inline BoundedInt finiteMul(s64_t lhs, s64_t rhs)
+    {
+        s64_t res;
+        if (__builtin_mul_overflow(lhs, rhs, &res))
+            return (lhs > 0) == (rhs > 0) ? plus_infinity() : minus_infinity();
+        if (res == std::numeric_limits<s64_t>::min())
+            return minus_infinity();
+        return res;
     }
 
 
@@ -631,6 +626,33 @@ public:
         return ret;
     }
 
+    // Defines functions to find the minimum and the maximum of four BoundedInt
+    // objects, e.g., of the products of the bounds of two intervals, as the
+    // vector versions do but without allocating a vector.
+    static BoundedInt min(const BoundedInt& a, const BoundedInt& b,
+                          const BoundedInt& c, const BoundedInt& d)
+    {
+        const BoundedInt* ret = &a;
+        for (const BoundedInt* it : {&b, &c, &d})
+        {
+            if (!it->geq(*ret))
+                ret = it;
+        }
+        return *ret;
+    }
+
+    static BoundedInt max(const BoundedInt& a, const BoundedInt& b,
+                          const BoundedInt& c, const BoundedInt& d)
+    {
+        const BoundedInt* ret = &a;
+        for (const BoundedInt* it : {&b, &c, &d})
+        {
+            if (!it->leq(*ret))
+                ret = it;
+        }
+        return *ret;
+    }
+
     // Defines a function to find the absolute value of a BoundedInt object.
     // This function directly applies the unary minus operator if the BoundedInt
     // object is negative.
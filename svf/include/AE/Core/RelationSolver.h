@@ -35,6 +35,76 @@
 
 namespace SVF
 {
+
+/*!
+ * Z3 state shared by the queries of a RelationSolver: an incremental solver keeping the
+ * formula phi of the current query asserted at its base level (each check only pushes
+ * and pops its own condition), the integer constants of the variables, and the results
+ * of the queries already answered.
+ */
+class RelationSolverSession
+{
+public:
+    enum QueryKind
+    {
+        RSYQuery,
+        BilateralQuery,
+        BSQuery
+    };
+
+    RelationSolverSession();
+
+    /// Integer constant of a variable, named by its ID
+    const Z3Expr& getIntConst(u32_t id);
+
+    /// Assert phi at the base level of the solver, replacing the formula asserted before
+    void setFormula(const Z3Expr& phi);
+
+    /// Check the formula together with cond. If sat, the values of vars in the model are
+    /// written to values, 0 for the variables the formula does not constrain
+    z3::check_result check(const Z3Expr& cond, const std::vector<u32_t>& vars, Map<u32_t, s32_t>& values);
+
+    /// Reason of the last unknown result, e.g., "timeout"
+    inline std::string getReasonUnknown() const
+    {
+        return _solver.reason_unknown();
+    }
+
+    /// Maximise and minimise all variables of domain in one boxed optimisation over phi.
+    /// A bound beyond +/-infinity or violated by a model of phi (z3 optimises non-linear
+    /// terms incompletely) is infinite in res. Return false if the optimisation or the
+    /// check of the bounds fails (unsat, unknown or timeout)
+    bool optimize(const Z3Expr& phi, const AbstractState& domain, s32_t infinity, AbstractState& res);
+
+    /// Result of an earlier query on domain and phi, nullptr if it was not answered yet
+    const AbstractState* lookup(QueryKind kind, u32_t param, const AbstractState& domain, const Z3Expr& phi) const;
+
+    /// Record the result of a query and return it
+    const AbstractState& record(QueryKind kind, u32_t param, const AbstractState& domain, const Z3Expr& phi,
+                                const AbstractState& result);
+
+    /// Timeout of a check or an optimisation
+    static const u32_t timeout = 600; // in milliseconds
+
+private:
+    struct Query
+    {
+        QueryKind kind;
+        u32_t param;
+        Z3Expr phi;
+        AbstractState domain;
+        AbstractState result;
+    };
+
+    static u32_t getQueryHash(QueryKind kind, u32_t param, const AbstractState& domain, const Z3Expr& phi);
+
+    z3::solver _solver;
+    Z3Expr _formula; ///< phi asserted at the base level of _solver
+    bool _hasFormula;
+    Map<u32_t, Z3Expr> _idToConst;
+    Map<u32_t, std::vector<Query>> _hashToQueries;
+};
+
 class RelationSolver
 {
 public:
@@ -60,7 +130,7 @@ public:
     /// Return Z3 expression lazily based on SVFVar ID
     virtual inline Z3Expr toIntZ3Expr(u32_t varId) const
     {
-        return Z3Expr::getContext().int_const(std::to_string(varId).c_str());
+        return _session.getIntConst(varId);
     }
 
     inline Z3Expr toIntVal(s32_t f) const
@@ -85,6 +155,12 @@ public:
     void updateMap(Map<u32_t, s32_t>& map, u32_t key, const s32_t& value);
 
     void decide_cpa_ext(const Z3Expr &phi, Map<u32_t, Z3Expr>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&);
+
+private:
+    /// IDs of the variables of domain
+    static std::vector<u32_t> getVars(const AbstractState& domain);
+
+    mutable RelationSolverSession _session;
 };
 }
 
@@ -0,0 +1,112 @@
+//===- AEIncrementalCache.h -- Function summaries across AE runs-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AEIncrementalCache.h
+ *
+ * Function summaries of abstract execution saved in a file and reused by the next run
+ * (-ae-incremental). The summaries of a function are keyed by a hash of its body and
+ * of the bodies of all functions it may call, so a change of a function invalidates the
+ * summaries of its transitive callers. Variables and objects in the saved states are
+ * identified by keys independent of the node IDs of a run: globals by their names,
+ * arguments and instructions by their positions in a function together with the hash of
+ * its body, so an entry of a changed function is not resolved on loading.
+ */
+
+#ifndef INCLUDE_AE_SVFEXE_AEINCREMENTALCACHE_H_
+#define INCLUDE_AE_SVFEXE_AEINCREMENTALCACHE_H_
+
+#include "AE/Core/AbstractState.h"
+#include "MemoryModel/PointerAnalysis.h"
+
+namespace SVF
+{
+
+class AEIncrementalCache
+{
+public:
+    /// A summary of a function, its input and output states
+    typedef std::pair<AbstractState, AbstractState> Summary;
+    typedef Map<const SVFFunction*, std::vector<Summary>> FunToSummaries;
+    /// Pairs of variables kept by checkers, e.g., the objects of the buffer overflow checker
+    /// with the variables of the gep statements creating them
+    typedef std::vector<std::pair<NodeID, NodeID>> VarPairs;
+
+    AEIncrementalCache(SVFIR* svfir);
+
+    /// Load the summaries of the functions unchanged since the file was saved and the
+    /// pairs whose variables are resolved, return false if the file is missing or was
+    /// saved with other options
+    bool load(const std::string& path, FunToSummaries& summaries, VarPairs& varPairs);
+
+    /// Save the summaries of the functions reaching none of dirtyFuns (e.g., the functions
+    /// where bugs were found, which would not be reported if their callers are skipped)
+    bool save(const std::string& path, const FunToSummaries& summaries,
+              const Set<const SVFFunction*>& dirtyFuns, const VarPairs& varPairs);
+
+private:
+    /// Hash of the instructions of a function
+    u64_t getBodyHash(const SVFFunction* fun);
+    /// Hash of the bodies of the functions of an SCC of the call graph and of its callees
+    u64_t getSCCKey(NodeID rep);
+    inline u64_t getFunKey(const SVFFunction* fun)
+    {
+        return getSCCKey(_callGraphSCC->repNode(_callGraph->getCallGraphNode(fun)->getId()));
+    }
+    /// Whether a function of an SCC or of its callees is dirty
+    bool reachesDirty(NodeID rep, const Set<const SVFFunction*>& dirtyFuns);
+
+    /// Keys of values and variables, 0 if a variable has no key
+    //@{
+    u64_t getValueKey(const SVFValue* value);
+    u64_t getVarKey(NodeID id);
+    void initKeyToVar();
+    //@}
+
+    /// Entries are written as "key" or as "key+offset" for field objects, a read entry
+    /// not resolved in this run clears resolved, reading fails on a malformed file only
+    //@{
+    class TokenReader;
+    bool writeVar(std::string& out, NodeID id);
+    bool readVar(TokenReader& reader, NodeID& id, bool& resolved);
+    bool writeState(std::string& out, const AbstractState& as);
+    bool readState(TokenReader& reader, AbstractState& as, bool& resolved);
+    //@}
+
+    /// Options changing the results, a saved file is used with the same options only
+    static std::string getOptionString();
+
+    SVFIR* _svfir;
+    CallGraph* _callGraph;
+    PointerAnalysis::CallGraphSCC* _callGraphSCC;
+    Map<const SVFFunction*, u64_t> _funToBodyHash;
+    Map<const SVFValue*, u32_t> _instToPos;
+    Map<NodeID, u64_t> _sccToKey;
+    Map<NodeID, bool> _sccToDirty;
+    Map<NodeID, u64_t> _varToKey;
+    Map<u64_t, NodeID> _keyToVar;
+    Set<u64_t> _ambiguousKeys;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_AE_SVFEXE_AEINCREMENTALCACHE_H_ */
@@ -32,6 +32,8 @@
 #include "Util/SVFBugReport.h"
 #include "WPA/Andersen.h"
 #include "AE/Core/AbstractState.h"
+#include "AE/Core/DenseAbstractState.h"
+#include "AE/Svfexe/AEIncrementalCache.h"
 
 namespace SVF
 {
@@ -101,6 +103,33 @@ public:
         }
         return generalNumMap["ICFG_Node_Trace"];
     }
+    u32_t& getSummaryNum()
+    {
+        if (generalNumMap.count("Summary_Num") == 0)
+        {
+            generalNumMap["Summary_Num"] = 0;
+        }
+        return generalNumMap["Summary_Num"];
+    }
+    u32_t& getSummaryReuse()
+    {
+        if (generalNumMap.count("Summary_Reuse") == 0)
+        {
+            generalNumMap["Summary_Reuse"] = 0;
+        }
+        return generalNumMap["Summary_Reuse"];
+    }
+    u32_t& getCachedSummaryNum()
+    {
+        if (generalNumMap.count("Cached_Summary_Num") == 0)
+        {
+            generalNumMap["Cached_Summary_Num"] = 0;
+        }
+        return generalNumMap["Cached_Summary_Num"];
+    }
+
+    /// Iterations of each cycle, summed over the times it is analysed
+    Map<const ICFGNode*, u32_t> cycleIterNum;
 };
 
 /// AbstractInterpretation is same as Abstract Execution
@@ -140,6 +169,23 @@ protected:
     /// Mark recursive functions in the call graph
     void initWTO();
 
+    /// An analysis of the same kind with its own traces, analysing one entry function
+    virtual AbstractInterpretation* createWorker() const;
+
+    /// Merge the traces, statistics and verified checkpoints of a worker into this analysis
+    virtual void mergeWorker(AbstractInterpretation* worker);
+
+    /// Incremental mode (-ae-incremental): the summaries of the unchanged functions are loaded
+    /// from the cache file before the analysis, and all summaries are saved to it after
+    //@{
+    void loadIncrementalCache();
+    void saveIncrementalCache();
+    /// Pairs of variables of a checker saved with the summaries, e.g., to resolve the objects
+    /// created in functions whose summaries are reused
+    virtual void getCachedVarPairs(AEIncrementalCache::VarPairs&) const {}
+    virtual void setCachedVarPairs(const AEIncrementalCache::VarPairs&) {}
+    //@}
+
     /**
      * Check if execution state exist by merging states of predecessor nodes
      *
@@ -361,6 +407,8 @@ protected:
     SVFBugReport _recoder;
     std::vector<const CallICFGNode*> _callSiteStack;
     Map<const ICFGNode*, std::string> _nodeToBugInfo;
+    /// Functions where bugs were found, including the bugs dropped at reported locations
+    Set<const SVFFunction*> _bugFuns;
     Map<const SVFFunction*, ICFGWTO*> _funcToWTO;
     Set<const SVFFunction*> _recursiveFuns;
 
@@ -374,6 +422,40 @@ private:
     virtual void directCallFunPass(const CallICFGNode* callNode);
     virtual bool isIndirectCall(const CallICFGNode* callNode);
     virtual void indirectCallFunPass(const CallICFGNode* callNode);
+    /// Analyse a callee, or reuse one of its summaries with -ae-summary or -ae-incremental
+    virtual void handleCallee(const SVFFunction* callee);
+    const NodeBS& getCalleeLocals(const SVFFunction* fun);
+    bool isCalleeLocal(const NodeBS& locals, NodeID id) const;
+
+    /// Widening thresholds of a function (-ae-widen-thresholds), i.e., the constants compared
+    /// in it and their neighbours, sorted
+    const std::vector<s64_t>& getWidenThresholds(const SVFFunction* fun);
+    /// Iterations of a cycle before widening, raised to cover the trip count of its loop
+    /// with -ae-exact-loop-iter
+    u32_t getWidenDelay(const ICFGNode* cycleHead);
+
+    /// Analyse a function without callers from the state of the global node
+    void analyseEntry(const SVFFunction* fun);
+
+    /// Shared top-level mode (-ae-shared-top-level): the state of a node keeps the address-taken
+    /// objects and the top-level variables refined by branches, other top-level variables are
+    /// in _topLevelState
+    //@{
+    /// Replace the state of node by a view with all top-level variables
+    void materializeNodeView(const ICFGNode* node);
+    /// Move the top-level variables defined in the view of node to _topLevelState
+    void flushNodeView(const ICFGNode* node);
+    /// The local state with the values of all top-level variables
+    AbstractState getFullView(const AbstractState& local);
+    /// The local state of a view derived from base (built from local), its top-level variables
+    /// updated since base are refined if refine holds, otherwise the ones not refined in local
+    /// are moved to _topLevelState
+    AbstractState getLocalState(AbstractState&& view, AbstractState&& base,
+                              const AbstractState& local, bool refine);
+    /// Widen (or narrow) the top-level variables updated since prev, return whether they are unchanged
+    bool widenTopLevelState(const AbstractState& prev, bool widen, const std::vector<s64_t>& thresholds);
+    bool isDefinedAt(NodeID id, const ICFGNode* repNode) const;
+    //@}
 
 protected:
 
@@ -402,6 +484,29 @@ protected:
     Set<const CallICFGNode*> _checkpoints;
     Set<std::string> _checkpoint_names;
     Map<const ICFGNode*, AbstractState> _abstractTrace; // abstract states immediately after nodes
+
+    /// Summary of a callee: the entries it accessed, at its entry and at its exit
+    struct FunSummary
+    {
+        DenseAbstractState input;    ///< without the variables and stack objects of the callee
+        AbstractState output;
+    };
+    Map<const SVFFunction*, std::vector<FunSummary>> _funcToSummaries;
+    /// Slots of the entries in the summary inputs of a callee
+    Map<const SVFFunction*, DenseStateIndex> _funcToSummaryIndex;
+    Map<const SVFFunction*, NodeBS> _funcToLocals;
+    Map<const SVFFunction*, NodeBS> _funcToCalleeLocals;
+    Map<const SVFFunction*, std::vector<s64_t>> _funcToThresholds;
+    AEIncrementalCache* _incrementalCache = nullptr;
+    /// Functions with checkpoints, their callers are not saved in the cache
+    Set<const SVFFunction*> _uncachedFuns;
+
+    /// Values of top-level variables in the shared top-level mode, each is defined once
+    AbstractState _topLevelState;
+    /// The node handled on a view, the view at materialization and the local state it is built from
+    const ICFGNode* _viewNode = nullptr;
+    AbstractState _viewBase;
+    AbstractState _localState;
     std::string _moduleName;
 };
 }
\ No newline at end of file
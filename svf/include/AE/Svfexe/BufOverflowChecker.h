@@ -123,6 +123,19 @@ protected:
     */
     virtual void initExtFunMap() override;
 
+    virtual AbstractInterpretation* createWorker() const override
+    {
+        return new BufOverflowChecker();
+    }
+
+    virtual void mergeWorker(AbstractInterpretation* worker) override;
+
+    /// The gep statements creating objects, as the objects with the left-hand side variables
+    //@{
+    virtual void getCachedVarPairs(AEIncrementalCache::VarPairs& varPairs) const override;
+    virtual void setCachedVarPairs(const AEIncrementalCache::VarPairs& varPairs) override;
+    //@}
+
     /**
     * the map of ext apis of buffer overflow checking rules
     *
@@ -207,9 +220,20 @@ private:
     * @param node ICFGNode that causes the exception
     */
     void addBugToRecoder(const BufOverflowException& e, const ICFGNode* node);
+    /// Record a bug unless its location is reported
+    void recordBug(const BufOverflowException& e, const ICFGNode* node, const GenericBug::EventStack& eventStack);
 
 private:
+    /// A recorded bug, replayed when merging a worker
+    struct BugRecord
+    {
+        BufOverflowException exception;
+        const ICFGNode* node;
+        GenericBug::EventStack eventStack;
+    };
+
     Map<NodeID, const GepStmt*> _addrToGep;
+    std::vector<BugRecord> _bugRecords;
     Map<std::string, std::vector<std::pair<u32_t, u32_t>>> _extAPIBufOverflowCheckRules;
 
 };
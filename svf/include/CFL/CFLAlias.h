@@ -61,6 +61,9 @@ public:
     /// Solving CFL Reachability
     virtual void solve();
 
+    /// Function of each SVFIR node
+    virtual void getNodeFunctions(CFLSummary::NodeToFunMap& nodeToFun);
+
     /// Interface exposed to users of our Alias analysis, given Value infos
     virtual AliasResult alias(const SVFValue* v1, const SVFValue* v2)
     {
@@ -72,7 +75,7 @@ public:
     /// Interface exposed to users of our Alias analysis, given PAGNodeID
     virtual AliasResult alias(NodeID node1, NodeID node2)
     {
-        if(graph->hasEdge(graph->getGNode(node1), graph->getGNode(node2), graph->startKind))
+        if(graph->hasEdge(node1, node2, graph->startKind))
             return AliasResult::MayAlias;
         else
             return AliasResult::NoAlias;
@@ -82,30 +85,28 @@ public:
     virtual const PointsTo& getCFLPts(NodeID ptr)
     {
         /// Check V Dst of ptr.
-        CFLNode *funNode = graph->getGNode(ptr);
-        for(auto outedge = funNode->getOutEdges().begin(); outedge!=funNode->getOutEdges().end(); outedge++)
+        NodeBS vDsts;
+        graph->getSuccs(ptr, graph->getStartKind(), vDsts);
+        for(NodeID vDst : vDsts)
         {
-            if((*outedge)->getEdgeKind() == graph->getStartKind())
+            // Need to Find dst addr src
+            SVFVar *vNode = svfir->getGNode(vDst);
+            NodeID basevNodeID;
+            // Remove svfir->getBaseValVar, SVF IR api change
+            if (vNode->hasIncomingEdges(SVFStmt::Gep))
             {
-                // Need to Find dst addr src
-                SVFVar *vNode = svfir->getGNode((*outedge)->getDstID());
-                NodeID basevNodeID;
-                // Remove svfir->getBaseValVar, SVF IR api change
-                if (vNode->hasIncomingEdges(SVFStmt::Gep))
-                {
-                    SVFStmt::SVFStmtSetTy& geps = vNode->getIncomingEdges(SVFStmt::Gep);
-                    SVFVar::iterator it = geps.begin();
-                    basevNodeID = (*it)->getSrcID();
-                }
-                else
-                    basevNodeID = vNode->getId();
-                addPts(ptr, basevNodeID);
-                for(auto inEdge = vNode->getInEdges().begin(); inEdge!=vNode->getInEdges().end(); inEdge++)
+                SVFStmt::SVFStmtSetTy& geps = vNode->getIncomingEdges(SVFStmt::Gep);
+                SVFVar::iterator it = geps.begin();
+                basevNodeID = (*it)->getSrcID();
+            }
+            else
+                basevNodeID = vNode->getId();
+            addPts(ptr, basevNodeID);
+            for(auto inEdge = vNode->getInEdges().begin(); inEdge!=vNode->getInEdges().end(); inEdge++)
+            {
+                if((*inEdge)->getEdgeKind() == 0)
                 {
-                    if((*inEdge)->getEdgeKind() == 0)
-                    {
-                        addPts(ptr, (*inEdge)->getSrcID());
-                    }
+                    addPts(ptr, (*inEdge)->getSrcID());
                 }
             }
         }
@@ -117,8 +118,7 @@ public:
     /// Add copy edge on constraint graph
     virtual inline bool addCopyEdge(NodeID src, NodeID dst)
     {
-        const CFLEdge *edge = graph->hasEdge(graph->getGNode(src),graph->getGNode(dst), 1);
-        if (edge != nullptr )
+        if (graph->hasEdge(src, dst, 1))
         {
             return false;
         }
@@ -171,6 +171,17 @@ public:
     /// Initialize POCRHybrid Solver
     virtual void initializeSolver();
 };
+
+class MatrixCFLAlias : public CFLAlias
+{
+public:
+    MatrixCFLAlias(SVFIR* ir) : CFLAlias(ir)
+    {
+    }
+
+    /// Initialize MatrixCFL Solver
+    virtual void initializeSolver();
+};
 } // End namespace SVF
 
 #endif /* INCLUDE_CFL_CFLALIAS_H_*/
@@ -31,6 +31,7 @@
 #define INCLUDE_CFL_CFLBASE_H_
 
 #include "CFL/CFLSolver.h"
+#include "CFL/CFLSummary.h"
 #include "CFL/CFGNormalizer.h"
 #include "CFL/GrammarBuilder.h"
 #include "CFL/CFLGraphBuilder.h"
@@ -82,6 +83,14 @@ public:
     /// Solving CFL Reachability
     virtual void solve();
 
+    /// Function summaries
+    //@{
+    /// Start solving from the summaries of the functions
+    virtual void summarizeFunctions();
+    /// Function of each node of the CFL graph, none for global nodes
+    virtual void getNodeFunctions(CFLSummary::NodeToFunMap&) {}
+    //@}
+
     /// Finalize extra stat info passing
     virtual void finalize();
 
@@ -103,6 +112,10 @@ public:
     static double numOfIteration;                   // Number solving Iteration
     static double numOfChecks;                  // Number of checks
     static double timeOfSolving;                    // time of solving CFL Reachability
+    // Summary
+    static double numOfSummarizedFuns;              // Number of functions summarized in this run
+    static double numOfReusedSummaries;             // Number of functions whose summary was loaded
+    static double timeOfSummaries;                  // time of summarizing functions
     //@}
 
 protected:
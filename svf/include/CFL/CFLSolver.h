@@ -33,6 +33,8 @@
 #include "Graphs/CFLGraph.h"
 #include "CFL/CFGrammar.h"
 #include "Util/WorkList.h"
+#include <functional>
+#include <tuple>
 
 using namespace std;
 
@@ -49,6 +51,20 @@ public:
     typedef CFGrammar::Production Production;
     typedef CFGrammar::Symbol Symbol;
 
+    /// An edge of a solved graph
+    struct SolvedEdge
+    {
+        NodeID src;
+        NodeID dst;
+        CFLEdge::GEdgeFlag label;
+
+        inline bool operator<(const SolvedEdge& rhs) const
+        {
+            return std::tie(src, dst, label) < std::tie(rhs.src, rhs.dst, rhs.label);
+        }
+    };
+    typedef std::vector<SolvedEdge> SolvedEdges;
+
     static double numOfChecks;
 
     CFLSolver(CFLGraph* _graph, CFGrammar* _grammar): graph(_graph), grammar(_grammar)
@@ -67,9 +83,27 @@ public:
     /// Process CFLEdge
     virtual void processCFLEdge(const CFLEdge* Y_edge);
 
-    /// Start solving
+    /// Start solving, later calls only derive from the edges pushed since
     virtual void solve();
 
+    /// Solved edges kept across runs
+    //@{
+    /// Add sorted edges of the graph's nodes closed under the grammar, e.g., the fixpoint of a subgraph,
+    /// so that solve() only derives from the other edges of the graph. Return false if not before solving.
+    bool addSolvedEdges(const SolvedEdges& edges);
+    /// Add the edges solved by an earlier run, so that solve() only derives from the edges that run did
+    /// not have. Return false if the file is missing, or if an input edge of that run is not in the graph.
+    bool loadSolvedEdges(const std::string& filename);
+    /// Write the input edges of the graph and all edges solved so far
+    bool saveSolvedEdges(const std::string& filename);
+    //@}
+
+    /// Whether the solver keeps its results between solves, so that they only process pushed edges
+    virtual bool isIncremental() const
+    {
+        return true;
+    }
+
     /// Return CFL Graph
     inline const CFLGraph* getGraph() const
     {
@@ -104,11 +138,25 @@ protected:
     }
     //@}
 
+    /// Record the edges of the graph before the first solve or load
+    void recordInputEdges();
+
+    /// Add an edge solved by an earlier run without deriving from it
+    virtual void addSolvedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+    {
+        graph->addCFLEdge(graph->getGNode(src), graph->getGNode(dst), label);
+    }
+
 protected:
     CFLGraph* graph;
     CFGrammar* grammar;
     /// Worklist for resolution
     WorkList worklist;
+    /// Whether the edges of the graph have been solved
+    bool solved = false;
+    /// Edges of the graph before solving
+    std::vector<std::tuple<NodeID, NodeID, CFLEdge::GEdgeFlag>> inputEdges;
+    bool inputRecorded = false;
 
 };
 
@@ -282,6 +330,12 @@ public:
     virtual void buildCFLData();
 
     virtual void initialize();
+
+    /// Edges pushed by clients are not in CFLData, so each solve starts from all edges
+    virtual bool isIncremental() const
+    {
+        return false;
+    }
 };
 /*!
  * Hybrid graph representation for transitive relations
@@ -369,6 +423,105 @@ public:
     void addArc(NodeID src, NodeID dst);
     void meld(NodeID x, TreeNode* uNode, TreeNode* vNode);
 };
+
+/*!
+ * Parallel CFL-reachability solver
+ * Edges are derived in rounds (semi-naive evaluation): each round joins the edges found in the
+ * previous round with all edges found so far. Derived edges are kept once, in the CFLGraph without
+ * CFLEdge objects; nodes are sharded and the candidate edges of a round are deduplicated by the
+ * threads owning the shards of their sources, so no locks are needed. The solver only keeps the
+ * incoming derived edges of the labels Z of productions X -> Z Y, which are joined backwards.
+ */
+class ParallelCFLSolver : public CFLSolver
+{
+public:
+    typedef Map<u32_t, NodeBS> LabelToNodesMap;             // Label with SparseBitVector of NodeID
+    typedef Map<NodeID, LabelToNodesMap> Shard;             // Each node of a shard has a LabelToNodesMap
+
+    struct Edge
+    {
+        NodeID src;
+        NodeID dst;
+        u32_t label;
+    };
+    typedef std::vector<Edge> Edges;
+
+    ParallelCFLSolver(CFLGraph* _graph, CFGrammar* _grammar, u32_t threads);
+
+    /// Destructor
+    virtual ~ParallelCFLSolver()
+    {
+    }
+
+    /// Start solving
+    virtual void solve();
+
+protected:
+    virtual void addSolvedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label);
+
+    /// Derive the edges of the next round from the edges of this round
+    void solveRound(const Edges& delta, Edges& newDelta);
+
+    /// Candidate edges derived from one edge, grouped by the shards of their sources
+    void deriveEdges(const Edge& edge, std::vector<Edges>& candidates, u64_t& checks) const;
+
+    /// Neighbours along derived edges of a label, nullptr if there are none
+    //@{
+    const NodeBS* getDerivedSuccs(NodeID src, u32_t label) const;
+    const NodeBS* getDerivedPreds(NodeID dst, u32_t label) const;
+    //@}
+
+    /// Record a derived edge in the incoming edges if it is joined backwards
+    inline void addDerivedPred(const Edge& edge)
+    {
+        if (grammar->hasProdsFromFirstRHS(edge.label))
+            predShards[getShard(edge.dst)][edge.dst][edge.label].set(edge.src);
+    }
+
+    inline u32_t getShard(NodeID id) const
+    {
+        return id % numShards;
+    }
+
+    /// Run task(0) ... task(numTasks-1) on the threads of the solver
+    void parallelForEach(u32_t numTasks, const std::function<void(u32_t)>& task) const;
+
+    u32_t numThreads;
+    u32_t numShards;
+    std::vector<Shard> predShards;                          // incoming derived edges, sharded by destination
+};
+
+/*!
+ * Matrix-based CFL-reachability solver for grammars in normal form
+ * The relation of each label is a boolean matrix whose rows are bit vectors. A production X -> Y Z
+ * is evaluated as X[i] |= Z[j] for each j in Y[i], a whole machine word of a row at a time.
+ * Rounds are semi-naive on rows: row X[i] is only recomputed from the rows of Y and Z changed in
+ * the previous round, which are found by intersecting Y[i] with a mask of the changed rows of Z.
+ * Rows are dense bit vectors on graphs of at most MaxDenseNodes nodes, sparse ones (NodeBS) otherwise.
+ */
+class MatrixCFLSolver : public CFLSolver
+{
+public:
+    /// Label matrices, implemented with dense or sparse rows
+    class Relation;
+
+    /// Largest graph using dense rows
+    static const u32_t MaxDenseNodes = 16384;
+
+    MatrixCFLSolver(CFLGraph* _graph, CFGrammar* _grammar);
+
+    /// Destructor
+    virtual ~MatrixCFLSolver();
+
+    /// Start solving
+    virtual void solve();
+
+protected:
+    virtual void addSolvedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label);
+
+private:
+    Relation* relation;
+};
 }
 
 #endif /* INCLUDE_CFL_CFLSolver_H_*/
\ No newline at end of file
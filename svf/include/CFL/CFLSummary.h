@@ -0,0 +1,137 @@
+//===----- CFLSummary.h -- Function summaries of CFL-reachability--------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CFLSummary.h
+ *
+ * Function summaries of CFL-reachability kept across runs.
+ *
+ * The summary of a function is the fixpoint of its intra-procedural subgraph,
+ * i.e., the edges between the nodes of the function. These subgraphs do not share
+ * nodes, so the union of the summaries is closed under the grammar and the whole
+ * graph is solved from it by only processing the inter-procedural and global edges.
+ *
+ * Nodes of a function are numbered by their order of IDs in the summary file, so
+ * a summary is reused whenever a function (of this or another program) with the
+ * same name has the same intra-procedural subgraph up to this numbering.
+ */
+
+#ifndef INCLUDE_CFL_CFLSUMMARY_H_
+#define INCLUDE_CFL_CFLSUMMARY_H_
+
+#include "CFL/CFLSolver.h"
+
+namespace SVF
+{
+
+namespace CFLSummaryFile
+{
+
+static const u32_t Version = 1;
+static const char Magic[8] = {'S', 'V', 'F', 'C', 'F', 'L', 'S', '\0'};
+
+/// A file is a Header followed by numFuns FunRecords and numEdges edges
+/// (CFLSolver::SolvedEdge) between the numbered nodes of the functions.
+struct Header
+{
+    char magic[8];
+    u32_t version;
+    u32_t reserved;
+    u64_t grammar;          ///< hash of the normalized grammar
+    u64_t numFuns;
+    u64_t numEdges;
+};
+
+struct FunRecord
+{
+    u64_t name;
+    u64_t content;          ///< hash of the intra-procedural subgraph
+    u32_t numNodes;
+    u32_t edgeNum;
+    u64_t edgeBegin;
+};
+
+} // End namespace CFLSummaryFile
+
+/*!
+ * Summaries of the functions of a CFLGraph
+ */
+class CFLSummary
+{
+public:
+    typedef Map<NodeID, const SVFFunction*> NodeToFunMap;
+    typedef CFLSolver::SolvedEdges SolvedEdges;
+
+    /// Collect the intra-procedural subgraphs of graph, nodes not in nodeToFun are global
+    CFLSummary(const CFLGraph* graph, CFGrammar* grammar, const NodeToFunMap& nodeToFun);
+
+    /// Read the summaries of an earlier run, return false if the file is missing or for another grammar
+    bool load(const std::string& filename);
+
+    /// Write the summaries of this run and the loaded ones of other functions
+    bool save(const std::string& filename) const;
+
+    /// Summary edges of all functions (sorted), solving the functions without a loaded summary
+    void summarize(SolvedEdges& edges);
+
+    inline u32_t getNumOfSummarizedFuns() const
+    {
+        return numOfSummarizedFuns;
+    }
+    inline u32_t getNumOfReusedFuns() const
+    {
+        return numOfReusedFuns;
+    }
+
+private:
+    struct FunGraph
+    {
+        u64_t name;
+        u64_t content;
+        std::vector<NodeID> nodes;      ///< sorted, a node is numbered by its index
+        SolvedEdges edges;              ///< intra-procedural edges between numbered nodes
+        SolvedEdges summary;            ///< fixpoint of edges
+    };
+
+    /// Number of a node of a function
+    static inline NodeID getLocalID(const FunGraph& fun, NodeID id)
+    {
+        return std::lower_bound(fun.nodes.begin(), fun.nodes.end(), id) - fun.nodes.begin();
+    }
+
+    /// Solve the subgraphs of funs together, they do not share nodes
+    void solveFunctions(const std::vector<u32_t>& funs);
+
+    CFGrammar* grammar;
+    u64_t grammarHash;
+    std::vector<FunGraph> funGraphs;
+
+    /// Loaded summaries: name -> (content, numNodes, summary)
+    Map<u64_t, std::tuple<u64_t, u32_t, SolvedEdges>> loaded;
+
+    u32_t numOfSummarizedFuns = 0;
+    u32_t numOfReusedFuns = 0;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_CFL_CFLSUMMARY_H_*/
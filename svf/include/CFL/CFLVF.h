@@ -58,6 +58,9 @@ public:
     /// Build CFLGraph via VFG
     void buildCFLGraph();
 
+    /// Function of each SVFG node
+    virtual void getNodeFunctions(CFLSummary::NodeToFunMap& nodeToFun);
+
 private:
     CFLSVFGBuilder memSSA;
     SVFG* svfg;
@@ -79,6 +79,9 @@ public:
     /// Compute points-to set for a context-sensitive pointer
     virtual const CxtPtSet& computeDDAPts(const CxtVar& cxtVar);
 
+    /// Compute points-to sets of unconditional pointers sharing one traversal
+    virtual void computeDDAPtsInBatch(const NodeBS& ids) override;
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const CxtLocDPItem& dpm);
 
@@ -143,16 +146,29 @@ public:
     {
         CallEdgeMap newEdges;
         resolveIndCalls(cs, getBVPointsTo(getCachedPointsTo(dpm)), newEdges);
-        for (CallEdgeMap::const_iterator iter = newEdges.begin(),eiter = newEdges.end(); iter != eiter; iter++)
+        connectIndirectCalls(newEdges, svfgEdges);
+    }
+    virtual void replayIndirectCalls(const CallEdgeMap& calls) override
+    {
+        CallEdgeMap newEdges;
+        for (CallEdgeMap::const_iterator it = calls.begin(), eit = calls.end(); it != eit; ++it)
         {
-            const CallICFGNode* newcs = iter->first;
-            const FunctionSet & functions = iter->second;
-            for (FunctionSet::const_iterator func_iter = functions.begin(); func_iter != functions.end(); func_iter++)
+            for (const SVFFunction* callee : it->second)
             {
-                const SVFFunction*  func = *func_iter;
-                getSVFG()->connectCallerAndCallee(newcs, func, svfgEdges);
+                if (queryCache)
+                    queryCache->resolveCall(queryStream, it->first, callee);
+                if (getIndCallMap()[it->first].insert(callee).second)
+                {
+                    newEdges[it->first].insert(callee);
+                    getCallGraph()->addIndirectCallGraphEdge(it->first, it->first->getCaller(), callee);
+                }
             }
         }
+        if (newEdges.empty())
+            return;
+        SVFGEdgeSet svfgEdges;
+        connectIndirectCalls(newEdges, svfgEdges);
+        getCallGraphSCC()->find();
     }
     //@}
 
@@ -220,9 +236,24 @@ public:
     }
 
 private:
+    /// Traversal costs of the queries of a function
+    struct FunCost
+    {
+        u32_t numOfQuery = 0;
+        u32_t numOfOOBQuery = 0;
+    };
+
+    /// Adaptive step budgets (-cxt-bg-scale)
+    //@{
+    u32_t computeQueryBudget(NodeID id, const SVFFunction* fun);
+    void learnQueryCost(const SVFFunction* fun, u64_t steps, bool oob);
+    //@}
+
     ConstSVFGEdgeSet insensitveEdges;///< insensitive call-return edges
     FlowDDA* flowDDA;			///< downgrade to flowDDA if out-of-budget
     DDAClient* _client;			///< DDA client
+    Map<const SVFFunction*, FunCost> funToCost;	///< costs of earlier queries per function
+    s64_t budgetCredit;			///< steps left unspent by earlier queries
 };
 
 } // End namespace SVF
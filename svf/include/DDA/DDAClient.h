@@ -98,6 +98,9 @@ public:
     }
     virtual void answerQueries(PointerAnalysis* pta);
 
+    /// Answer queries of pointers of the same function in batches
+    void answerQueriesInBatch(PointerAnalysis* pta);
+
     virtual inline void performStat(PointerAnalysis*) {}
 
     virtual inline void collectWPANum(SVFModule*) {}
@@ -33,6 +33,7 @@
 #define DDAPASS_H_
 
 #include "DDA/DDAClient.h"
+#include "DDA/DDAQueryCache.h"
 #include "Graphs/SCC.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 
@@ -79,6 +80,10 @@ private:
     void printQueryPTS();
     /// Create pointer analysis according to specified kind and analyze the module.
     void runPointerAnalysis(SVFIR* module, u32_t kind);
+    /// Answer the client's queries with Options::DDAThreads() solvers of the given kind.
+    void answerQueriesInParallel(SVFIR* pag, u32_t kind);
+    /// Answer and record queries of the solver of the given kind with a persistent cache.
+    void setQueryCache(u32_t kind, DDAQueryCache* cache);
     /// Context insensitive Edge for DDA
     void initCxtInsensitiveEdges(PointerAnalysis* pta, const SVFG* svfg,const SVFGSCC* svfgSCC, SVFGEdgeSet& insensitveEdges);
     /// Return TRUE if this edge is inside a SVFG SCC, i.e., src node and dst node are in the same SCC on the SVFG.
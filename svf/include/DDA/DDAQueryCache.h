@@ -0,0 +1,251 @@
+//===- DDAQueryCache.h -- Persistent cache of DDA query results-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDAQueryCache.h
+ *
+ * Points-to sets of DDA queries kept across runs in an mmapped file.
+ *
+ * A query (pointer, empty context, definition location) is only reused when the
+ * analysis settings and global statements match, and the functions the query
+ * depends on have the same content hash. The content hash covers the node IDs
+ * of a function's statements, so the IDs a query is keyed by are still valid.
+ * Each solver records a stream: the order in which it first visited functions
+ * and the indirect calls it resolved. The solver reuses the work of its earlier
+ * queries, so a query depends on a prefix of the stream of its solver, i.e.,
+ * every function visited until it completed. The calls of that prefix are
+ * added to the call graph when the query is reused, as the traversal would have
+ * resolved them. A solver taking the result of another solver (parallel
+ * workers) appends the prefix of the other stream to its own.
+ */
+
+#ifndef DDAQUERYCACHE_H_
+#define DDAQUERYCACHE_H_
+
+#include "SVFIR/SVFIR.h"
+#include "MemoryModel/PointerAnalysisImpl.h"
+#include "Util/DPItem.h"
+#include <mutex>
+
+namespace SVF
+{
+
+namespace DDAQueryFile
+{
+
+static const u32_t Version = 2;
+static const char Magic[8] = {'S', 'V', 'F', 'D', 'D', 'A', 'Q', '\0'};
+/// Dependency of a query on all functions
+static const u32_t AllFuns = ~0U;
+
+/// A file is a Header followed by numFuns FunRecords, numStreams StreamRecords,
+/// numVisited u32_t function indices (the visiting orders of the streams),
+/// numCalls CallRecords, numEntries EntryRecords sorted by (ptr, loc) and
+/// numWords u32_t encoding the points-to sets.
+struct Header
+{
+    char magic[8];
+    u32_t version;
+    u32_t kind;             ///< PointerAnalysis::PTATY
+    u64_t fingerprint;
+    u32_t numFuns;
+    u32_t numStreams;
+    u32_t numVisited;
+    u32_t numCalls;
+    u32_t numEntries;
+    u32_t numWords;
+};
+
+struct FunRecord
+{
+    u64_t name;
+    u64_t content;
+};
+
+/// Visiting order and resolved calls of a solver
+struct StreamRecord
+{
+    u32_t visitBegin;
+    u32_t visitNum;
+    u32_t callBegin;
+    u32_t callNum;
+};
+
+/// An indirect call resolved by a solver
+struct CallRecord
+{
+    u32_t cs;               ///< ICFG node ID of the call site
+    u32_t caller;           ///< function index
+    u32_t callee;           ///< function index
+};
+
+struct EntryRecord
+{
+    u32_t ptr;
+    u32_t loc;
+    u32_t stream;
+    u32_t deps;             ///< number of visited functions of the stream, or AllFuns
+    u32_t calls;            ///< number of resolved calls of the stream
+    u32_t ptsBegin;
+    u32_t ptsNum;
+};
+
+} // End namespace DDAQueryFile
+
+/*!
+ * Persistent cache of DDA query results
+ */
+class DDAQueryCache
+{
+public:
+    typedef std::vector<u32_t> Words;
+    typedef CallGraph::CallEdgeMap CallEdgeMap;
+
+    /// Functions visited and calls resolved by one solver, in order
+    struct Stream
+    {
+        std::vector<bool> visited;
+        std::vector<u32_t> visitOrder;      ///< appended under the lock of the cache
+        std::vector<std::pair<const CallICFGNode*, u32_t>> calls;   ///< appended under the lock
+        Set<std::pair<const CallICFGNode*, u32_t>> resolved;
+        bool allFuns = false;
+    };
+
+    DDAQueryCache(SVFIR* pag, BVDataPTAImpl* pre, u32_t kind);
+    DDAQueryCache(const DDAQueryCache&) = delete;
+    DDAQueryCache& operator=(const DDAQueryCache&) = delete;
+
+    ~DDAQueryCache();
+
+    /// Map a cache file, return false if it is missing or does not belong to this module
+    bool load(const std::string& filename);
+
+    /// Write the queries answered in this run
+    bool save(const std::string& filename) const;
+
+    /// A new stream for a solver, created before the solvers run in parallel
+    Stream* addStream();
+
+    /// Encoded points-to set of a still valid query, nullptr if not cached.
+    /// The functions the query depends on are appended to stream, the calls its
+    /// traversal resolved are returned in calls, to be added by the solver.
+    const u32_t* find(Stream* stream, NodeID ptr, NodeID loc, u32_t& num, CallEdgeMap& calls);
+
+    /// Append the dependencies of a query answered in this run by any solver to stream and
+    /// return its calls, false if the query is not in this cache
+    bool dependOnQuery(Stream* stream, NodeID ptr, NodeID loc, CallEdgeMap& calls);
+
+    /// Add a query answered in this run by the solver of stream, the first result is kept
+    void add(Stream* stream, NodeID ptr, NodeID loc, const Words& pts);
+
+    /// Record that the solver of stream has visited a node of fun
+    inline void visitFunction(Stream* stream, const SVFFunction* fun)
+    {
+        if (fun == nullptr || stream->allFuns)
+            return;
+        Map<const SVFFunction*, u32_t>::const_iterator it = funToIdx.find(fun);
+        if (it != funToIdx.end())
+            visitFunctionIdx(stream, it->second);
+    }
+
+    /// Record that the solver of stream has resolved an indirect call
+    void resolveCall(Stream* stream, const CallICFGNode* cs, const SVFFunction* callee);
+
+    /// Later queries of stream depend on all functions, e.g., after an out-of-budget query
+    inline void dependOnAll(Stream* stream)
+    {
+        stream->allFuns = true;
+    }
+
+    inline u32_t getNumOfEntries() const
+    {
+        return entries.size();
+    }
+
+    /// Encode and decode points-to sets of flow- and context-sensitive analyses
+    //@{
+    static void encode(const PointsTo& pts, Words& words);
+    static void encode(const CxtPtSet& pts, Words& words);
+    static void decode(const u32_t* words, u32_t num, PointsTo& pts);
+    static void decode(const u32_t* words, u32_t num, CxtPtSet& pts);
+    //@}
+
+private:
+    typedef std::pair<NodeID, NodeID> Key;
+
+    /// A query answered in this run and the prefix of its stream it depends on
+    struct Entry
+    {
+        u32_t stream;
+        u32_t deps;             ///< or DDAQueryFile::AllFuns
+        u32_t calls;
+        Words pts;
+    };
+
+    inline void visitFunctionIdx(Stream* stream, u32_t idx)
+    {
+        if (!stream->visited[idx])
+        {
+            stream->visited[idx] = true;
+            std::lock_guard<std::mutex> guard(lock);
+            stream->visitOrder.push_back(idx);
+        }
+    }
+
+    /// Append a prefix of other to stream and return its calls, the lock is held
+    void appendPrefix(Stream* stream, const Stream* other, u32_t deps, u32_t calls, CallEdgeMap& callMap);
+
+    /// Whether a loaded entry only depends on unchanged functions
+    bool isValid(const DDAQueryFile::EntryRecord& rec) const;
+
+    SVFIR* pag;
+    u32_t kind;
+    u64_t fingerprint;
+    std::vector<u64_t> nameHashes;
+    std::vector<u64_t> contentHashes;
+    Map<const SVFFunction*, u32_t> funToIdx;
+    std::vector<const SVFFunction*> idxToFun;
+
+    /// Streams of the solvers in this run and the queries they answered
+    std::vector<std::unique_ptr<Stream>> streams;
+    Map<const Stream*, u32_t> streamToIdx;
+    OrderedMap<Key, Entry> entries;
+    std::mutex lock;
+
+    /// Loaded file
+    const char* base;
+    u64_t size;
+    const DDAQueryFile::Header* header;
+    const DDAQueryFile::StreamRecord* oldStreams;
+    const u32_t* oldVisitOrder;
+    const DDAQueryFile::CallRecord* oldCalls;
+    const DDAQueryFile::EntryRecord* oldEntries;
+    const u32_t* oldWords;
+    std::vector<u32_t> oldToCurFun;     ///< function of the file -> function of this run
+    std::vector<u32_t> validPrefix;     ///< visited functions of each stream of the file still unchanged
+    std::vector<u32_t> validCalls;      ///< calls of each stream of the file between unchanged functions
+    bool unchanged;                     ///< no function has changed
+};
+
+} // End namespace SVF
+
+#endif /* DDAQUERYCACHE_H_ */
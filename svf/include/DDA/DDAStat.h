@@ -55,6 +55,10 @@ public:
     u32_t _NumOfStrongUpdates;
     u32_t _NumOfMustAliases;
     u32_t _NumOfInfeasiblePath;
+    u32_t _NumOfCachedQuery;
+    u32_t _NumOfReusedDPM;
+    u32_t _NumOfRaisedBudget;
+    u32_t _NumOfLoweredBudget;
 
     u64_t _NumOfStep;
     u64_t _NumOfStepInCycle;
@@ -75,6 +79,13 @@ public:
 
     void getNumOfOOBQuery();
 
+    /// Record the steps and time spent by a query
+    inline void addQueryCost(u64_t steps, double time)
+    {
+        _StepsPerQuery.push_back(steps);
+        _TimePerQuery.push_back(time);
+    }
+
 private:
     FlowDDA* flowDDA;
     ContextDDA* contextDDA;
@@ -103,8 +114,14 @@ private:
 
     NUMStatMap NumPerQueryStatMap;
 
+    std::vector<u64_t> _StepsPerQuery;
+    std::vector<double> _TimePerQuery;
+
     void initDefault();
 
+    /// Percentiles of the per-query costs
+    void costDistributionStat();
+
 public:
     SVFG* getSVFG() const;
 
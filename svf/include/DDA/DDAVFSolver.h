@@ -31,15 +31,49 @@
 #define VALUEFLOWDDA_H_
 
 #include "DDA/DDAStat.h"
+#include "DDA/DDAQueryCache.h"
 #include "Graphs/SCC.h"
 #include "MSSA/SVFGBuilder.h"
 #include "MemoryModel/PointsTo.h"
 #include "WPA/Andersen.h"
 #include <algorithm>
+#include <shared_mutex>
 
 namespace SVF
 {
 
+/*!
+ * Points-to sets of completed queries, shared by the solvers answering queries in parallel.
+ * A result is added once and never changed afterwards, so a found set can be read without the lock.
+ */
+template<class DPIm, class CPtSet>
+class DDAResultCache
+{
+public:
+    /// Return the points-to set of a completed query, nullptr if not found
+    inline const CPtSet* find(const DPIm& dpm) const
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        typename OrderedMap<DPIm, CPtSet>::const_iterator it = results.find(dpm);
+        return it == results.end() ? nullptr : &it->second;
+    }
+    /// Add the points-to set of a completed query
+    inline void add(const DPIm& dpm, const CPtSet& pts)
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        results.emplace(dpm, pts);
+    }
+    inline u32_t size() const
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return results.size();
+    }
+
+private:
+    mutable std::shared_mutex lock;
+    OrderedMap<DPIm, CPtSet> results;
+};
+
 /*!
  * Value-Flow Based Demand-Driven Points-to Analysis
  */
@@ -60,10 +94,13 @@ public:
     typedef OrderedSet<const SVFGEdge* > ConstSVFGEdgeSet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSet;
     typedef OrderedMap<const SVFGNode*, DPTItemSet> StoreToPMSetMap;
+    typedef DDAResultCache<DPIm, CPtSet> ResultCache;
 
     ///Constructor
-    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr)
+    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr), resultCache(nullptr), queryCache(nullptr), queryStream(nullptr), sharedSVFG(false), inBatch(false)
     {
+        /// functions of a lazily read SVFG are added when the traversal reaches them
+        svfgBuilder.setMaterializeOnDemand(true);
     }
     /// Destructor
     virtual ~DDAVFSolver()
@@ -119,6 +156,28 @@ public:
     {
         return _svfg;
     }
+    /// Share the results of completed queries with other solvers (nullptr to stop sharing)
+    inline void setResultCache(ResultCache* cache)
+    {
+        resultCache = cache;
+    }
+    /// Answer queries on the SVFG of another solver instead of building one (call before initialize).
+    /// The SVFG is not modified, its indirect calls must be connected with the pre-analysis call graph.
+    inline void shareSVFG(SVFG* svfg)
+    {
+        _svfg = svfg;
+        sharedSVFG = true;
+    }
+    /// Answer and record queries with a persistent cache (nullptr to disable)
+    inline void setQueryCache(DDAQueryCache* cache)
+    {
+        queryCache = cache;
+        queryStream = cache ? cache->addStream() : nullptr;
+    }
+    inline DDAQueryCache* getQueryCache() const
+    {
+        return queryCache;
+    }
     /// Return SVFGSCC
     inline SVFGSCC* getSVFGSCC() const
     {
@@ -140,6 +199,7 @@ public:
 
         if(isbkVisited(dpm))
         {
+            countReusedDpm(dpm);
             const CPtSet& cpts = getCachedPointsTo(dpm);
             DBOUT(DDDA, SVFUtil::outs() << "\t already backward visited dpm: ");
             DBOUT(DDDA, dpm.dump());
@@ -152,8 +212,19 @@ public:
         DBOUT(DDDA, dpm.dump());
         markbkVisited(dpm);
         addDpmToLoc(dpm);
+        if(inBatch)
+            batchQueryVisited.insert(dpm);
+        _svfg->materializeFunction(dpm.getLoc()->getFun());
+        if(queryCache)
+            queryCache->visitFunction(queryStream, dpm.getLoc()->getFun());
 
-        if(testOutOfBudget(dpm) == false)
+        /// reuse the result of a query completed by another solver
+        if(const CPtSet* cachedPts = findCompletedQuery(dpm))
+        {
+            dependOnCompletedQuery(dpm);
+            updateCachedPointsTo(dpm, *cachedPts);
+        }
+        else if(testOutOfBudget(dpm) == false)
         {
 
             CPtSet pts;
@@ -317,7 +388,8 @@ protected:
     virtual inline void buildSVFG(SVFIR* pag)
     {
         _ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
-        _svfg = svfgBuilder.buildPTROnlySVFG(_ander);
+        if(sharedSVFG == false)
+            _svfg = svfgBuilder.buildPTROnlySVFG(_ander);
         _pag = _svfg->getPAG();
     }
     /// Reset visited map for next points-to query
@@ -326,15 +398,81 @@ protected:
         if(outOfBudgetQuery)
             OOBResetVisited();
 
-        locToDpmSetMap.clear();
-        dpmToloadDpmMap.clear();
-        loadToPTCVarMap.clear();
+        /// queries of a batch share their traversal state
+        if(inBatch)
+            batchQueryVisited.clear();
+        else
+        {
+            locToDpmSetMap.clear();
+            dpmToloadDpmMap.clear();
+            loadToPTCVarMap.clear();
+        }
         outOfBudgetQuery = false;
         ddaStat->_NumOfStep = 0;
     }
+    /// Results of completed queries in the shared cache
+    //@{
+    inline const CPtSet* findCompletedQuery(const DPIm& dpm) const
+    {
+        if(resultCache == nullptr || !isTopLevelPtrStmt(dpm.getLoc()))
+            return nullptr;
+        return resultCache->find(dpm);
+    }
+    inline void addCompletedQuery(const DPIm& dpm, const CPtSet& pts)
+    {
+        if(resultCache)
+            resultCache->add(dpm, pts);
+    }
+    //@}
+    /// Results of queries in the persistent cache
+    //@{
+    /// A hit also adds the indirect calls the traversal of the query resolved
+    inline bool findPersistentQuery(const DPIm& dpm, CPtSet& pts)
+    {
+        u32_t num = 0;
+        CallGraph::CallEdgeMap calls;
+        const u32_t* words = queryCache ? queryCache->find(queryStream, dpm.getCurNodeID(), dpm.getLoc()->getId(), num, calls) : nullptr;
+        if(words == nullptr)
+            return false;
+        DDAQueryCache::decode(words, num, pts);
+        replayIndirectCalls(calls);
+        DOSTAT(ddaStat->_NumOfCachedQuery++);
+        return true;
+    }
+    inline void addPersistentQuery(const DPIm& dpm, const CPtSet& pts)
+    {
+        if(queryCache == nullptr)
+            return;
+        DDAQueryCache::Words words;
+        DDAQueryCache::encode(pts, words);
+        queryCache->add(queryStream, dpm.getCurNodeID(), dpm.getLoc()->getId(), words);
+    }
+    /// The result of dpm was taken from the shared cache, the later queries of this solver
+    /// depend on what the solver completing dpm visited, and its calls are added
+    inline void dependOnCompletedQuery(const DPIm& dpm)
+    {
+        if(queryCache == nullptr)
+            return;
+        CallGraph::CallEdgeMap calls;
+        if(queryCache->dependOnQuery(queryStream, dpm.getCurNodeID(), dpm.getLoc()->getId(), calls))
+            replayIndirectCalls(calls);
+        else
+            queryCache->dependOnAll(queryStream);
+    }
+    inline void dependOnAllFunctions()
+    {
+        if(queryCache)
+            queryCache->dependOnAll(queryStream);
+    }
+    //@}
     /// Reset visited map if the current query is out-of-budget
     inline void OOBResetVisited()
     {
+        if(inBatch)
+        {
+            OOBResetVisitedInBatch();
+            return;
+        }
         for(typename LocToDPMVecMap::const_iterator it = locToDpmSetMap.begin(),eit = locToDpmSetMap.end(); it!=eit; ++it)
         {
             DPTItemSet dpmSet(it->second.begin(), it->second.end());
@@ -343,6 +481,45 @@ protected:
                     clearbkVisited(*dit);
         }
     }
+    /// Only reset dpms (re)visited by the out-of-budget query,
+    /// those the completed queries of the batch reached and it merely reused are final
+    inline void OOBResetVisitedInBatch()
+    {
+        for(typename DPTItemSet::const_iterator it = batchQueryVisited.begin(), eit = batchQueryVisited.end(); it!=eit; ++it)
+        {
+            const DPIm& dpm = *it;
+            if(isOutOfBudgetDpm(dpm) || !isbkVisited(dpm))
+                continue;
+            clearbkVisited(dpm);
+            locToDpmSetMap[dpm.getLoc()->getId()].erase(dpm);
+        }
+        batchQueryVisited.clear();
+    }
+    /// Queries of a batch are answered one after another on shared traversal state, so that
+    /// value-flow cycles are recomputed for the whole batch and an out-of-budget query only
+    /// discards its own work.
+    //@{
+    inline void beginQueryBatch()
+    {
+        resetQuery();
+        inBatch = true;
+    }
+    inline void endQueryBatch()
+    {
+        if(outOfBudgetQuery)
+            OOBResetVisited();
+        batchQueryVisited.clear();
+        inBatch = false;
+        outOfBudgetQuery = false;
+        resetQuery();
+    }
+    /// A visited dpm the current query has not visited itself was computed by an earlier query of the batch
+    inline void countReusedDpm(const DPIm& dpm)
+    {
+        if(inBatch && batchQueryVisited.find(dpm) == batchQueryVisited.end())
+            DOSTAT(ddaStat->_NumOfReusedDPM++);
+    }
+    //@}
     /// GetDefinition SVFG
     inline const SVFGNode* getDefSVFGNode(const PAGNode* pagNode) const
     {
@@ -425,6 +602,10 @@ protected:
     /// dpm transit during backward tracing
     virtual void backwardPropDpm(CPtSet& pts, NodeID ptr,const DPIm& oldDpm,const SVFGEdge* edge)
     {
+        /// a shared SVFG has the calls of the pre-analysis, skip those not resolved by this solver
+        if(sharedSVFG && isResolvedCallEdge(edge) == false)
+            return;
+
         DPIm dpm(oldDpm);
         dpm.setLocVar(edge->getSrcNode(),ptr);
         DOTIMESTAT(double start = DDAStat::getClk(true));
@@ -445,6 +626,49 @@ protected:
         /// handle out of budget case
         unionDDAPts(pts,findPT(dpm));
     }
+    /// Whether a call/ret edge is a direct call or an indirect call resolved by this solver
+    bool isResolvedCallEdge(const SVFGEdge* edge) const
+    {
+        CallSiteID csId = 0;
+        const SVFFunction* callee = nullptr;
+        if (const CallDirSVFGEdge* callEdge = SVFUtil::dyn_cast<CallDirSVFGEdge>(edge))
+            csId = callEdge->getCallSiteId(), callee = edge->getDstNode()->getFun();
+        else if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(edge))
+            csId = callEdge->getCallSiteId(), callee = edge->getDstNode()->getFun();
+        else if (const RetDirSVFGEdge* retEdge = SVFUtil::dyn_cast<RetDirSVFGEdge>(edge))
+            csId = retEdge->getCallSiteId(), callee = edge->getSrcNode()->getFun();
+        else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(edge))
+            csId = retEdge->getCallSiteId(), callee = edge->getSrcNode()->getFun();
+        else
+            return true;
+
+        const CallICFGNode* cbn = _svfg->getCallSite(csId);
+        if (_pag->isIndirectCallSites(cbn) == false)
+            return true;
+        if (_callGraph->hasIndCSCallees(cbn) == false)
+            return false;
+        const CallGraph::FunctionSet& callees = _callGraph->getIndCSCallees(cbn);
+        return callees.find(callee) != callees.end();
+    }
+    /// Collect the SVFG edges of newly resolved indirect calls, connecting them on an own SVFG
+    void connectIndirectCalls(const CallGraph::CallEdgeMap& newEdges, SVFGEdgeSet& svfgEdges)
+    {
+        for (CallGraph::CallEdgeMap::const_iterator iter = newEdges.begin(),eiter = newEdges.end(); iter != eiter; iter++)
+        {
+            const CallICFGNode* newcs = iter->first;
+            const CallGraph::FunctionSet& functions = iter->second;
+            for (CallGraph::FunctionSet::const_iterator func_iter = functions.begin(); func_iter != functions.end(); func_iter++)
+            {
+                const SVFFunction* func = *func_iter;
+                if(queryCache)
+                    queryCache->resolveCall(queryStream, newcs, func);
+                if(sharedSVFG)
+                    _svfg->getInterVFEdgesForIndirectCallSite(newcs, func, svfgEdges);
+                else
+                    _svfg->connectCallerAndCallee(newcs, func, svfgEdges);
+            }
+        }
+    }
     /// whether load and store are aliased
     virtual bool isMustAlias(const DPIm&, const DPIm&)
     {
@@ -532,6 +756,8 @@ protected:
     }
     /// Update call graph
     virtual inline void updateCallGraphAndSVFG(const DPIm&, const CallICFGNode*, SVFGEdgeSet&) {}
+    /// Add indirect calls resolved by the traversal of a reused query
+    virtual inline void replayIndirectCalls(const CallGraph::CallEdgeMap&) {}
     //@}
 
     ///Visited flags to avoid cycles
@@ -580,7 +806,7 @@ protected:
     //@}
 
     /// Whether this is a top-level pointer statement
-    inline bool isTopLevelPtrStmt(const SVFGNode* stmt)
+    inline bool isTopLevelPtrStmt(const SVFGNode* stmt) const
     {
         return !SVFUtil::isa<StoreSVFGNode, MRSVFGNode>(stmt);
     }
@@ -788,6 +1014,12 @@ protected:
     StoreToPMSetMap storeToDPMs;	///< map store to set of DPM which have been stong updated there
     DDAStat* ddaStat;				///< DDA stat
     SVFGBuilder svfgBuilder;			///< SVFG Builder
+    ResultCache* resultCache;		///< results of completed queries shared by parallel solvers
+    DDAQueryCache* queryCache;		///< results of queries kept across runs
+    DDAQueryCache::Stream* queryStream;	///< functions visited and calls resolved by this solver
+    bool sharedSVFG;				///< whether the SVFG is owned by another solver (read-only)
+    bool inBatch;					///< whether queries are answered in a batch
+    DPTItemSet batchQueryVisited;	///< dpms visited by the current query of a batch
 };
 
 } // End namespace SVF
@@ -73,6 +73,9 @@ public:
     /// Compute points-to set for all top variable
     void computeDDAPts(NodeID id) override;
 
+    /// Compute points-to sets of top variables sharing one traversal
+    void computeDDAPtsInBatch(const NodeBS& ids) override;
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const LocDPItem& dpm);
 
@@ -136,16 +139,29 @@ public:
     {
         CallEdgeMap newEdges;
         resolveIndCalls(cs, getCachedPointsTo(dpm), newEdges);
-        for (CallEdgeMap::const_iterator iter = newEdges.begin(),eiter = newEdges.end(); iter != eiter; iter++)
+        connectIndirectCalls(newEdges, svfgEdges);
+    }
+    virtual void replayIndirectCalls(const CallEdgeMap& calls) override
+    {
+        CallEdgeMap newEdges;
+        for (CallEdgeMap::const_iterator it = calls.begin(), eit = calls.end(); it != eit; ++it)
         {
-            const CallICFGNode* newcs = iter->first;
-            const FunctionSet & functions = iter->second;
-            for (FunctionSet::const_iterator func_iter = functions.begin(); func_iter != functions.end(); func_iter++)
+            for (const SVFFunction* callee : it->second)
             {
-                const SVFFunction* func = *func_iter;
-                getSVFG()->connectCallerAndCallee(newcs, func, svfgEdges);
+                if (queryCache)
+                    queryCache->resolveCall(queryStream, it->first, callee);
+                if (getIndCallMap()[it->first].insert(callee).second)
+                {
+                    newEdges[it->first].insert(callee);
+                    getCallGraph()->addIndirectCallGraphEdge(it->first, it->first->getCaller(), callee);
+                }
             }
         }
+        if (newEdges.empty())
+            return;
+        SVFGEdgeSet svfgEdges;
+        connectIndirectCalls(newEdges, svfgEdges);
+        getCallGraphSCC()->find();
     }
     //@}
 
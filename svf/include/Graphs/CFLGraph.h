@@ -101,6 +101,21 @@ public:
         return outCFLEdges[s];
     }
 
+    /// Edges of a kind without inserting an empty set (nullptr if none), safe for concurrent readers
+    //@{
+    inline const CFLEdge::CFLEdgeSetTy* findInEdgeWithTy(GrammarBase::Symbol s) const
+    {
+        auto it = inCFLEdges.find(s);
+        return it == inCFLEdges.end() ? nullptr : &it->second;
+    }
+
+    inline const CFLEdge::CFLEdgeSetTy* findOutEdgeWithTy(GrammarBase::Symbol s) const
+    {
+        auto it = outCFLEdges.find(s);
+        return it == outCFLEdges.end() ? nullptr : &it->second;
+    }
+    //@}
+
     inline bool addInEdgeWithKind(CFLEdge* inEdge, GrammarBase::Symbol s)
     {
         assert(inEdge->getDstID() == this->getId());
@@ -158,6 +173,7 @@ public:
     typedef CFGrammar::Symbol Symbol;
     typedef CFGrammar::Kind Kind;
     typedef GenericNode<CFLNode,CFLEdge>::GEdgeSetTy CFLEdgeSet;
+    typedef Map<CFLEdge::GEdgeFlag, NodeBS> LabelToNodesMap;
     Kind startKind;
 
     CFLGraph(Kind kind)
@@ -183,8 +199,58 @@ public:
         return cflEdgeSet;
     }
 
+    /// Derived edges are kept as per-label successor bit vectors instead of CFLEdge objects
+    //@{
+    /// Add a derived edge, return false if it exists as a CFLEdge or a derived edge
+    bool addDerivedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label);
+
+    /// Whether a CFLEdge or a derived edge exists
+    bool hasEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label);
+
+    /// Destinations of the CFLEdges and derived edges of a label from src
+    void getSuccs(NodeID src, CFLEdge::GEdgeFlag label, NodeBS& succs);
+
+    /// Number of derived edges (of a label)
+    //@{
+    inline u32_t getDerivedEdgeNum() const
+    {
+        return numOfDerivedEdges;
+    }
+    u32_t getDerivedEdgeNum(CFLEdge::GEdgeFlag label) const;
+    //@}
+
+    inline const Map<NodeID, LabelToNodesMap>& getDerivedSuccs() const
+    {
+        return derivedSuccs;
+    }
+
+    /// Derived successors of src (nullptr if none), e.g., read by the threads of a parallel solver
+    inline const LabelToNodesMap* getDerivedSuccs(NodeID src) const
+    {
+        auto it = derivedSuccs.find(src);
+        return it == derivedSuccs.end() ? nullptr : &it->second;
+    }
+
+    /// Create the derived successors of every node. Threads may then add derived edges
+    /// of disjoint sets of sources by addDerivedSucc, and count them by addDerivedEdgeNum.
+    void initDerivedSuccs();
+
+    /// Add a derived edge of a node with derived successors, without checking CFLEdges or counting
+    inline bool addDerivedSucc(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+    {
+        return derivedSuccs.at(src)[label].test_and_set(dst);
+    }
+
+    inline void addDerivedEdgeNum(u32_t num)
+    {
+        numOfDerivedEdges += num;
+    }
+    //@}
+
 private:
     CFLEdgeSet cflEdgeSet;
+    Map<NodeID, LabelToNodesMap> derivedSuccs;
+    u32_t numOfDerivedEdges = 0;
 };
 
 }
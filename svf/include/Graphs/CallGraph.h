@@ -34,6 +34,7 @@
 #include "SVFIR/SVFValue.h"
 #include "Graphs/ICFG.h"
 #include <set>
+#include <mutex>
 
 namespace SVF
 {
@@ -245,6 +246,7 @@ private:
     static CallSiteToIdMap csToIdMap;	///< Map a pair of call instruction and callee to a callsite ID
     static IdToCallSiteMap idToCSMap;	///< Map a callsite ID to a pair of call instruction and callee
     static CallSiteID totalCallSiteNum;	///< CallSiteIDs, start from 1;
+    static std::mutex callSiteLock;	///< Serialize call site registration by parallel solvers
 
 protected:
     FunToCallGraphNodeMap funToCallGraphNodeMap; ///< Call Graph node map
@@ -327,8 +329,11 @@ public:
 
     /// Add/Get CallSiteID
     //@{
+    /// Call graphs of parallel DDA workers may register call sites concurrently. Lookups are not
+    /// locked: the pre-analysis registers every pair a worker can resolve before the workers start.
     inline CallSiteID addCallSite(const CallICFGNode* cs, const SVFFunction* callee)
     {
+        std::lock_guard<std::mutex> guard(callSiteLock);
         std::pair<const CallICFGNode*, const SVFFunction*> newCS(std::make_pair(cs, callee));
         CallSiteToIdMap::const_iterator it = csToIdMap.find(newCS);
         //assert(it == csToIdMap.end() && "cannot add a callsite twice");
@@ -32,6 +32,7 @@
 
 #include "Graphs/VFG.h"
 #include "Graphs/SVFGNode.h"
+#include "Graphs/SVFGBinary.h"
 
 namespace SVF
 {
@@ -95,6 +96,7 @@ public:
     typedef MemSSA::ENTRYCHI ENTRYCHI;
     typedef MemSSA::CALLCHI CALLCHI;
     typedef MemSSA::CALLMU CALLMU;
+    typedef std::vector<std::tuple<NodeID, NodeID, const NodeBS*>> IndirectVFEdgeList;
 
 protected:
     MSSAVarToDefMapTy MSSAVarToDefMap;	///< map a memory SSA operator to its definition SVFG node
@@ -105,6 +107,7 @@ protected:
     SVFGStat * stat;
     std::unique_ptr<MemSSA> mssa;
     PointerAnalysis* pta;
+    std::unique_ptr<SVFGBinaryReader> binaryReader;	///< binary SVFG file whose functions are materialized on request
 
     /// Clean up memory
     void destroy();
@@ -209,21 +212,29 @@ public:
     //@{
     inline ActualINSVFGNodeSet& getActualINSVFGNodes(const CallICFGNode* cs)
     {
+        if (binaryReader)
+            materializeFunction(cs->getFun());
         return callSiteToActualINMap[cs];
     }
 
     inline ActualOUTSVFGNodeSet& getActualOUTSVFGNodes(const CallICFGNode* cs)
     {
+        if (binaryReader)
+            materializeFunction(cs->getFun());
         return callSiteToActualOUTMap[cs];
     }
 
     inline FormalINSVFGNodeSet& getFormalINSVFGNodes(const SVFFunction* fun)
     {
+        if (binaryReader)
+            materializeFunction(fun);
         return funToFormalINMap[fun];
     }
 
     inline FormalOUTSVFGNodeSet& getFormalOUTSVFGNodes(const SVFFunction* fun)
     {
+        if (binaryReader)
+            materializeFunction(fun);
         return funToFormalOUTMap[fun];
     }
     //@}
@@ -272,6 +283,20 @@ public:
     virtual void readFile(const std::string& filename);
     virtual MRVer* getMRVERFromString(const std::string& input);
 
+    /// Write/read the memory SSA nodes and indirect edges in the binary format (see SVFGBinary.h)
+    //@{
+    void writeBinaryFile(const std::string& filename);
+    void readBinaryFile(const std::string& filename);
+    //@}
+
+    /// Add the memory SSA nodes of a function read lazily from a binary SVFG, and all edges
+    /// incident to them. The get*SVFGNodes accessors above do this on access. Node and edge
+    /// iteration does not: SVFGBuilder materializes all functions unless its client calls
+    /// this before following the edges of a function (see SVFGBuilder::setMaterializeOnDemand).
+    void materializeFunction(const SVFFunction* fun);
+    /// Add all functions not yet materialized from a binary SVFG
+    void materializeAllFunctions();
+
 protected:
     /// Add indirect def-use edges of a memory region between two statements,
     //@{
@@ -386,10 +411,26 @@ protected:
     }
     //@}
 
+    /// Add the nodes/edges of a FunRecord of the binary SVFG
+    //@{
+    void addBinarySVFGNodes(u32_t funIdx);
+    void addBinarySVFGEdges(u32_t funIdx);
+    bool checkBinaryICFGNodes(const SVFGBinaryReader& reader) const;
+    //@}
+
     /// Create SVFG nodes for address-taken variables
     void addSVFGNodesForAddrTakenVars();
     /// Connect direct SVFG edges between two SVFG nodes (value-flow of top address-taken variables)
     void connectIndirectSVFGEdges();
+
+    /// Collect the intra-procedural indirect value-flows (def, use, cpts) into a node
+    void collectIntraIndirectSVFGEdges(const SVFGNode* node, IndirectVFEdgeList& edges);
+
+    /// Connect the inter-procedural indirect value-flows into a formal-in/out node
+    void connectInterIndirectSVFGEdges(const SVFGNode* node);
+
+    /// Connect intra-procedural indirect value-flows of each function with numThreads workers
+    void connectIntraIndirectSVFGEdgesInParallel(u32_t numThreads);
     /// Connect indirect SVFG edges from global initializers (store) to main function entry
     void connectFromGlobalToProgEntry();
 
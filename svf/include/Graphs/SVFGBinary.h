@@ -0,0 +1,270 @@
+//===- SVFGBinary.h -- Binary format of SVFG----------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SVFGBinary.h
+ *
+ * Versioned binary format of the address-taken part of an SVFG
+ * (memory SSA nodes and indirect value-flow edges).
+ *
+ * A file is a Header, followed by a table of Section descriptors, followed by
+ * the sections. Every section is a flat array of one of the record types below
+ * and starts at an 8-byte aligned offset, so a file can be mmapped and used in
+ * place. Records refer to each other by their index in the owning section.
+ */
+
+#ifndef SVFGBINARY_H_
+#define SVFGBINARY_H_
+
+#include "MSSA/MemSSA.h"
+
+namespace SVF
+{
+
+namespace SVFGBinary
+{
+
+/// Bump this whenever a record or the header changes
+static const u32_t Version = 1;
+static const char Magic[8] = {'S', 'V', 'F', 'G', 'B', 'I', 'N', '\0'};
+/// Index of a missing record (e.g., the function of global nodes)
+static const u32_t Invalid = ~0U;
+
+enum SectionKind
+{
+    PtsIndex,       ///< PtsRecord: one points-to set
+    PtsData,        ///< u32_t: objects of all points-to sets
+    MRTable,        ///< MRRecord: one memory region
+    MRVerTable,     ///< MRVerRecord: one memory region version
+    NodeTable,      ///< NodeRecord: one memory SSA node, grouped by function
+    PhiOpTable,     ///< PhiOpRecord: one operand of a memory SSA phi
+    EdgeTable,      ///< EdgeRecord: one indirect value-flow edge
+    FunTable,       ///< FunRecord: nodes and edges of one function
+    FunEdgeTable,   ///< u32_t: edges incident to the nodes of a function
+    NumSections
+};
+
+struct Header
+{
+    char magic[8];
+    u32_t version;
+    u32_t numSections;
+    u32_t totalNodeNum;     ///< (S)VFG node IDs in the file are below this
+    u32_t reserved;
+};
+
+struct Section
+{
+    u32_t kind;
+    u32_t reserved;
+    u64_t offset;           ///< from the beginning of the file
+    u64_t num;              ///< number of records
+};
+
+struct PtsRecord
+{
+    u32_t begin;            ///< first object in PtsData
+    u32_t num;
+};
+
+struct MRRecord
+{
+    u32_t pts;
+};
+
+struct MRVerRecord
+{
+    u32_t mr;
+    u32_t version;
+    u32_t defType;          ///< MSSADEF::DEFTYPE
+};
+
+struct NodeRecord
+{
+    u32_t id;
+    u32_t kind;             ///< VFGNode::VFGNodeK
+    u32_t icfgNode;
+    u32_t mrVer;            ///< result (chi/phi) or operand (mu) version
+    u32_t opBegin;          ///< first phi operand in PhiOpTable
+    u32_t opNum;
+};
+
+struct PhiOpRecord
+{
+    u32_t pos;
+    u32_t mrVer;
+};
+
+struct EdgeRecord
+{
+    u32_t src;
+    u32_t dst;
+    u32_t kind;             ///< VFGEdge::VFGEdgeK
+    u32_t pts;
+    u32_t csId;             ///< call site ID of call/ret edges
+};
+
+struct FunRecord
+{
+    u32_t entry;            ///< ID of the FunEntryICFGNode, Invalid for globals
+    u32_t nodeBegin;
+    u32_t nodeNum;
+    u32_t edgeBegin;        ///< first edge index in FunEdgeTable
+    u32_t edgeNum;
+};
+
+} // End namespace SVFGBinary
+
+/*!
+ * A binary SVFG file mapped into memory.
+ * Memory regions and their versions are only created when a node or an edge
+ * refers to them, and are owned by the reader.
+ */
+class SVFGBinaryReader
+{
+public:
+    SVFGBinaryReader() = default;
+    SVFGBinaryReader(const SVFGBinaryReader&) = delete;
+    SVFGBinaryReader& operator=(const SVFGBinaryReader&) = delete;
+
+    ~SVFGBinaryReader();
+
+    /// Whether a file starts with the magic of the binary format
+    static bool isBinaryFile(const std::string& filename);
+
+    /// Map a file into memory and check its header, sections and the indices of its records
+    bool open(const std::string& filename);
+
+    inline const SVFGBinary::Header* getHeader() const
+    {
+        return header;
+    }
+
+    /// Records of a section
+    //@{
+    template <typename T>
+    inline const T* getRecords(SVFGBinary::SectionKind kind) const
+    {
+        return reinterpret_cast<const T*>(base + sections[kind].offset);
+    }
+    inline u64_t getRecordNum(SVFGBinary::SectionKind kind) const
+    {
+        return sections[kind].num;
+    }
+    //@}
+
+    /// Points-to set of a PtsRecord
+    NodeBS getPts(u32_t idx) const;
+
+    /// Memory region version of a MRVerRecord
+    const MRVer* getMRVer(u32_t idx);
+
+    /// Whether the nodes and edges of a function (FunRecord index) have been added
+    //@{
+    inline bool isFunLoaded(u32_t idx) const
+    {
+        return funLoaded[idx];
+    }
+    inline void setFunLoaded(u32_t idx)
+    {
+        funLoaded[idx] = true;
+        ++numLoadedFuns;
+    }
+    inline u32_t getNumLoadedFuns() const
+    {
+        return numLoadedFuns;
+    }
+    //@}
+
+    /// Whether all edges of a function have been added, i.e., it and the functions
+    /// at the other end of its edges have been loaded
+    //@{
+    inline bool isFunComplete(u32_t idx) const
+    {
+        return numLoadedFuns == funLoaded.size() || funComplete[idx];
+    }
+    inline void setFunComplete(u32_t idx)
+    {
+        funComplete[idx] = true;
+    }
+    //@}
+
+    /// FunRecord index of the function of a node in the file
+    inline u32_t getNodeFunRecord(NodeID id) const
+    {
+        Map<NodeID, u32_t>::const_iterator it = nodeToFunRecord.find(id);
+        return it == nodeToFunRecord.end() ? SVFGBinary::Invalid : it->second;
+    }
+
+    /// FunRecord index of a function
+    //@{
+    inline void setFunRecord(const SVFFunction* fun, u32_t idx)
+    {
+        funToRecord[fun] = idx;
+    }
+    inline u32_t getFunRecord(const SVFFunction* fun) const
+    {
+        Map<const SVFFunction*, u32_t>::const_iterator it = funToRecord.find(fun);
+        return it == funToRecord.end() ? SVFGBinary::Invalid : it->second;
+    }
+    //@}
+
+    /// Whether an edge (EdgeRecord index) has been added
+    //@{
+    inline bool isEdgeLoaded(u32_t idx) const
+    {
+        return edgeLoaded[idx];
+    }
+    inline void setEdgeLoaded(u32_t idx)
+    {
+        edgeLoaded[idx] = true;
+    }
+    //@}
+
+private:
+    /// Whether every index refers to an existing record
+    bool checkRecords() const;
+    /// Whether records [begin, begin + num) are in a section
+    inline bool inSection(SVFGBinary::SectionKind kind, u64_t begin, u64_t num) const
+    {
+        return begin <= sections[kind].num && num <= sections[kind].num - begin;
+    }
+
+    const char* base = nullptr;
+    u64_t size = 0;
+    const SVFGBinary::Header* header = nullptr;
+    SVFGBinary::Section sections[SVFGBinary::NumSections] = {};
+
+    std::vector<MemRegion*> mrs;
+    std::vector<MRVer*> mrVers;
+    std::vector<MSSADEF*> defs;
+    Map<const SVFFunction*, u32_t> funToRecord;
+    std::vector<bool> funLoaded;
+    std::vector<bool> funComplete;
+    Map<NodeID, u32_t> nodeToFunRecord;
+    std::vector<bool> edgeLoaded;
+    u32_t numLoadedFuns = 0;
+};
+
+} // End namespace SVF
+
+#endif /* SVFGBINARY_H_ */
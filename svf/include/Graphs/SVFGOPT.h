@@ -39,6 +39,7 @@
 
 #include "Graphs/SVFG.h"
 #include "Util/WorkList.h"
+#include <atomic>
 
 namespace SVF
 {
@@ -58,10 +59,30 @@ class SVFGOPT : public SVFG
     typedef Set<SVFGNode*> SVFGNodeSet;
     typedef Map<NodeID, NodeID> NodeIDToNodeIDMap;
     typedef FIFOWorkList<const MSSAPHISVFGNode*> WorkList;
+    typedef Set<const SVFGNode*> ConstSVFGNodeSet;
+
+    /// Def-site of an actual-in/formal-out and the points-to sets of the edges
+    /// from the def-site to the successors of the actual-in/formal-out.
+    struct AInFOutRetarget
+    {
+        NodeID def = 0;
+        std::vector<std::pair<const IndirectSVFGEdge*, NodeBS>> outEdges;
+    };
+    typedef Map<NodeID, AInFOutRetarget> AInFOutRetargetMap;
+
+    /// MSSAPHI nodes which may be removed.
+    /// When localPHIs is set (parallel mode), only phis in it are pushed and
+    /// removed phis are kept in deadPHIs until the workers join.
+    struct MSSAPHIWorkList
+    {
+        WorkList phis;
+        const ConstSVFGNodeSet* localPHIs = nullptr;
+        std::vector<const MSSAPHISVFGNode*> deadPHIs;
+    };
 
 public:
     /// Constructor
-    SVFGOPT(std::unique_ptr<MemSSA> mssa, VFGK kind) : SVFG(std::move(mssa), kind)
+    SVFGOPT(std::unique_ptr<MemSSA> mssa, VFGK kind) : SVFG(std::move(mssa), kind), numOfRemovedNodes(0), numOfRemovedEdges(0)
     {
         keepAllSelfCycle = keepContextSelfCycle = keepActualOutFormalIn = false;
     }
@@ -181,6 +202,9 @@ private:
     ///    will not be used when updating call graph.
     void handleInterValueFlow();
 
+    /// Compute the retargeted edges of actual-in/formal-out nodes function by function in parallel
+    void collectRetargetedEdgesInParallel(const SVFGNodeSet& candidates, AInFOutRetargetMap& retargets, u32_t numThreads);
+
     /// Replace FormalParam/ActualRet node with PHI node.
     //@{
     void replaceFParamARetWithPHI(PHISVFGNode* phi, SVFGNode* svfgNode);
@@ -191,6 +215,8 @@ private:
     /// Record def sites of actual-in/formal-out and connect from those def-sites
     /// to formal-in/actual-out directly if they exist.
     void retargetEdgesOfAInFOut(SVFGNode* node);
+    void collectRetargetedEdgesOfAInFOut(const SVFGNode* node, AInFOutRetarget& retarget) const;
+    void applyRetargetedEdgesOfAInFOut(SVFGNode* node, const AInFOutRetarget& retarget);
     /// Connect actual-out/formal-in's predecessors to their successors directly.
     void retargetEdgesOfAOutFIn(SVFGNode* node);
     //@}
@@ -198,32 +224,46 @@ private:
     /// Remove MSSAPHI SVFG nodes.
     void handleIntraValueFlow();
 
+    /// Remove MSSAPHI nodes whose value-flows stay inside their function, function by function in parallel
+    void removeLocalMSSAPHINodesInParallel(u32_t numThreads);
+
     /// Initial work list with MSSAPHI nodes which may be removed.
     inline void initialWorkList()
     {
         for (SVFG::const_iterator it = begin(), eit = end(); it != eit; ++it)
-            addIntoWorklist(it->second);
+            addIntoWorklist(it->second, worklist);
     }
 
     /// Only MSSAPHI node which satisfy following conditions will be removed:
     /// 1. it's not def-site of actual-in/formal-out;
     /// 2. it doesn't have incoming and outgoing call/ret at the same time.
-    inline bool addIntoWorklist(const SVFGNode* node)
+    inline bool addIntoWorklist(const SVFGNode* node, MSSAPHIWorkList& wl)
     {
-        if (const MSSAPHISVFGNode* phi = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        if (wl.localPHIs != nullptr)
+        {
+            if (wl.localPHIs->find(node) != wl.localPHIs->end())
+                return wl.phis.push(SVFUtil::cast<MSSAPHISVFGNode>(node));
+        }
+        else if (const MSSAPHISVFGNode* phi = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
         {
             if (isConnectingTwoCallSites(phi) == false && isDefOfAInFOut(phi) == false)
-                return worklist.push(phi);
+                return wl.phis.push(phi);
         }
         return false;
     }
 
+    /// Remove or bypass a MSSAPHI node popped from the work list
+    void handleMSSAPHINode(const MSSAPHISVFGNode* node, MSSAPHIWorkList& wl);
+
     /// Remove MSSAPHI node if possible
-    void bypassMSSAPHINode(const MSSAPHISVFGNode* node);
+    void bypassMSSAPHINode(const MSSAPHISVFGNode* node, MSSAPHIWorkList& wl);
 
     /// Remove self cycle edges if needed. Return TRUE if some self cycle edges remained.
     bool checkSelfCycleEdges(const MSSAPHISVFGNode* node);
 
+    /// Return TRUE if all value-flows of a MSSAPHI node are intra-procedural within its function
+    bool isLocalMSSAPHINode(const MSSAPHISVFGNode* node) const;
+
     /// Add new SVFG edge from src to dst.
     bool addNewSVFGEdge(NodeID srcId, NodeID dstId, const SVFGEdge* preEdge, const SVFGEdge* succEdge);
 
@@ -335,11 +375,13 @@ private:
     inline void removeInEdges(const SVFGNode* node)
     {
         /// remove incoming edges
+        numOfRemovedEdges += node->getInEdges().size();
         while (node->hasIncomingEdge())
             removeSVFGEdge(*(node->InEdgeBegin()));
     }
     inline void removeOutEdges(const SVFGNode* node)
     {
+        numOfRemovedEdges += node->getOutEdges().size();
         while (node->hasOutgoingEdge())
             removeSVFGEdge(*(node->OutEdgeBegin()));
     }
@@ -350,7 +392,10 @@ private:
     NodeIDToNodeIDMap formalOutToDefMap;	///< map formal-out to its def-site node
     NodeBS defNodes;	///< preserved def nodes of formal-in/actual-out
 
-    WorkList worklist;	///< storing MSSAPHI nodes which may be removed.
+    MSSAPHIWorkList worklist;	///< storing MSSAPHI nodes which may be removed.
+
+    u32_t numOfRemovedNodes;	///< nodes removed by optimisation
+    std::atomic<u32_t> numOfRemovedEdges;	///< edges removed by optimisation (including retargeted ones)
 
     bool keepActualOutFormalIn;
     bool keepAllSelfCycle;
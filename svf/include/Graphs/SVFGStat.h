@@ -54,6 +54,7 @@ public:
     static const char* TimeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static const char* TimeOfInsertingPHI;	///< Time for inserting phis
     static const char* TimeOfSSARenaming;	///< Time for SSA rename
+    static const char* TimeOfMaxSCCModRef;	///< Time of mod-ref analysis of the slowest call graph SCC
 
     static const char* NumOfMaxRegion;	///< Number of max points-to set in region.
     static const char* NumOfAveragePtsInRegion;	///< Number of average points-to set in region.
@@ -73,6 +74,8 @@ public:
     static const char* NumOfLoadHasMu;	///< Number of loads which have mu
     static const char* NumOfStoreHasChi;	///< Number of stores which have chi
     static const char* NumOfBBHasMSSAPhi;	///< Number of basic blocks which have mssa phi
+    static const char* NumOfModRefSCC;	///< Number of call graph SCCs in mod-ref analysis
+    static const char* NumOfMaxModRefSCC;	///< Number of functions in the slowest call graph SCC
 
     MemSSAStat(MemSSA*);
 
@@ -84,6 +87,9 @@ public:
 
     virtual void printStat(std::string str = "") override;
 
+    /// Print the call graph SCCs which take the most time in mod-ref analysis
+    void printHotModRefSCCs(u32_t num = 10);
+
 private:
     MemSSA* mssa;
 };
@@ -156,6 +162,47 @@ public:
         svfgOptTimeEnd = PTAStat::getClk(true);
     }
 
+    /// Phases of SVFG optimisation: inter-procedural value-flows, MSSAPHIs
+    /// (per function in parallel mode) and the remaining MSSAPHIs after merge
+    //@{
+    void svfgOptInterStart()
+    {
+        svfgOptInterTimeStart = PTAStat::getClk(true);
+    }
+
+    void svfgOptInterEnd()
+    {
+        svfgOptInterTimeEnd = PTAStat::getClk(true);
+    }
+
+    void svfgOptIntraStart()
+    {
+        svfgOptIntraTimeStart = PTAStat::getClk(true);
+    }
+
+    void svfgOptIntraEnd()
+    {
+        svfgOptIntraTimeEnd = PTAStat::getClk(true);
+    }
+
+    void svfgOptMergeStart()
+    {
+        svfgOptMergeTimeStart = PTAStat::getClk(true);
+    }
+
+    void svfgOptMergeEnd()
+    {
+        svfgOptMergeTimeEnd = PTAStat::getClk(true);
+    }
+    //@}
+
+    /// Nodes and edges eliminated by SVFG optimisation
+    void setSVFGOptRemovedNum(u32_t nodes, u32_t edges)
+    {
+        numOfOptRemovedNodes = nodes;
+        numOfOptRemovedEdges = edges;
+    }
+
 private:
     void clear();
 
@@ -228,6 +275,16 @@ private:
     double svfgOptTimeStart;
     double svfgOptTimeEnd;
 
+    double svfgOptInterTimeStart;
+    double svfgOptInterTimeEnd;
+    double svfgOptIntraTimeStart;
+    double svfgOptIntraTimeEnd;
+    double svfgOptMergeTimeStart;
+    double svfgOptMergeTimeEnd;
+
+    u32_t numOfOptRemovedNodes;	///< number of nodes removed by SVFG optimisation
+    u32_t numOfOptRemovedEdges;	///< number of edges removed by SVFG optimisation
+
     SVFGNodeSet forwardSlice;
     SVFGNodeSet backwardSlice;
     SVFGNodeSet	sources;
@@ -36,6 +36,8 @@
 #include "Graphs/VFGNode.h"
 #include "Graphs/VFGEdge.h"
 
+#include <functional>
+
 namespace SVF
 {
 
@@ -82,6 +84,7 @@ public:
     typedef SVFIR::SVFStmtSet SVFStmtSet;
     typedef Set<const VFGNode*> GlobalVFGNodeSet;
     typedef Set<const PAGNode*> PAGNodeSet;
+    typedef std::vector<std::pair<NodeID, NodeID>> NodeIDPairList;
 
 
 protected:
@@ -452,6 +455,21 @@ protected:
     /// Create edges between VFG nodes within a function
     void connectDirectVFGEdges();
 
+    /// Collect the (def, use) node pairs of the intra-procedural direct value-flows into a node
+    void collectIntraDirectVFGEdges(const VFGNode* node, NodeIDPairList& edges) const;
+
+    /// Connect the inter-procedural direct value-flows into a formal parameter/return node
+    void connectInterDirectVFGEdges(VFGNode* node);
+
+    /// Connect intra-procedural direct value-flows of each function with numThreads workers
+    void connectIntraDirectVFGEdgesInParallel(u32_t numThreads);
+
+    /// Group node IDs by their functions (in ID order), nodes outside functions are grouped last
+    void getNodeGroupsOfFunctions(std::vector<const SVFFunction*>& funs, std::vector<std::vector<NodeID>>& groups) const;
+
+    /// Run task(0), ..., task(numTasks-1) with numThreads workers
+    static void parallelForEach(u32_t numTasks, u32_t numThreads, const std::function<void(u32_t)>& task);
+
     /// Create edges between VFG nodes across functions
     void addVFGInterEdges(const CallICFGNode* cs, const SVFFunction* callee);
 
@@ -108,8 +108,9 @@ protected:
     /// Create disjoint memory region
     void createDisjointMR(const SVFFunction* func, const NodeBS& cpts);
 
-    /// Compute intersections between cpts and computed cpts intersections before.
-    void computeIntersections(const NodeBS& cpts, PointsToList& inters);
+    /// Compute all disjoint intersections of cptsList at once by grouping
+    /// objects with the same signature (the set of cpts containing them).
+    void computeDisjointPartition(const std::vector<const NodeBS*>& cptsList, PointsToList& inters);
 
 private:
     inline PtsToSubPtsMap& getPtsSubSetMap(const SVFFunction* func)
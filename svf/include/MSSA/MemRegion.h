@@ -41,6 +41,7 @@
 #include "Util/WorkList.h"
 
 #include <set>
+#include <mutex>
 
 namespace SVF
 {
@@ -172,6 +173,9 @@ public:
 
     typedef Map<NodeID, NodeBS> NodeToPTSSMap;
 
+    /// Map a call graph SCC (rep node) to the time spent on its mod-ref analysis
+    typedef Map<NodeID, double> SCCToTimeMap;
+
     /// SVFIR edge list
     typedef SVFIR::SVFStmtList SVFStmtList;
     /// Call Graph SCC
@@ -242,6 +246,11 @@ private:
     /// All global variable SVFIR node ids
     NodeBS allGlobals;
 
+    /// Time of mod-ref analysis of each call graph SCC
+    SCCToTimeMap sccModRefTimeMap;
+    /// Guard insertions into csToRefsMap/csToModsMap under the parallel scheduler
+    std::mutex csSideEffectMutex;
+
     /// Clean up memory
     void destroy();
 
@@ -271,6 +280,12 @@ private:
     /// Get reverse topo call graph scc
     void getCallGraphSCCRevTopoOrder(WorkList& worklist);
 
+    /// Bottom-up mod-ref analysis, scheduling each call graph SCC once all its callee SCCs are done
+    void parallelModRefAnalysis(u32_t numThreads);
+
+    /// Mod-Ref analysis of callsites inside a call graph SCC, pulling mod-ref from their callees
+    void modRefAnalysisOfSCC(NodeID rep);
+
 protected:
     MRGenerator(BVDataPTAImpl* p, bool ptrOnly);
 
@@ -431,6 +446,18 @@ public:
     /// Start generating memory regions
     virtual void generateMRs();
 
+    /// Call graph SCCs and the time spent on each of them during mod-ref analysis
+    //@{
+    inline const SCC* getCallGraphSCC() const
+    {
+        return callGraphSCC;
+    }
+    inline const SCCToTimeMap& getSCCModRefTimeMap() const
+    {
+        return sccModRefTimeMap;
+    }
+    //@}
+
     /// Get the function which SVFIR Edge located
     const SVFFunction* getFunction(const PAGEdge* pagEdge) const
     {
@@ -49,7 +49,7 @@ public:
     typedef SVFG::SVFGEdgeSetTy SVFGEdgeSet;
 
     /// Constructor
-    explicit SVFGBuilder(bool _SVFGWithIndCall = false): svfg(nullptr), SVFGWithIndCall(_SVFGWithIndCall) {}
+    explicit SVFGBuilder(bool _SVFGWithIndCall = false): svfg(nullptr), SVFGWithIndCall(_SVFGWithIndCall), materializeOnDemand(false) {}
 
     /// Destructor
     virtual ~SVFGBuilder() = default;
@@ -75,6 +75,13 @@ public:
         return vfEdgesAtIndCallSite.find(const_cast<SVFGEdge*>(edge))!=vfEdgesAtIndCallSite.end();
     }
 
+    /// Leave the functions of a lazily read binary SVFG (-svfg-lazy-load) to the client,
+    /// which calls SVFG::materializeFunction before following the edges of a function
+    inline void setMaterializeOnDemand(bool onDemand)
+    {
+        materializeOnDemand = onDemand;
+    }
+
     /// Build Memory SSA
     virtual std::unique_ptr<MemSSA> buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA);
 
@@ -91,6 +98,8 @@ protected:
     std::unique_ptr<SVFG> svfg;
     /// SVFG with precomputed indirect call edges
     bool SVFGWithIndCall;
+    /// Whether the client materializes the functions of a lazily read SVFG
+    bool materializeOnDemand;
 };
 
 } // End namespace SVF
@@ -232,6 +232,13 @@ public:
     /// Compute points-to results on-demand, overridden by derived classes
     virtual void computeDDAPts(NodeID) {}
 
+    /// Compute points-to results of a batch of pointers on-demand
+    virtual void computeDDAPtsInBatch(const NodeBS& ids)
+    {
+        for (NodeID id : ids)
+            computeDDAPts(id);
+    }
+
     /// Interface exposed to users of our pointer analysis, given Value infos
     virtual AliasResult alias(const SVFValue* V1,
                               const SVFValue* V2) = 0;
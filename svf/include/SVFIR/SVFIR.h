@@ -31,6 +31,7 @@
 #define INCLUDE_SVFIR_H_
 
 #include "Graphs/IRGraph.h"
+#include <mutex>
 
 namespace SVF
 {
@@ -82,6 +83,7 @@ private:
     GepValueVarMap GepValObjMap;	///< Map a pair<base,off> to a gep value node id
     TypeLocSetsMap typeLocSetsMap;	///< Map an arg to its base SVFType* and all its field location sets
     NodeOffsetMap GepObjVarMap;	///< Map a pair<base,off> to a gep obj node id
+    std::mutex gepObjVarLock;	///< Serialize the lazy creation of gep obj nodes by parallel solvers
     MemObjToFieldsMap memToFieldsMap;	///< Map a mem object id to all its fields
     SVFStmtSet globSVFStmtSet;	///< Global PAGEdges without control flow information
     PHINodeMap phiNodeMap;	///< A set of phi copy edges
@@ -45,7 +45,8 @@ class DPItem
 {
 protected:
     NodeID cur;
-    static u64_t maximumBudget;
+    /// per thread, as DDA solvers of different kinds may answer queries in parallel
+    static thread_local u64_t maximumBudget;
 
 public:
     /// Constructor
@@ -79,6 +79,7 @@ public:
 
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
+    static const Option<u32_t> CxtBudgetScale;
 
     // DDAPass.cpp
     static const Option<u32_t> MaxPathLen;
@@ -91,6 +92,12 @@ public:
     static const Option<bool> PrintQueryPts;
     static const Option<bool> WPANum;
     static OptionMultiple<PointerAnalysis::PTATY> DDASelected;
+    /// Number of threads answering DDA queries.
+    static const Option<u32_t> DDAThreads;
+    /// File keeping DDA query results across runs.
+    static const Option<std::string> DDAQueryCacheFile;
+    /// Maximum number of queries of a function answered in one batch.
+    static const Option<u32_t> DDABatchSize;
 
     // FlowDDA.cpp
     static const Option<u32_t> FlowBudget;
@@ -137,6 +144,7 @@ public:
 
     // Memory region (MemRegion.cpp)
     static const Option<bool> IgnoreDeadFun;
+    static const Option<u32_t> ModRefThreads;
 
     // Base class of pointer analyses (MemSSA.cpp)
     static const Option<bool> DumpMSSA;
@@ -147,9 +155,12 @@ public:
     // SVFG builder (SVFGBuilder.cpp)
     static const Option<bool> SVFGWithIndirectCall;
     static Option<bool> OPTSVFG;
+    static const Option<u32_t> SVFGThreads;
 
     static const Option<std::string> WriteSVFG;
     static const Option<std::string> ReadSVFG;
+    static const Option<bool> SVFGBinary;
+    static const Option<bool> SVFGLazyLoad;
 
     // LockAnalysis.cpp
     static const Option<bool> IntraLock;
@@ -236,6 +247,11 @@ public:
     static const Option<bool>  CFLSVFG;
     static const Option<bool> POCRAlias;
     static const Option<bool> POCRHybrid;
+    static const Option<u32_t> CFLThreads;
+    static const Option<bool> CFLMatrix;
+    static const Option<std::string> CFLSolvedFile;
+    static const Option<bool> CFLSummary;
+    static const Option<std::string> CFLSummaryFile;
     static const Option<bool> Customized;
 
     // Loop Analysis
@@ -244,6 +260,20 @@ public:
 
     // Abstract Execution
     static const Option<u32_t> WidenDelay;
+    /// reuse callee summaries instead of re-analysing callees at every call site, Default: false
+    static const Option<bool> AESummary;
+    /// maximum number of summaries kept per callee (0: no limit), the oldest is dropped first, Default: 16
+    static const Option<u32_t> AESummaryLimit;
+    /// keep top-level variables out of the abstract states of ICFG nodes, Default: false
+    static const Option<bool> AESharedTopLevel;
+    /// number of threads analysing the entry functions in parallel, Default: 1
+    static const Option<u32_t> AEThreads;
+    /// widen loop heads to the constants compared in the function before infinity, Default: false
+    static const Option<bool> AEWidenThresholds;
+    /// iterate loops with a trip count up to this bound without widening, Default: 0 (off)
+    static const Option<u32_t> AEExactLoopIter;
+    /// cache file of the function summaries reused by the next run, Default: "" (off)
+    static const Option<std::string> AEIncremental;
     /// the max time consumptions (seconds). Default: 4 hours 14400s
     static const Option<u32_t> Timeout;
     /// bug info output file, Default: output.db
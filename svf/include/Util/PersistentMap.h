@@ -0,0 +1,652 @@
+//===- PersistentMap.h -- Persistent map with structural sharing-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PersistentMap.h
+ *
+ * A map from u32_t keys (e.g., node IDs) to values, implemented as a hash array
+ * mapped trie consuming 5 bits of the key per level. Nodes and entries are reference
+ * counted and shared between copies, a copy takes O(1) and an update copies the
+ * path from the root to the updated entry (copy-on-write).
+ *
+ * The trie is canonical: an entry sits at the shallowest level where no other key
+ * shares its bits, so two maps with the same keys have the same shape. Merging
+ * and comparing maps skip the subtrees they share.
+ */
+
+#ifndef PERSISTENTMAP_H_
+#define PERSISTENTMAP_H_
+
+#include "Util/GeneralType.h"
+#include <atomic>
+#include <iterator>
+
+namespace SVF
+{
+
+template <typename V>
+class PersistentMap
+{
+public:
+    typedef u32_t key_type;
+    typedef V mapped_type;
+    typedef std::pair<const u32_t, V> value_type;
+
+private:
+    static const u32_t Bits = 5;
+    static const u32_t Mask = (1U << Bits) - 1;
+    static const u32_t MaxDepth = (32 + Bits - 1) / Bits;
+
+    struct Leaf
+    {
+        std::atomic<u32_t> refs;
+        value_type kv;
+
+        Leaf(const value_type& v) : refs(1), kv(v) {}
+        Leaf(u32_t key, const V& v) : refs(1), kv(key, v) {}
+    };
+
+    struct Node;
+
+    struct Slot
+    {
+        void* ptr;
+        bool isLeaf;
+
+        inline Leaf* leaf() const
+        {
+            return static_cast<Leaf*>(ptr);
+        }
+        inline Node* node() const
+        {
+            return static_cast<Node*>(ptr);
+        }
+    };
+
+    struct Node
+    {
+        std::atomic<u32_t> refs;
+        u32_t bitmap;               ///< occupied slots
+        u32_t leafmap;              ///< occupied slots holding a Leaf
+        u32_t size;                 ///< number of entries in the subtree
+        std::vector<Slot> slots;    ///< one per bit of bitmap, in order
+
+        Node() : refs(1), bitmap(0), leafmap(0), size(0) {}
+
+        Node(const Node& n) : refs(1), bitmap(n.bitmap), leafmap(n.leafmap), size(n.size), slots(n.slots)
+        {
+            for (const Slot& s : slots)
+                retain(s);
+        }
+
+        ~Node()
+        {
+            for (const Slot& s : slots)
+                release(s);
+        }
+
+        inline u32_t pos(u32_t idx) const
+        {
+            return __builtin_popcount(bitmap & ((1U << idx) - 1));
+        }
+
+        inline void insert(u32_t idx, const Slot& s)
+        {
+            u32_t bit = 1U << idx;
+            slots.insert(slots.begin() + pos(idx), s);
+            bitmap |= bit;
+            if (s.isLeaf)
+                leafmap |= bit;
+        }
+    };
+
+    static inline u32_t index(u32_t key, u32_t shift)
+    {
+        return (key >> shift) & Mask;
+    }
+
+    static inline void retain(const Slot& s)
+    {
+        if (s.isLeaf)
+            s.leaf()->refs.fetch_add(1, std::memory_order_relaxed);
+        else
+            s.node()->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static inline void release(const Slot& s)
+    {
+        if (s.isLeaf)
+        {
+            if (s.leaf()->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete s.leaf();
+        }
+        else if (s.node()->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete s.node();
+    }
+
+    /// Copy a shared node or entry before updating it
+    //@{
+    static inline void makeUnique(Node*& n)
+    {
+        if (n->refs.load(std::memory_order_acquire) > 1)
+        {
+            Node* copy = new Node(*n);
+            release({n, false});
+            n = copy;
+        }
+    }
+    static inline void makeUnique(Slot& s)
+    {
+        if (s.isLeaf)
+        {
+            if (s.leaf()->refs.load(std::memory_order_acquire) > 1)
+            {
+                Leaf* copy = new Leaf(s.leaf()->kv);
+                release(s);
+                s.ptr = copy;
+            }
+        }
+        else
+        {
+            Node* n = s.node();
+            makeUnique(n);
+            s.ptr = n;
+        }
+    }
+    //@}
+
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename PersistentMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator() : depth(0), cur(nullptr) {}
+
+        inline reference operator*() const
+        {
+            return *cur;
+        }
+        inline pointer operator->() const
+        {
+            return cur;
+        }
+        inline const_iterator& operator++()
+        {
+            stack[depth - 1].slot++;
+            settle();
+            return *this;
+        }
+        inline const_iterator operator++(int)
+        {
+            const_iterator it = *this;
+            ++*this;
+            return it;
+        }
+        inline bool operator==(const const_iterator& rhs) const
+        {
+            return cur == rhs.cur;
+        }
+        inline bool operator!=(const const_iterator& rhs) const
+        {
+            return cur != rhs.cur;
+        }
+
+    private:
+        friend class PersistentMap;
+
+        struct Frame
+        {
+            const Node* node;
+            u32_t slot;
+        };
+
+        explicit const_iterator(const Node* root) : depth(0), cur(nullptr)
+        {
+            if (root != nullptr && root->size > 0)
+            {
+                stack[depth++] = {root, 0};
+                settle();
+            }
+        }
+
+        /// Move to the first entry at or after the current slot
+        void settle()
+        {
+            while (depth > 0)
+            {
+                Frame& f = stack[depth - 1];
+                if (f.slot >= f.node->slots.size())
+                {
+                    if (--depth > 0)
+                        stack[depth - 1].slot++;
+                    continue;
+                }
+                const Slot& s = f.node->slots[f.slot];
+                if (s.isLeaf)
+                {
+                    cur = &s.leaf()->kv;
+                    return;
+                }
+                stack[depth++] = {s.node(), 0};
+            }
+            cur = nullptr;
+        }
+
+        Frame stack[MaxDepth + 1];
+        u32_t depth;
+        const value_type* cur;
+    };
+    typedef const_iterator iterator;
+
+    PersistentMap() : root(nullptr) {}
+
+    PersistentMap(std::initializer_list<value_type> entries) : root(nullptr)
+    {
+        for (const value_type& kv : entries)
+            (*this)[kv.first] = kv.second;
+    }
+
+    /// O(1), the copies share all nodes
+    PersistentMap(const PersistentMap& rhs) : root(rhs.root)
+    {
+        if (root)
+            retain({root, false});
+    }
+
+    PersistentMap(PersistentMap&& rhs) noexcept : root(rhs.root)
+    {
+        rhs.root = nullptr;
+    }
+
+    PersistentMap& operator=(const PersistentMap& rhs)
+    {
+        if (root != rhs.root)
+        {
+            if (rhs.root)
+                retain({rhs.root, false});
+            clear();
+            root = rhs.root;
+        }
+        return *this;
+    }
+
+    PersistentMap& operator=(PersistentMap&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            clear();
+            root = rhs.root;
+            rhs.root = nullptr;
+        }
+        return *this;
+    }
+
+    ~PersistentMap()
+    {
+        clear();
+    }
+
+    inline u32_t size() const
+    {
+        return root ? root->size : 0;
+    }
+
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+
+    inline void clear()
+    {
+        if (root)
+            release({root, false});
+        root = nullptr;
+    }
+
+    inline const_iterator begin() const
+    {
+        return const_iterator(root);
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    const_iterator find(u32_t key) const
+    {
+        const_iterator it;
+        const Node* n = root;
+        for (u32_t shift = 0; n != nullptr; shift += Bits)
+        {
+            u32_t idx = index(key, shift);
+            if (!(n->bitmap & (1U << idx)))
+                break;
+            u32_t p = n->pos(idx);
+            it.stack[it.depth++] = {n, p};
+            const Slot& s = n->slots[p];
+            if (s.isLeaf)
+            {
+                if (s.leaf()->kv.first == key)
+                    it.cur = &s.leaf()->kv;
+                break;
+            }
+            n = s.node();
+        }
+        if (it.cur == nullptr)
+            it.depth = 0;
+        return it;
+    }
+
+    inline u32_t count(u32_t key) const
+    {
+        return find(key) != end();
+    }
+
+    inline const V& at(u32_t key) const
+    {
+        const_iterator it = find(key);
+        assert(it != end() && "key not in the map?");
+        return it->second;
+    }
+
+    /// The entry of key, inserted if missing, after copying its shared path.
+    /// The reference is only valid until the map is copied or updated.
+    V& operator[](u32_t key)
+    {
+        if (root == nullptr)
+            root = new Node();
+        else
+            makeUnique(root);
+
+        Node* path[MaxDepth + 1];
+        u32_t depth = 0;
+        Node* n = root;
+        for (u32_t shift = 0;; shift += Bits)
+        {
+            path[depth++] = n;
+            u32_t idx = index(key, shift);
+            u32_t bit = 1U << idx;
+            if (!(n->bitmap & bit))
+            {
+                Leaf* l = new Leaf(key, V());
+                n->insert(idx, {l, true});
+                for (u32_t i = 0; i < depth; ++i)
+                    path[i]->size++;
+                return l->kv.second;
+            }
+            Slot& s = n->slots[n->pos(idx)];
+            if (s.isLeaf && s.leaf()->kv.first == key)
+            {
+                makeUnique(s);
+                return s.leaf()->kv.second;
+            }
+            if (s.isLeaf)
+            {
+                /// push the other entry one level down, key then goes next to or below it
+                Node* child = new Node();
+                child->insert(index(s.leaf()->kv.first, shift + Bits), s);
+                child->size = 1;
+                s = {child, false};
+                n->leafmap &= ~bit;
+            }
+            else
+                makeUnique(s);
+            n = s.node();
+        }
+    }
+
+    /// Insert a copy of val if key is missing, return whether it is inserted
+    bool emplace(u32_t key, const V& val)
+    {
+        if (count(key))
+            return false;
+        (*this)[key] = val;
+        return true;
+    }
+
+    /// Apply f(V&) to all entries, copying the shared nodes
+    template <typename F>
+    void updateAll(F f)
+    {
+        if (root)
+        {
+            makeUnique(root);
+            updateAll(root, f);
+        }
+    }
+
+    /// Merge other into this map: f(V& mine, const V& theirs) for the keys of both, and with addMissing,
+    /// add the entries only in other. Shared subtrees are skipped, so f(v, v) must leave v unchanged.
+    template <typename F>
+    void mergeWith(const PersistentMap& other, F f, bool addMissing)
+    {
+        if (root == other.root || other.root == nullptr)
+            return;
+        if (root == nullptr)
+        {
+            if (addMissing)
+                *this = other;
+            return;
+        }
+        root = mergeNodes(root, other.root, 0, f, addMissing);
+    }
+
+    /// Whether both maps have the same keys and eq(V, V) holds for their values
+    template <typename F>
+    bool equals(const PersistentMap& other, F eq) const
+    {
+        if (size() != other.size())
+            return false;
+        if (size() == 0)
+            return true;
+        return equalNodes(root, other.root, eq);
+    }
+
+    /// Whether both maps are the same version
+    inline bool sharesRoot(const PersistentMap& other) const
+    {
+        return root == other.root;
+    }
+
+    /// Apply f(key, const V&) to the entries not shared with base, i.e., the entries
+    /// updated or accessed through operator[] since this map was copied from base
+    template <typename F>
+    void forEachUpdated(const PersistentMap& base, F f) const
+    {
+        if (root == nullptr || root == base.root)
+            return;
+        Slot baseRoot = {base.root, false};
+        forEachUpdated({root, false}, base.root ? &baseRoot : nullptr, 0, f);
+    }
+
+private:
+    template <typename F>
+    static void updateAll(Node* n, F& f)
+    {
+        for (Slot& s : n->slots)
+        {
+            makeUnique(s);
+            if (s.isLeaf)
+                f(s.leaf()->kv.second);
+            else
+                updateAll(s.node(), f);
+        }
+    }
+
+    /// A node at level shift holding only the leaf s
+    static Node* wrap(const Slot& s, u32_t shift)
+    {
+        Node* n = new Node();
+        retain(s);
+        n->insert(index(s.leaf()->kv.first, shift), s);
+        n->size = 1;
+        return n;
+    }
+
+    /// Merge theirs into mine (both at level shift), return the merged version of mine
+    template <typename F>
+    static Node* mergeNodes(Node* mine, const Node* theirs, u32_t shift, F& f, bool addMissing)
+    {
+        makeUnique(mine);
+        u32_t tp = 0;
+        for (u32_t bits = theirs->bitmap; bits != 0; bits &= bits - 1, ++tp)
+        {
+            const Slot& ts = theirs->slots[tp];
+            u32_t idx = __builtin_ctz(bits);
+            u32_t bit = 1U << idx;
+            if (!(mine->bitmap & bit))
+            {
+                if (addMissing)
+                {
+                    retain(ts);
+                    mine->insert(idx, ts);
+                }
+                continue;
+            }
+            Slot& ms = mine->slots[mine->pos(idx)];
+            if (ms.ptr == ts.ptr)
+                continue;
+            if (ms.isLeaf && ts.isLeaf && ms.leaf()->kv.first == ts.leaf()->kv.first)
+            {
+                makeUnique(ms);
+                f(ms.leaf()->kv.second, ts.leaf()->kv.second);
+                continue;
+            }
+
+            /// a leaf is merged as a node holding only the leaf one level down
+            Node* mnode = ms.isLeaf ? wrap(ms, shift + Bits) : ms.node();
+            if (ms.isLeaf)
+                release(ms);
+            const Node* tnode = ts.isLeaf ? wrap(ts, shift + Bits) : ts.node();
+            Node* merged = mergeNodes(mnode, tnode, shift + Bits, f, addMissing);
+            if (ts.isLeaf)
+                release({const_cast<Node*>(tnode), false});
+
+            /// keep the trie canonical, a single entry is stored as a leaf
+            if (merged->size == 1)
+            {
+                Slot leaf = firstLeaf(merged);
+                retain(leaf);
+                release({merged, false});
+                ms = leaf;
+                mine->leafmap |= bit;
+            }
+            else
+            {
+                ms = {merged, false};
+                mine->leafmap &= ~bit;
+            }
+        }
+        mine->size = 0;
+        for (const Slot& s : mine->slots)
+            mine->size += s.isLeaf ? 1 : s.node()->size;
+        return mine;
+    }
+
+    /// s and base are at the same level, the children of nodes are indexed at shift
+    template <typename F>
+    static void forEachUpdated(const Slot& s, const Slot* base, u32_t shift, F& f)
+    {
+        if (base != nullptr && base->ptr == s.ptr)
+            return;
+        if (s.isLeaf)
+        {
+            if (base == nullptr || !holdsLeaf(*base, s.leaf(), shift))
+                f(s.leaf()->kv.first, s.leaf()->kv.second);
+            return;
+        }
+        const Node* n = s.node();
+        u32_t p = 0;
+        for (u32_t bits = n->bitmap; bits != 0; bits &= bits - 1, ++p)
+        {
+            u32_t idx = __builtin_ctz(bits);
+            const Slot* child = nullptr;
+            if (base != nullptr && base->isLeaf)
+            {
+                /// a leaf of base may be pushed down in this map
+                if (index(base->leaf()->kv.first, shift) == idx)
+                    child = base;
+            }
+            else if (base != nullptr && (base->node()->bitmap & (1U << idx)))
+                child = &base->node()->slots[base->node()->pos(idx)];
+            forEachUpdated(n->slots[p], child, shift + Bits, f);
+        }
+    }
+
+    /// Whether the subtree of s holds the leaf l
+    static bool holdsLeaf(const Slot& s, const Leaf* l, u32_t shift)
+    {
+        const Slot* cur = &s;
+        for (; !cur->isLeaf; shift += Bits)
+        {
+            const Node* n = cur->node();
+            u32_t idx = index(l->kv.first, shift);
+            if (!(n->bitmap & (1U << idx)))
+                return false;
+            cur = &n->slots[n->pos(idx)];
+        }
+        return cur->ptr == l;
+    }
+
+    static Slot firstLeaf(const Node* n)
+    {
+        while (!n->slots.front().isLeaf)
+            n = n->slots.front().node();
+        return n->slots.front();
+    }
+
+    template <typename F>
+    static bool equalNodes(const Node* a, const Node* b, F& eq)
+    {
+        if (a == b)
+            return true;
+        if (a->bitmap != b->bitmap || a->leafmap != b->leafmap || a->size != b->size)
+            return false;
+        for (u32_t i = 0; i < a->slots.size(); ++i)
+        {
+            const Slot& sa = a->slots[i];
+            const Slot& sb = b->slots[i];
+            if (sa.ptr == sb.ptr)
+                continue;
+            if (sa.isLeaf)
+            {
+                if (sa.leaf()->kv.first != sb.leaf()->kv.first || !eq(sa.leaf()->kv.second, sb.leaf()->kv.second))
+                    return false;
+            }
+            else if (!equalNodes(sa.node(), sb.node(), eq))
+                return false;
+        }
+        return true;
+    }
+
+    Node* root;
+};
+
+} // End namespace SVF
+
+#endif /* PERSISTENTMAP_H_ */
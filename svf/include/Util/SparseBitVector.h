@@ -763,6 +763,20 @@ public:
         return ElementIter->test(Idx % ElementSize);
     }
 
+    // Test a bit without moving CurrElementIter, so that threads sharing this
+    // bitmap can test it at the same time.
+    bool test_uncached(unsigned Idx) const
+    {
+        unsigned ElementIndex = Idx / ElementSize;
+        for (ElementListConstIter ElementIter = Elements.begin(), End = Elements.end();
+                ElementIter != End && ElementIter->index() <= ElementIndex; ++ElementIter)
+        {
+            if (ElementIter->index() == ElementIndex)
+                return ElementIter->test(Idx % ElementSize);
+        }
+        return false;
+    }
+
     void reset(unsigned Idx)
     {
         if (Elements.empty())
@@ -34,6 +34,8 @@
 using namespace SVF;
 using namespace SVFUtil;
 
+thread_local AbstractState::ReadSet* AbstractState::_readRecorder = nullptr;
+
 bool AbstractState::equals(const AbstractState&other) const
 {
     return *this == other;
@@ -56,100 +58,110 @@ u32_t AbstractState::hash() const
     return pairH({h, h2});
 }
 
-AbstractState AbstractState::widening(const AbstractState& other)
+AbstractState AbstractState::widening(const AbstractState& other, const std::vector<s64_t>& thresholds)
 {
     // widen interval
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
+    auto widen = [&](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        if (val.isInterval() && otherVal.isInterval())
+            val.getInterval().widen_with(otherVal.getInterval(), thresholds);
+    };
+    es._varToAbsVal.mergeWith(other._varToAbsVal, widen, false);
+    es._addrToAbsVal.mergeWith(other._addrToAbsVal, widen, false);
     return es;
 }
 
-AbstractState AbstractState::narrowing(const AbstractState& other)
+AbstractState AbstractState::narrowing(const AbstractState& other, const std::vector<s64_t>& thresholds)
 {
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
+    auto narrow = [&](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        if (val.isInterval() && otherVal.isInterval())
+            val.getInterval().narrow_with(otherVal.getInterval(), thresholds);
+    };
+    es._varToAbsVal.mergeWith(other._varToAbsVal, narrow, false);
+    es._addrToAbsVal.mergeWith(other._addrToAbsVal, narrow, false);
     return es;
 
 }
 
 /// domain join with other, important! other widen this.
+/// Entries shared with other are skipped, joining a value with itself keeps it.
 void AbstractState::joinWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
+    auto join = [](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _varToAbsVal.emplace(key, it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _addrToAbsVal.emplace(key, it->second);
-        }
-    }
+        val.join_with(otherVal);
+    };
+    _varToAbsVal.mergeWith(other._varToAbsVal, join, true);
+    _addrToAbsVal.mergeWith(other._addrToAbsVal, join, true);
 }
 
 /// domain meet with other, important! other widen this.
 void AbstractState::meetWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
+    auto meet = [](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
+        val.meet_with(otherVal);
+    };
+    _varToAbsVal.mergeWith(other._varToAbsVal, meet, false);
+    _addrToAbsVal.mergeWith(other._addrToAbsVal, meet, false);
+}
+
+AbstractState AbstractState::updatedSince(const AbstractState& base) const
+{
+    AbstractState updated;
+    _varToAbsVal.forEachUpdated(base._varToAbsVal, [&](u32_t key, const AbstractValue& val)
+    {
+        updated._varToAbsVal[key] = val;
+    });
+    _addrToAbsVal.forEachUpdated(base._addrToAbsVal, [&](u32_t key, const AbstractValue& val)
+    {
+        updated._addrToAbsVal[key] = val;
+    });
+    return updated;
+}
+
+AbstractState AbstractState::projectTo(const AbstractState& keys) const
+{
+    AbstractState proj;
+    for (const auto& item : keys._varToAbsVal)
+    {
+        auto it = _varToAbsVal.find(item.first);
+        proj._varToAbsVal[item.first] = it != _varToAbsVal.end() ? it->second : AbstractValue();
+    }
+    for (const auto& item : keys._addrToAbsVal)
+    {
+        auto it = _addrToAbsVal.find(item.first);
+        proj._addrToAbsVal[item.first] = it != _addrToAbsVal.end() ? it->second : AbstractValue();
     }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
+    return proj;
+}
+
+void AbstractState::updateWith(const AbstractState& other)
+{
+    for (const auto& item : other._varToAbsVal)
+        _varToAbsVal[item.first] = item.second;
+    for (const auto& item : other._addrToAbsVal)
+        _addrToAbsVal[item.first] = item.second;
+}
+
+bool AbstractState::containedWithin(const AbstractState& other) const
+{
+    auto contained = [](const VarToAbsValMap& lhs, const VarToAbsValMap& rhs)
     {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
+        if (lhs.sharesRoot(rhs))
+            return true;
+        for (const auto& item : lhs)
         {
-            oit->second.meet_with(it->second);
+            auto it = rhs.find(item.first);
+            if (!item.second.containedWithin(it != rhs.end() ? it->second : AbstractValue()))
+                return false;
         }
-    }
+        return true;
+    };
+    return contained(_varToAbsVal, other._varToAbsVal) && contained(_addrToAbsVal, other._addrToAbsVal);
 }
 
 // getGepObjAddrs
@@ -0,0 +1,152 @@
+//===- DenseAbstractState.cpp ----Dense Abstract States-----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * DenseAbstractState.cpp
+ */
+
+#include "AE/Core/DenseAbstractState.h"
+
+using namespace SVF;
+
+u32_t DenseStateIndex::addSlot(u32_t id, bool addr)
+{
+    auto it = (addr ? _addrToSlot : _varToSlot).emplace(id, _slotToID.size());
+    if (it.second)
+        _slotToID.push_back(std::make_pair(id, addr));
+    return it.first->second;
+}
+
+DenseAbstractState::DenseAbstractState(const DenseStateIndex& index, const AbstractState& as)
+{
+    resize(index.size());
+    const AbstractState::VarToAbsValMap& vars = as.getVarToVal();
+    const AbstractState::AddrToAbsValMap& addrs = as.getLocToVal();
+    for (u32_t slot = 0; slot < index.size(); ++slot)
+    {
+        const AbstractState::VarToAbsValMap& map = index.isAddr(slot) ? addrs : vars;
+        auto it = map.find(index.getID(slot));
+        if (it != map.end())
+            setValue(slot, it->second);
+        _defined[slot] = true;
+    }
+}
+
+DenseAbstractState DenseAbstractState::fromEntries(DenseStateIndex& index, const AbstractState& as)
+{
+    DenseAbstractState dense;
+    for (const auto& item : as.getVarToVal())
+        dense.setValue(index.addSlot(item.first, false), item.second);
+    for (const auto& item : as.getLocToVal())
+        dense.setValue(index.addSlot(item.first, true), item.second);
+    return dense;
+}
+
+AbstractState DenseAbstractState::toAbstractState(const DenseStateIndex& index) const
+{
+    AbstractState as;
+    for (u32_t slot = 0; slot < size(); ++slot)
+    {
+        if (!_defined[slot])
+            continue;
+        if (index.isAddr(slot))
+            as.load(AbstractState::getVirtualMemAddress(index.getID(slot))) = getValue(slot);
+        else
+            as[index.getID(slot)] = getValue(slot);
+    }
+    return as;
+}
+
+AbstractValue DenseAbstractState::getValue(u32_t slot) const
+{
+    AbstractValue val;
+    val.getInterval() = getInterval(slot);
+    val.getAddrs().setVals(getAddrs(slot));
+    return val;
+}
+
+void DenseAbstractState::setValue(u32_t slot, const AbstractValue& val)
+{
+    if (slot >= size())
+        resize(slot + 1);
+    _intervals[slot] = val.getInterval();
+    _addrs[slot] = val.getAddrs().getVals();
+    _defined[slot] = true;
+}
+
+void DenseAbstractState::resize(u32_t n)
+{
+    _intervals.resize(n, IntervalValue::bottom());
+    _addrs.resize(n);
+    _defined.resize(n, false);
+}
+
+bool DenseAbstractState::containedWithin(const DenseAbstractState& other) const
+{
+    // intervals of the common slots in one pass over both arrays
+    u32_t common = std::min(size(), other.size());
+    std::vector<u8_t> contained(common);
+    IntervalValue::batch(_intervals.data(), other._intervals.data(), contained.data(), common,
+                         [](const IntervalValue& lhs, const IntervalValue& rhs)
+    {
+        return lhs.containedWithin(rhs);
+    });
+    for (u32_t slot = 0; slot < size(); ++slot)
+    {
+        if (!_defined[slot])
+            continue;
+        if (slot < common ? !contained[slot] || !other._addrs[slot].contains(_addrs[slot]) : !containedAt(slot, other))
+            return false;
+    }
+    return true;
+}
+
+bool DenseAbstractState::containedWithinAt(const DenseAbstractState& other) const
+{
+    for (u32_t slot = 0; slot < other.size(); ++slot)
+    {
+        if (other._defined[slot] && !containedAt(slot, other))
+            return false;
+    }
+    return true;
+}
+
+bool DenseAbstractState::equals(const DenseAbstractState& other) const
+{
+    u32_t common = std::min(size(), other.size());
+    std::vector<u8_t> equal(common);
+    IntervalValue::batch(_intervals.data(), other._intervals.data(), equal.data(), common,
+                         [](const IntervalValue& lhs, const IntervalValue& rhs)
+    {
+        return lhs.equals(rhs);
+    });
+    for (u32_t slot = 0; slot < common; ++slot)
+    {
+        if (!equal[slot] || _addrs[slot] != other._addrs[slot])
+            return false;
+    }
+    for (u32_t slot = common; slot < std::max(size(), other.size()); ++slot)
+    {
+        if (!getInterval(slot).equals(other.getInterval(slot)) || getAddrs(slot) != other.getAddrs(slot))
+            return false;
+    }
+    return true;
+}
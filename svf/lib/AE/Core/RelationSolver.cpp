@@ -33,18 +33,181 @@
 using namespace SVF;
 using namespace SVFUtil;
 
+RelationSolverSession::RelationSolverSession() : _solver(Z3Expr::getContext()), _hasFormula(false)
+{
+    z3::params p(Z3Expr::getContext());
+    p.set(":timeout", static_cast<unsigned>(timeout));
+    _solver.set(p);
+}
+
+const Z3Expr& RelationSolverSession::getIntConst(u32_t id)
+{
+    auto it = _idToConst.find(id);
+    if (it == _idToConst.end())
+        it = _idToConst.emplace(id, Z3Expr::getContext().int_const(std::to_string(id).c_str())).first;
+    return it->second;
+}
+
+void RelationSolverSession::setFormula(const Z3Expr& phi)
+{
+    if (_hasFormula)
+    {
+        /// expressions are hash-consed by z3, equal ones share their ids
+        if (_formula.id() == phi.id())
+            return;
+        _solver.pop();
+    }
+    _solver.push();
+    _solver.add(phi.getExpr());
+    _formula = phi;
+    _hasFormula = true;
+}
+
+z3::check_result RelationSolverSession::check(const Z3Expr& cond, const std::vector<u32_t>& vars,
+        Map<u32_t, s32_t>& values)
+{
+    _solver.push();
+    _solver.add(cond.getExpr());
+    z3::check_result checkRes = _solver.check();
+    if (checkRes == z3::sat)
+    {
+        z3::model m = _solver.get_model();
+        for (u32_t id : vars)
+            values[id] = m.eval(getIntConst(id).getExpr(), true).get_numeral_int();
+    }
+    _solver.pop();
+    return checkRes;
+}
+
+bool RelationSolverSession::optimize(const Z3Expr& phi, const AbstractState& domain, s32_t infinity,
+                                     AbstractState& res)
+{
+    z3::context& ctx = Z3Expr::getContext();
+    z3::optimize opt(ctx);
+    z3::params p(ctx);
+    p.set(":timeout", static_cast<unsigned>(timeout));
+    p.set("priority", ctx.str_symbol("box"));
+    opt.set(p);
+    opt.add(phi.getExpr());
+    std::vector<std::pair<z3::optimize::handle, z3::optimize::handle>> handles;
+    for (const auto& item : domain.getVarToVal())
+    {
+        const z3::expr& v = getIntConst(item.first).getExpr();
+        const IntervalValue& interval = item.second.getInterval();
+        if (!interval.lb().is_minus_infinity())
+            opt.add(v >= ctx.int_val((int64_t) interval.lb().getIntNumeral()));
+        if (!interval.ub().is_plus_infinity())
+            opt.add(v <= ctx.int_val((int64_t) interval.ub().getIntNumeral()));
+        handles.emplace_back(opt.minimize(v), opt.maximize(v));
+    }
+    if (opt.check() != z3::sat)
+        return false;
+
+    /// an unbounded objective is not a numeral (e.g., oo)
+    auto isInfinite = [infinity](const z3::expr& e, bool upper)
+    {
+        int64_t n;
+        if (!e.is_numeral_i64(n))
+            return true;
+        return upper ? n >= infinity : n <= -(int64_t) infinity;
+    };
+    u32_t i = 0;
+    for (const auto& item : domain.getVarToVal())
+    {
+        z3::expr lb = opt.lower(handles[i].first), ub = opt.upper(handles[i].second);
+        ++i;
+        res[item.first] = IntervalValue(
+                              isInfinite(lb, false) ? BoundedInt::minus_infinity() : BoundedInt(lb.get_numeral_int64()),
+                              isInfinite(ub, true) ? BoundedInt::plus_infinity() : BoundedInt(ub.get_numeral_int64()));
+    }
+
+    /// z3 may stop at a non-optimal value of a non-linear objective, so check all finite
+    /// bounds by one query and drop the ones violated by a model, until none is violated
+    setFormula(phi);
+    std::vector<u32_t> vars;
+    for (const auto& item : res.getVarToVal())
+        vars.push_back(item.first);
+    while (1)
+    {
+        Z3Expr violated(ctx.bool_val(false));
+        for (const auto& item : res.getVarToVal())
+        {
+            const Z3Expr& v = getIntConst(item.first);
+            const IntervalValue& interval = item.second.getInterval();
+            if (!interval.lb().is_minus_infinity())
+                violated = (violated || v < (int) interval.lb().getIntNumeral());
+            if (!interval.ub().is_plus_infinity())
+                violated = (violated || v > (int) interval.ub().getIntNumeral());
+        }
+        Map<u32_t, s32_t> values;
+        z3::check_result checkRes = check(violated, vars, values);
+        if (checkRes == z3::unsat)
+            return true;
+        if (checkRes == z3::unknown)
+            return false;
+        for (u32_t id : vars)
+        {
+            const IntervalValue& interval = res[id].getInterval();
+            bool lbViolated = !interval.lb().is_minus_infinity() && values[id] < interval.lb().getIntNumeral();
+            bool ubViolated = !interval.ub().is_plus_infinity() && values[id] > interval.ub().getIntNumeral();
+            res[id] = IntervalValue(lbViolated ? BoundedInt::minus_infinity() : interval.lb(),
+                                    ubViolated ? BoundedInt::plus_infinity() : interval.ub());
+        }
+    }
+}
+
+u32_t RelationSolverSession::getQueryHash(QueryKind kind, u32_t param, const AbstractState& domain,
+        const Z3Expr& phi)
+{
+    size_t h = domain.getVarToVal().size() * 2;
+    Hash<u32_t> hf;
+    for (const auto& item : domain.getVarToVal())
+        h ^= hf(item.first) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    Hash<std::pair<u32_t, u32_t>> pairH;
+    return pairH({pairH({phi.hash(), (u32_t) h}), kind * 65537 + param});
+}
+
+const AbstractState* RelationSolverSession::lookup(QueryKind kind, u32_t param, const AbstractState& domain,
+        const Z3Expr& phi) const
+{
+    auto it = _hashToQueries.find(getQueryHash(kind, param, domain, phi));
+    if (it == _hashToQueries.end())
+        return nullptr;
+    for (const Query& query : it->second)
+    {
+        if (query.kind == kind && query.param == param && query.phi.id() == phi.id() && query.domain == domain)
+            return &query.result;
+    }
+    return nullptr;
+}
+
+const AbstractState& RelationSolverSession::record(QueryKind kind, u32_t param, const AbstractState& domain,
+        const Z3Expr& phi, const AbstractState& result)
+{
+    std::vector<Query>& queries = _hashToQueries[getQueryHash(kind, param, domain, phi)];
+    queries.push_back(Query{kind, param, phi, domain, result});
+    return queries.back().result;
+}
+
+std::vector<u32_t> RelationSolver::getVars(const AbstractState& domain)
+{
+    std::vector<u32_t> vars;
+    for (const auto& item : domain.getVarToVal())
+        vars.push_back(item.first);
+    return vars;
+}
+
 AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr& phi,
                                         u32_t descend_check)
 {
+    if (const AbstractState* res = _session.lookup(RelationSolverSession::BilateralQuery, descend_check, domain, phi))
+        return *res;
     /// init variables
     AbstractState upper = domain.top();
     AbstractState lower = domain.bottom();
     u32_t meets_in_a_row = 0;
-    z3::solver solver = Z3Expr::getSolver();
-    z3::params p(Z3Expr::getContext());
-    /// TODO: add option for timeout
-    p.set(":timeout", static_cast<unsigned>(600)); // in milliseconds
-    solver.set(p);
+    _session.setFormula(phi);
+    std::vector<u32_t> vars = getVars(domain);
     AbstractState consequence;
 
     /// start processing
@@ -60,31 +223,11 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
         }
         /// compute domain.model_and(phi, domain.logic_not(domain.gamma_hat(consequence)))
         Z3Expr rhs = !(gamma_hat(consequence, domain));
-        solver.push();
-        solver.add(phi.getExpr() && rhs.getExpr());
         Map<u32_t, s32_t> solution;
-        z3::check_result checkRes = solver.check();
+        z3::check_result checkRes = _session.check(rhs, vars, solution);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
-            z3::model m = solver.get_model();
-            for (u32_t i = 0; i < m.size(); i++)
-            {
-                z3::func_decl v = m[i];
-                // assert(v.arity() == 0);
-                if (v.arity() != 0)
-                    continue;
-                solution.emplace(std::stoi(v.name().str()),
-                                 m.get_const_interp(v).get_numeral_int());
-            }
-            for (const auto& item : domain.getVarToVal())
-            {
-                if (solution.find(item.first) == solution.end())
-                {
-                    solution.emplace(item.first, 0);
-                }
-            }
-            solver.pop();
             AbstractState newLower = domain.bottom();
             newLower.joinWith(lower);
             AbstractState rhs = beta(solution, domain);
@@ -94,11 +237,10 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
         }
         else /// unknown or unsat
         {
-            solver.pop();
             if (checkRes == z3::unknown)
             {
                 /// for timeout reason return upper
-                if (solver.reason_unknown() == "timeout")
+                if (_session.getReasonUnknown() == "timeout")
                     return upper;
             }
             AbstractState newUpper = domain.top();
@@ -108,45 +250,24 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
             meets_in_a_row += 1;
         }
     }
-    return upper;
+    return _session.record(RelationSolverSession::BilateralQuery, descend_check, domain, phi, upper);
 }
 
 AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi)
 {
+    if (const AbstractState* res = _session.lookup(RelationSolverSession::RSYQuery, 0, domain, phi))
+        return *res;
     AbstractState lower = domain.bottom();
-    z3::solver& solver = Z3Expr::getSolver();
-    z3::params p(Z3Expr::getContext());
-    /// TODO: add option for timeout
-    p.set(":timeout", static_cast<unsigned>(600)); // in milliseconds
-    solver.set(p);
+    _session.setFormula(phi);
+    std::vector<u32_t> vars = getVars(domain);
     while (1)
     {
         Z3Expr rhs = !(gamma_hat(lower, domain));
-        solver.push();
-        solver.add(phi.getExpr() && rhs.getExpr());
         Map<u32_t, s32_t> solution;
-        z3::check_result checkRes = solver.check();
+        z3::check_result checkRes = _session.check(rhs, vars, solution);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
-            z3::model m = solver.get_model();
-            for (u32_t i = 0; i < m.size(); i++)
-            {
-                z3::func_decl v = m[i];
-                if (v.arity() != 0)
-                    continue;
-
-                solution.emplace(std::stoi(v.name().str()),
-                                 m.get_const_interp(v).get_numeral_int());
-            }
-            for (const auto& item : domain.getVarToVal())
-            {
-                if (solution.find(item.first) == solution.end())
-                {
-                    solution.emplace(item.first, 0);
-                }
-            }
-            solver.pop();
             AbstractState newLower = domain.bottom();
             newLower.joinWith(lower);
             newLower.joinWith(beta(solution, domain));
@@ -154,17 +275,16 @@ AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi
         }
         else /// unknown or unsat
         {
-            solver.pop();
             if (checkRes == z3::unknown)
             {
                 /// for timeout reason return upper
-                if (solver.reason_unknown() == "timeout")
+                if (_session.getReasonUnknown() == "timeout")
                     return domain.top();
             }
             break;
         }
     }
-    return lower;
+    return _session.record(RelationSolverSession::RSYQuery, 0, domain, phi, lower);
 }
 
 AbstractState RelationSolver::abstract_consequence(
@@ -269,10 +389,17 @@ void RelationSolver::updateMap(Map<u32_t, s32_t>& map, u32_t key, const s32_t& v
 
 AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
 {
+    if (const AbstractState* res = _session.lookup(RelationSolverSession::BSQuery, 0, domain, phi))
+        return *res;
     /// because key of _varToItvVal is u32_t, -key may out of range for int
     /// so we do key + bias for -key
     u32_t bias = 0;
     s32_t infinity = INT32_MAX/2 - 1;
+    /// find all bounds at once by a boxed optimisation, the binary search below only finds
+    /// the ones the optimisation leaves infinite (e.g., of a division by zero, where z3 is
+    /// less precise), or all bounds if it fails
+    AbstractState retInv;
+    bool optimized = _session.optimize(phi, domain, infinity, retInv);
 
     // int infinity = (INT32_MAX) - 1;
     // int infinity = 20;
@@ -282,6 +409,10 @@ AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
     /// init low, ret, high
     for (const auto& item: domain.getVarToVal())
     {
+        if (item.first >= bias)
+            bias = item.first + 1;
+        if (optimized && !retInv[item.first].getInterval().ub().is_plus_infinity())
+            continue;
         IntervalValue interval = item.second.getInterval();
         updateMap(ret, item.first, interval.ub().getIntNumeral());
         if (interval.lb().is_minus_infinity())
@@ -292,12 +423,12 @@ AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
             updateMap(high_values, item.first, infinity);
         else
             updateMap(high_values, item.first, interval.ub().getIntNumeral());
-        if (item.first > bias)
-            bias = item.first + 1;
     }
     for (const auto& item: domain.getVarToVal())
     {
         /// init objects -x
+        if (optimized && !retInv[item.first].getInterval().lb().is_minus_infinity())
+            continue;
         IntervalValue interval = item.second.getInterval();
         u32_t reverse_key = item.first + bias;
         updateMap(ret, reverse_key, -interval.lb().getIntNumeral());
@@ -313,9 +444,9 @@ AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
         new_phi = (new_phi && (toIntZ3Expr(reverse_key) == -1 * toIntZ3Expr(item.first)));
     }
     /// optimize each object
-    BoxedOptSolver(new_phi.simplify(), ret, low_values, high_values);
+    if (!ret.empty())
+        BoxedOptSolver(new_phi.simplify(), ret, low_values, high_values);
     /// fill in the return values
-    AbstractState retInv;
     for (const auto& item: ret)
     {
         if (item.first >= bias)
@@ -339,7 +470,7 @@ AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
                 retInv[item.first] = IntervalValue(retInv[item.first].getInterval().lb(), float(item.second));
         }
     }
-    return retInv;
+    return _session.record(RelationSolverSession::BSQuery, 0, domain, phi, retInv);
 }
 
 Map<u32_t, s32_t> RelationSolver::BoxedOptSolver(const Z3Expr& phi, Map<u32_t, s32_t>& ret, Map<u32_t, s32_t>& low_values, Map<u32_t, s32_t>& high_values)
@@ -377,34 +508,30 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
                                     Map<u32_t, s32_t>& low_values,
                                     Map<u32_t, s32_t>& high_values)
 {
+    _session.setFormula(phi);
     while (1)
     {
         Z3Expr join_expr(Z3Expr::getContext().bool_val(false));
+        std::vector<u32_t> vars;
         for (const auto& item : L_phi)
+        {
             join_expr = (join_expr || item.second);
-        join_expr = (join_expr && phi).simplify();
-        z3::solver& solver = Z3Expr::getSolver();
-        solver.push();
-        solver.add(join_expr.getExpr());
-        Map<u32_t, double> solution;
-        z3::check_result checkRes = solver.check();
+            vars.push_back(item.first);
+        }
+        Map<u32_t, s32_t> solution;
+        z3::check_result checkRes = _session.check(join_expr.simplify(), vars, solution);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
-            z3::model m = solver.get_model();
-            solver.pop();
-            for(const auto & item : L_phi)
+            for (u32_t id : vars)
             {
-                u32_t id = item.first;
-                int value = m.eval(toIntZ3Expr(id).getExpr()).get_numeral_int();
-                // int value = m.eval(Z3Expr::getContext().int_const(std::to_string(id).c_str())).get_numeral_int();
                 /// id is the var id, value is the solution found for var_id
                 /// add a relation to check if the solution meets phi_id
-                Z3Expr expr = (item.second && toIntZ3Expr(id) == value);
-                solver.push();
-                solver.add(expr.getExpr());
+                s32_t value = solution.at(id);
+                Map<u32_t, s32_t> unused;
+                Z3Expr expr = (L_phi.at(id) && toIntZ3Expr(id) == value);
                 // solution meets phi_id
-                if (solver.check() == z3::sat)
+                if (_session.check(expr, {}, unused) == z3::sat)
                 {
                     updateMap(ret, id, (value));
                     updateMap(low_values, id, ret.at(id) + 1);
@@ -412,20 +539,16 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
                     s32_t mid = (low_values.at(id) + high_values.at(id) + 1) / 2;
                     updateMap(mid_values, id, mid);
                     Z3Expr v = toIntZ3Expr(id);
-                    // Z3Expr v = Z3Expr::getContext().int_const(std::to_string(id).c_str());
                     Z3Expr expr = (toIntVal(mid_values.at(id)) <= v && v <= toIntVal(high_values.at(id)));
                     L_phi[id] = expr;
                 }
-                solver.pop();
             }
         }
         else /// unknown or unsat, we consider unknown as unsat
         {
-            solver.pop();
             for (const auto& item : L_phi)
                 high_values.at(item.first) = mid_values.at(item.first) - 1;
             return;
         }
     }
-
-}
\ No newline at end of file
+}
@@ -0,0 +1,540 @@
+//===- AEIncrementalCache.cpp -- Function summaries across AE runs-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AEIncrementalCache.cpp
+ */
+
+#include "AE/Svfexe/AEIncrementalCache.h"
+#include "WPA/Andersen.h"
+#include "Util/Options.h"
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+using namespace SVF;
+
+namespace
+{
+
+const char* const CacheHeader = "SVF-AE-INCREMENTAL-1";
+
+/// FNV-1a, stable across runs and builds unlike std::hash
+//@{
+inline u64_t hashBytes(u64_t h, const char* data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        h ^= (unsigned char) data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+inline u64_t hashCombine(u64_t h, u64_t v)
+{
+    return hashBytes(h, reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+inline u64_t hashCombine(u64_t h, const std::string& s)
+{
+    // the length separates consecutive strings
+    return hashBytes(hashCombine(h, (u64_t) s.size()), s.data(), s.size());
+}
+
+const u64_t HashSeed = 14695981039346656037ULL;
+//@}
+
+/// The text of a value without its source location and the numbers of metadata nodes,
+/// which change with the code before it
+std::string getStableText(const SVFValue* value)
+{
+    std::string text = value->toString();
+    const std::string loc = value->getSourceLoc();
+    if (!loc.empty() && text.size() >= loc.size() &&
+            text.compare(text.size() - loc.size(), loc.size(), loc) == 0)
+        text.resize(text.size() - loc.size());
+    std::string stable;
+    stable.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        stable.push_back(text[i]);
+        if (text[i] == '!')
+        {
+            while (i + 1 < text.size() && std::isdigit((unsigned char) text[i + 1]))
+                ++i;
+        }
+    }
+    return stable;
+}
+
+void writeBound(std::string& out, const BoundedInt& b)
+{
+    if (b.is_plus_infinity())
+        out += "+oo";
+    else if (b.is_minus_infinity())
+        out += "-oo";
+    else
+        out += std::to_string(b.getIntNumeral());
+}
+
+bool parseBound(std::string_view token, BoundedInt& b)
+{
+    if (token == "+oo")
+        b = BoundedInt::plus_infinity();
+    else if (token == "-oo")
+        b = BoundedInt::minus_infinity();
+    else
+    {
+        s64_t v = 0;
+        auto res = std::from_chars(token.data(), token.data() + token.size(), v);
+        if (res.ec != std::errc() || res.ptr != token.data() + token.size())
+            return false;
+        b = BoundedInt(v);
+    }
+    return true;
+}
+
+template<typename T>
+bool parseNum(std::string_view token, T& v, int base = 10)
+{
+    auto res = std::from_chars(token.data(), token.data() + token.size(), v, base);
+    return res.ec == std::errc() && res.ptr == token.data() + token.size();
+}
+
+} // End anonymous namespace
+
+/// Whitespace separated tokens of the cache file, read without copying
+class AEIncrementalCache::TokenReader
+{
+public:
+    TokenReader(const std::string& buf) : _cur(buf.data()), _end(buf.data() + buf.size()) {}
+
+    /// The next token, false at the end of the buffer
+    bool next(std::string_view& token)
+    {
+        while (_cur != _end && std::isspace((unsigned char) *_cur))
+            ++_cur;
+        if (_cur == _end)
+            return false;
+        const char* begin = _cur;
+        while (_cur != _end && !std::isspace((unsigned char) *_cur))
+            ++_cur;
+        token = std::string_view(begin, _cur - begin);
+        return true;
+    }
+
+    /// The next token as a number
+    template<typename T>
+    bool nextNum(T& v)
+    {
+        std::string_view token;
+        return next(token) && parseNum(token, v);
+    }
+
+    /// The rest of the current line
+    std::string_view nextLine()
+    {
+        const char* begin = _cur;
+        while (_cur != _end && *_cur != '\n')
+            ++_cur;
+        std::string_view line(begin, _cur - begin);
+        if (_cur != _end)
+            ++_cur;
+        return line;
+    }
+
+private:
+    const char* _cur;
+    const char* _end;
+};
+
+AEIncrementalCache::AEIncrementalCache(SVFIR* svfir) : _svfir(svfir)
+{
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(svfir);
+    _callGraph = ander->getCallGraph();
+    _callGraphSCC = ander->getCallGraphSCC();
+    _callGraphSCC->find();
+}
+
+std::string AEIncrementalCache::getOptionString()
+{
+    std::stringstream ss;
+    ss << "widen-delay=" << Options::WidenDelay()
+       << " ae-widen-thresholds=" << Options::AEWidenThresholds()
+       << " ae-exact-loop-iter=" << Options::AEExactLoopIter();
+    return ss.str();
+}
+
+u64_t AEIncrementalCache::getBodyHash(const SVFFunction* fun)
+{
+    auto it = _funToBodyHash.find(fun);
+    if (it != _funToBodyHash.end())
+        return it->second;
+
+    u64_t h = hashCombine(HashSeed, fun->getName());
+    h = hashCombine(h, (u64_t) fun->arg_size());
+    u32_t pos = 0;
+    for (const SVFBasicBlock* bb : fun->getBasicBlockList())
+    {
+        h = hashCombine(h, (u64_t) bb->getInstructionList().size());
+        for (const SVFInstruction* inst : bb->getInstructionList())
+        {
+            h = hashCombine(h, getStableText(inst));
+            _instToPos[inst] = pos++;
+        }
+    }
+    _funToBodyHash[fun] = h;
+    return h;
+}
+
+u64_t AEIncrementalCache::getSCCKey(NodeID rep)
+{
+    auto it = _sccToKey.find(rep);
+    if (it != _sccToKey.end())
+        return it->second;
+
+    std::vector<u64_t> bodies;
+    std::vector<u64_t> callees;
+    for (NodeID id : _callGraphSCC->subNodes(rep))
+    {
+        const CallGraphNode* node = _callGraph->getCallGraphNode(id);
+        bodies.push_back(getBodyHash(node->getFunction()));
+        for (const CallGraphEdge* edge : node->getOutEdges())
+        {
+            NodeID calleeRep = _callGraphSCC->repNode(edge->getDstID());
+            if (calleeRep != rep)
+                callees.push_back(getSCCKey(calleeRep));
+        }
+    }
+    std::sort(bodies.begin(), bodies.end());
+    std::sort(callees.begin(), callees.end());
+    callees.erase(std::unique(callees.begin(), callees.end()), callees.end());
+    u64_t h = HashSeed;
+    for (u64_t body : bodies)
+        h = hashCombine(h, body);
+    h = hashCombine(h, (u64_t) callees.size());
+    for (u64_t callee : callees)
+        h = hashCombine(h, callee);
+    _sccToKey[rep] = h;
+    return h;
+}
+
+bool AEIncrementalCache::reachesDirty(NodeID rep, const Set<const SVFFunction*>& dirtyFuns)
+{
+    auto it = _sccToDirty.find(rep);
+    if (it != _sccToDirty.end())
+        return it->second;
+
+    bool dirty = false;
+    for (NodeID id : _callGraphSCC->subNodes(rep))
+    {
+        const CallGraphNode* node = _callGraph->getCallGraphNode(id);
+        if (dirtyFuns.count(node->getFunction()))
+            dirty = true;
+        for (const CallGraphEdge* edge : node->getOutEdges())
+        {
+            NodeID calleeRep = _callGraphSCC->repNode(edge->getDstID());
+            if (calleeRep != rep && reachesDirty(calleeRep, dirtyFuns))
+                dirty = true;
+        }
+    }
+    _sccToDirty[rep] = dirty;
+    return dirty;
+}
+
+u64_t AEIncrementalCache::getValueKey(const SVFValue* value)
+{
+    if (const SVFInstruction* inst = SVFUtil::dyn_cast<SVFInstruction>(value))
+    {
+        const SVFFunction* fun = inst->getFunction();
+        u64_t h = hashCombine(hashCombine(HashSeed, "inst"), fun->getName());
+        h = hashCombine(h, getBodyHash(fun));
+        return hashCombine(h, (u64_t) _instToPos[inst]);
+    }
+    if (const SVFArgument* arg = SVFUtil::dyn_cast<SVFArgument>(value))
+    {
+        const SVFFunction* fun = arg->getParent();
+        u64_t h = hashCombine(hashCombine(HashSeed, "arg"), fun->getName());
+        h = hashCombine(h, getBodyHash(fun));
+        return hashCombine(h, (u64_t) arg->getArgNo());
+    }
+    if (SVFUtil::isa<SVFFunction>(value))
+        return hashCombine(hashCombine(HashSeed, "global"), value->getName());
+    // the definition of a global (e.g., its type and initializer) is part of its key,
+    // summaries over the old object must not be reused when it changes
+    if (SVFUtil::isa<SVFGlobalValue>(value))
+        return hashCombine(hashCombine(hashCombine(HashSeed, "global"), value->getName()), getStableText(value));
+    if (SVFUtil::isa<SVFBasicBlock>(value))
+        return 0;
+    // constants are identified by their text
+    return hashCombine(hashCombine(HashSeed, "const"), getStableText(value));
+}
+
+u64_t AEIncrementalCache::getVarKey(NodeID id)
+{
+    if (SymbolTableInfo::isNullPtr(id) || SymbolTableInfo::isBlkPtr(id) ||
+            SymbolTableInfo::isBlkObjOrConstantObj(id))
+        return hashCombine(hashCombine(HashSeed, "sym"), (u64_t) id);
+    if (!_svfir->hasGNode(id))
+        return 0;
+    const SVFVar* var = _svfir->getGNode(id);
+    if (SVFUtil::isa<GepObjVar>(var) || var->getNodeKind() == SVFVar::DummyValNode ||
+            var->getNodeKind() == SVFVar::DummyObjNode || !var->hasValue())
+        return 0;
+    u64_t valueKey = getValueKey(var->getValue());
+    if (valueKey == 0)
+        return 0;
+    return hashCombine(hashCombine(HashSeed, (u64_t) var->getNodeKind()), valueKey);
+}
+
+void AEIncrementalCache::initKeyToVar()
+{
+    if (!_keyToVar.empty())
+        return;
+    for (const auto& it : *_svfir)
+    {
+        u64_t key = getVarKey(it.first);
+        if (key == 0)
+            continue;
+        _varToKey[it.first] = key;
+        // e.g., the field variables of a value, none of them is resolved
+        if (!_keyToVar.emplace(key, it.first).second)
+            _ambiguousKeys.insert(key);
+    }
+    for (u64_t key : _ambiguousKeys)
+        _keyToVar.erase(key);
+}
+
+bool AEIncrementalCache::writeVar(std::string& out, NodeID id)
+{
+    s64_t offset = -1;
+    if (_svfir->hasGNode(id))
+    {
+        if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(_svfir->getGNode(id)))
+        {
+            offset = gep->getConstantFieldIdx();
+            id = _svfir->getBaseObjVar(id);
+        }
+    }
+    auto it = _varToKey.find(id);
+    if (it == _varToKey.end() || _ambiguousKeys.count(it->second))
+        return false;
+    char buf[20];
+    auto res = std::to_chars(buf, buf + sizeof(buf), it->second, 16);
+    out += ' ';
+    out.append(buf, res.ptr);
+    if (offset >= 0)
+        out += '+' + std::to_string(offset);
+    return true;
+}
+
+bool AEIncrementalCache::readVar(TokenReader& reader, NodeID& id, bool& resolved)
+{
+    std::string_view token;
+    if (!reader.next(token))
+        return false;
+    size_t plus = token.find('+');
+    u64_t key = 0;
+    APOffset offset = -1;
+    if (!parseNum(token.substr(0, plus), key, 16) ||
+            (plus != std::string_view::npos && !parseNum(token.substr(plus + 1), offset)))
+        return false;
+    auto it = _keyToVar.find(key);
+    if (it == _keyToVar.end() || (offset >= 0 && !SVFUtil::isa<ObjVar>(_svfir->getGNode(it->second))))
+    {
+        resolved = false;
+        return true;
+    }
+    id = offset >= 0 ? _svfir->getGepObjVar(_svfir->getBaseObj(it->second), offset) : it->second;
+    return true;
+}
+
+bool AEIncrementalCache::writeState(std::string& out, const AbstractState& as)
+{
+    out += std::to_string(as.getVarToVal().size()) + ' ' + std::to_string(as.getLocToVal().size()) + '\n';
+    for (const AbstractState::VarToAbsValMap* map : {&as.getVarToVal(), &as.getLocToVal()})
+    {
+        for (const auto& item : *map)
+        {
+            if (!writeVar(out, item.first))
+                return false;
+            // bottom is written as [+oo, -oo]
+            const IntervalValue& itv = item.second.getInterval();
+            out += ' ';
+            writeBound(out, itv.isBottom() ? BoundedInt::plus_infinity() : itv.lb());
+            out += ' ';
+            writeBound(out, itv.isBottom() ? BoundedInt::minus_infinity() : itv.ub());
+            const AddressValue& addrs = item.second.getAddrs();
+            out += ' ' + std::to_string(addrs.size());
+            for (u32_t addr : addrs)
+            {
+                if (!writeVar(out, AbstractState::getInternalID(addr)))
+                    return false;
+            }
+            out += '\n';
+        }
+    }
+    return true;
+}
+
+bool AEIncrementalCache::readState(TokenReader& reader, AbstractState& as, bool& resolved)
+{
+    u32_t numVars = 0;
+    u32_t numLocs = 0;
+    if (!reader.nextNum(numVars) || !reader.nextNum(numLocs))
+        return false;
+    AbstractState::VarToAbsValMap vars;
+    AbstractState::AddrToAbsValMap locs;
+    for (u32_t i = 0; i < numVars + numLocs; ++i)
+    {
+        // an entry of a changed function is not resolved, the rest of the state is still read
+        NodeID id = 0;
+        bool entryResolved = true;
+        std::string_view lbToken;
+        std::string_view ubToken;
+        BoundedInt lb = BoundedInt::plus_infinity();
+        BoundedInt ub = BoundedInt::minus_infinity();
+        u32_t numAddrs = 0;
+        if (!readVar(reader, id, entryResolved) || !reader.next(lbToken) || !reader.next(ubToken) ||
+                !parseBound(lbToken, lb) || !parseBound(ubToken, ub) || !reader.nextNum(numAddrs))
+            return false;
+        AbstractValue val;
+        if (!lb.is_plus_infinity() || !ub.is_minus_infinity())
+            val.getInterval() = IntervalValue(lb, ub);
+        for (u32_t j = 0; j < numAddrs; ++j)
+        {
+            NodeID obj = 0;
+            if (!readVar(reader, obj, entryResolved))
+                return false;
+            if (entryResolved)
+                val.getAddrs().insert(AbstractState::getVirtualMemAddress(obj));
+        }
+        if (entryResolved)
+            (i < numVars ? vars : locs)[id] = val;
+        else
+            resolved = false;
+    }
+    as = AbstractState(vars, locs);
+    return true;
+}
+
+bool AEIncrementalCache::load(const std::string& path, FunToSummaries& summaries, VarPairs& varPairs)
+{
+    std::ifstream is(path, std::ios::binary);
+    if (!is)
+        return false;
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const std::string buf = ss.str();
+    TokenReader reader(buf);
+    if (reader.nextLine() != std::string(CacheHeader) + " " + getOptionString())
+        return false;
+
+    initKeyToVar();
+    Map<u64_t, const SVFFunction*> keyToFun;
+    for (const SVFFunction* fun : _svfir->getModule()->getFunctionSet())
+    {
+        if (!fun->isDeclaration())
+            keyToFun[getFunKey(fun)] = fun;
+    }
+
+    std::string_view tag;
+    while (reader.next(tag))
+    {
+        if (tag == "P")
+        {
+            NodeID first = 0;
+            NodeID second = 0;
+            bool resolved = true;
+            if (!readVar(reader, first, resolved) || !readVar(reader, second, resolved))
+                return false;
+            if (resolved)
+                varPairs.push_back(std::make_pair(first, second));
+            continue;
+        }
+        std::string_view keyToken;
+        u64_t key = 0;
+        u32_t numSummaries = 0;
+        if (tag != "F" || !reader.next(keyToken) || !parseNum(keyToken, key, 16) || !reader.nextNum(numSummaries))
+            return false;
+        auto it = keyToFun.find(key);
+        for (u32_t i = 0; i < numSummaries; ++i)
+        {
+            Summary summary;
+            bool resolved = true;
+            if (!readState(reader, summary.first, resolved) || !readState(reader, summary.second, resolved))
+                return false;
+            if (it != keyToFun.end() && resolved)
+                summaries[it->second].push_back(summary);
+        }
+    }
+    return true;
+}
+
+bool AEIncrementalCache::save(const std::string& path, const FunToSummaries& summaries,
+                              const Set<const SVFFunction*>& dirtyFuns, const VarPairs& varPairs)
+{
+    initKeyToVar();
+    std::ofstream os(path, std::ios::binary);
+    if (!os)
+        return false;
+    os << CacheHeader << " " << getOptionString() << "\n";
+    // in the order of the functions of the module, the file does not depend on pointers
+    std::string out;
+    for (const SVFFunction* fun : _svfir->getModule()->getFunctionSet())
+    {
+        auto it = summaries.find(fun);
+        if (it == summaries.end())
+            continue;
+        NodeID rep = _callGraphSCC->repNode(_callGraph->getCallGraphNode(fun)->getId());
+        if (reachesDirty(rep, dirtyFuns))
+            continue;
+        u32_t numWritten = 0;
+        std::string written;
+        for (const Summary& summary : it->second)
+        {
+            size_t size = written.size();
+            if (writeState(written, summary.first) && writeState(written, summary.second))
+                ++numWritten;
+            else
+                written.resize(size);
+        }
+        if (numWritten == 0)
+            continue;
+        std::stringstream key;
+        key << std::hex << getSCCKey(rep);
+        out += "F " + key.str() + " " + std::to_string(numWritten) + "\n" + written;
+    }
+    for (const auto& pair : varPairs)
+    {
+        size_t size = out.size();
+        out += "P";
+        if (writeVar(out, pair.first) && writeVar(out, pair.second))
+            out += "\n";
+        else
+            out.resize(size);
+    }
+    os << out;
+    return (bool) os;
+}
@@ -29,7 +29,10 @@
 #include "SVFIR/SVFIR.h"
 #include "Util/Options.h"
 #include "Util/WorkList.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -93,8 +96,12 @@ void AbstractInterpretation::runOnModule(ICFG *icfg)
     /// collect checkpoint
     collectCheckPoint();
 
+    if (!Options::AEIncremental().empty() && !Options::AESharedTopLevel())
+        loadIncrementalCache();
     analyse();
     checkPointAllSet();
+    if (_incrementalCache)
+        saveIncrementalCache();
     _stat->endClk();
     _stat->finializeStat();
     if (Options::PStat())
@@ -113,6 +120,7 @@ AbstractInterpretation::AbstractInterpretation()
 AbstractInterpretation::~AbstractInterpretation()
 {
     delete _stat;
+    delete _incrementalCache;
     for (auto it: _funcToWTO)
         delete it.second;
 
@@ -157,11 +165,199 @@ void AbstractInterpretation::analyse()
     handleGlobalNode();
     getAbsStateFromTrace(
         _icfg->getGlobalICFGNode())[PAG::getPAG()->getBlkPtr()] = IntervalValue::top();
-    if (const SVFFunction* fun = _svfir->getModule()->getSVFFunction("main"))
+    if (Options::AESharedTopLevel())
+        flushNodeView(_icfg->getGlobalICFGNode());
+
+    // main is analysed by this analysis, every function without callers (-run-uncall-fun)
+    // by a worker starting from the global state
+    const SVFFunction* mainFun = _svfir->getModule()->getSVFFunction("main");
+    std::vector<const SVFFunction*> entries(1, mainFun);
+    if (Options::RunUncallFuncs())
     {
-        ICFGWTO* wto = _funcToWTO[fun];
-        handleWTOComponents(wto->getWTOComponents());
+        CallGraph* callGraph = AndersenWaveDiff::createAndersenWaveDiff(_svfir)->getCallGraph();
+        for (const SVFFunction* fun : _svfir->getModule()->getFunctionSet())
+        {
+            if (fun != mainFun && !fun->isDeclaration() && !callGraph->getCallGraphNode(fun)->hasIncomingEdge())
+                entries.push_back(fun);
+        }
+    }
+    std::vector<AbstractInterpretation*> workers(entries.size(), nullptr);
+    for (u32_t i = 1; i < entries.size(); ++i)
+    {
+        AbstractInterpretation* worker = createWorker();
+        worker->_svfir = _svfir;
+        worker->_icfg = _icfg;
+        worker->_funcToWTO = _funcToWTO;
+        worker->_recursiveFuns = _recursiveFuns;
+        worker->_checkpoints = _checkpoints;
+        worker->_abstractTrace[_icfg->getGlobalICFGNode()] = _abstractTrace[_icfg->getGlobalICFGNode()];
+        worker->_topLevelState = _topLevelState;
+        worker->_funcToSummaries = _funcToSummaries;
+        worker->_funcToSummaryIndex = _funcToSummaryIndex;
+        workers[i] = worker;
+    }
+
+    // field objects are created lazily by SVFIR::getGepObjVar, which is locked
+    u32_t numThreads = std::min(Options::AEThreads(), (u32_t) entries.size());
+    std::atomic<u32_t> nextTask(0);
+    auto analyseEntries = [&]()
+    {
+        for (u32_t i = nextTask++; i < entries.size(); i = nextTask++)
+        {
+            if (i > 0)
+                workers[i]->analyseEntry(entries[i]);
+            else if (mainFun)
+                handleWTOComponents(_funcToWTO[mainFun]->getWTOComponents());
+        }
+    };
+    std::vector<std::thread> threads;
+    for (u32_t t = 1; t < numThreads; ++t)
+        threads.emplace_back(analyseEntries);
+    analyseEntries();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // in the order of entries, the results do not depend on the schedule
+    for (u32_t i = 1; i < entries.size(); ++i)
+    {
+        mergeWorker(workers[i]);
+        // the WTOs are owned by this analysis
+        workers[i]->_funcToWTO.clear();
+        delete workers[i];
+    }
+}
+
+void AbstractInterpretation::analyseEntry(const SVFFunction* fun)
+{
+    const ICFGNode* entry = _icfg->getFunEntryICFGNode(fun);
+    _abstractTrace[entry] = _abstractTrace[_icfg->getGlobalICFGNode()];
+    for (const ICFGWTOComp* wtoComp : _funcToWTO[fun]->getWTOComponents())
+    {
+        const ICFGSingletonWTO* singleton = SVFUtil::dyn_cast<ICFGSingletonWTO>(wtoComp);
+        if (singleton && singleton->getICFGNode() == entry)
+        {
+            // the entry has no predecessors to merge from
+            if (Options::AESharedTopLevel())
+                materializeNodeView(entry);
+            handleSingletonWTO(singleton);
+            if (Options::AESharedTopLevel())
+                flushNodeView(entry);
+        }
+        else
+        {
+            handleWTOComponent(wtoComp);
+        }
+    }
+}
+
+AbstractInterpretation* AbstractInterpretation::createWorker() const
+{
+    return new AbstractInterpretation();
+}
+
+void AbstractInterpretation::mergeWorker(AbstractInterpretation* worker)
+{
+    for (const auto& it : worker->_abstractTrace)
+    {
+        auto res = _abstractTrace.emplace(it.first, it.second);
+        if (!res.second)
+            res.first->second.joinWith(it.second);
+    }
+    if (Options::AESharedTopLevel())
+        _topLevelState.joinWith(worker->_topLevelState);
+    for (const auto& it : worker->_stat->generalNumMap)
+        _stat->generalNumMap[it.first] += it.second;
+    for (const auto& it : worker->_stat->cycleIterNum)
+        _stat->cycleIterNum[it.first] += it.second;
+    _stat->count += worker->_stat->count;
+    _bugFuns.insert(worker->_bugFuns.begin(), worker->_bugFuns.end());
+    // the summaries are saved with -ae-incremental, the ones the worker copied are skipped
+    if (_incrementalCache)
+    {
+        for (const auto& it : worker->_funcToSummaries)
+        {
+            const DenseStateIndex& workerIndex = worker->_funcToSummaryIndex[it.first];
+            DenseStateIndex& index = _funcToSummaryIndex[it.first];
+            std::vector<FunSummary>& summaries = _funcToSummaries[it.first];
+            for (const FunSummary& workerSummary : it.second)
+            {
+                FunSummary summary;
+                summary.input = DenseAbstractState::fromEntries(index, workerSummary.input.toAbstractState(workerIndex));
+                summary.output = workerSummary.output;
+                auto same = [&](const FunSummary& s)
+                {
+                    return s.input.equals(summary.input) && s.output == summary.output;
+                };
+                if (std::none_of(summaries.begin(), summaries.end(), same))
+                    summaries.push_back(summary);
+            }
+        }
+    }
+    // a checkpoint is verified once verified by any worker
+    for (auto it = _checkpoints.begin(); it != _checkpoints.end();)
+    {
+        if (worker->_checkpoints.count(*it) == 0)
+            it = _checkpoints.erase(it);
+        else
+            ++it;
+    }
+}
+
+void AbstractInterpretation::loadIncrementalCache()
+{
+    _incrementalCache = new AEIncrementalCache(_svfir);
+    for (const CallICFGNode* checkpoint : _checkpoints)
+        _uncachedFuns.insert(checkpoint->getFun());
+
+    AEIncrementalCache::FunToSummaries cached;
+    AEIncrementalCache::VarPairs varPairs;
+    if (!_incrementalCache->load(Options::AEIncremental(), cached, varPairs))
+        return;
+    for (const auto& it : cached)
+    {
+        DenseStateIndex& index = _funcToSummaryIndex[it.first];
+        for (const AEIncrementalCache::Summary& s : it.second)
+        {
+            FunSummary summary;
+            summary.input = DenseAbstractState::fromEntries(index, s.first);
+            summary.output = s.second;
+            _funcToSummaries[it.first].push_back(summary);
+            _stat->getCachedSummaryNum()++;
+        }
+    }
+    setCachedVarPairs(varPairs);
+}
+
+void AbstractInterpretation::saveIncrementalCache()
+{
+    // the bugs in a function are not reported if the summaries of its callers are reused
+    Set<const SVFFunction*> dirtyFuns = _uncachedFuns;
+    dirtyFuns.insert(_bugFuns.begin(), _bugFuns.end());
+    for (const auto& it : _nodeToBugInfo)
+        dirtyFuns.insert(it.first->getFun());
+
+    AEIncrementalCache::FunToSummaries summaries;
+    for (const auto& it : _funcToSummaries)
+    {
+        // the callers read the return value only of the variables and stack objects of the
+        // callee and its callees, the rest are left out as they make the outputs of callers
+        // grow with the depth of the call graph
+        const NodeBS& locals = getCalleeLocals(it.first);
+        NodeID ret = _svfir->funHasRet(it.first) ? _svfir->getFunRet(it.first)->getId() : 0;
+        const DenseStateIndex& index = _funcToSummaryIndex[it.first];
+        for (const FunSummary& summary : it.second)
+        {
+            AbstractState output = summary.output.select([&](u32_t id)
+            {
+                return id == ret || !isCalleeLocal(locals, id);
+            });
+            summaries[it.first].push_back(std::make_pair(summary.input.toAbstractState(index), output));
+        }
     }
+    AEIncrementalCache::VarPairs varPairs;
+    getCachedVarPairs(varPairs);
+    if (!_incrementalCache->save(Options::AEIncremental(), summaries, dirtyFuns, varPairs))
+        SVFUtil::errs() << SVFUtil::wrnMsg("cannot write the AE cache " + Options::AEIncremental()) << "\n";
 }
 
 /// handle global node
@@ -169,6 +365,8 @@ void AbstractInterpretation::handleGlobalNode()
 {
     const ICFGNode* node = _icfg->getGlobalICFGNode();
     _abstractTrace[node] = AbstractState();
+    if (Options::AESharedTopLevel())
+        materializeNodeView(node);
     _abstractTrace[node][SymbolTableInfo::NullPtr] = AddressValue();
     // Global Node, we just need to handle addr, load, store, copy and gep
     for (const SVFStmt *stmt: node->getSVFStmts())
@@ -184,12 +382,32 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
 {
     std::vector<AbstractState> workList;
     AbstractState preAs;
+    // indices of the states passed by calls and returns in the shared top-level mode
+    Set<u32_t> interprocedural;
     for (auto& edge: icfgNode->getInEdges())
     {
         if (_abstractTrace.find(edge->getSrcNode()) != _abstractTrace.end())
         {
             const IntraCFGEdge *intraCfgEdge = SVFUtil::dyn_cast<IntraCFGEdge>(edge);
-            if (intraCfgEdge && intraCfgEdge->getCondition())
+            if (Options::AESharedTopLevel() && (SVFUtil::isa<CallCFGEdge>(edge) || SVFUtil::isa<RetCFGEdge>(edge)))
+            {
+                // a function does not access the top-level variables of its callers and callees
+                AbstractState::VarToAbsValMap refined;
+                AbstractState::AddrToAbsValMap addrs = _abstractTrace[edge->getSrcNode()].getLocToVal();
+                interprocedural.insert(workList.size());
+                workList.push_back(AbstractState(refined, addrs));
+            }
+            else if (intraCfgEdge && intraCfgEdge->getCondition() && Options::AESharedTopLevel())
+            {
+                const AbstractState& local = _abstractTrace[edge->getSrcNode()];
+                AbstractState base = getFullView(local);
+                AbstractState tmpEs = base;
+                if (isBranchFeasible(intraCfgEdge, tmpEs))
+                {
+                    workList.push_back(getLocalState(std::move(tmpEs), std::move(base), local, true));
+                }
+            }
+            else if (intraCfgEdge && intraCfgEdge->getCondition())
             {
                 AbstractState tmpEs = _abstractTrace[edge->getSrcNode()];
                 if (isBranchFeasible(intraCfgEdge, tmpEs))
@@ -217,11 +435,39 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
     }
     else
     {
+        /// a missing top-level variable has its value in _topLevelState, which subsumes
+        /// the refined ones, so only the variables refined on every in edge are kept
+        Set<u32_t> partial;
+        if (Options::AESharedTopLevel())
+        {
+            for (const AbstractState& as : workList)
+            {
+                for (const auto& item : as.getVarToVal())
+                {
+                    for (u32_t i = 0; i < workList.size(); ++i)
+                    {
+                        if (interprocedural.count(i) == 0 && workList[i].getVarToVal().count(item.first) == 0)
+                            partial.insert(item.first);
+                    }
+                }
+            }
+        }
         while (!workList.empty())
         {
             preAs.joinWith(workList.back());
             workList.pop_back();
         }
+        if (!partial.empty())
+        {
+            AbstractState::VarToAbsValMap refined;
+            for (const auto& item : preAs.getVarToVal())
+            {
+                if (partial.count(item.first) == 0)
+                    refined[item.first] = item.second;
+            }
+            AbstractState::AddrToAbsValMap addrs = preAs.getLocToVal();
+            preAs = AbstractState(refined, addrs);
+        }
         // Has ES on the in edges - Feasible block
         // update post as
         _abstractTrace[icfgNode] = preAs;
@@ -571,7 +817,13 @@ void AbstractInterpretation::handleWTOComponent(const SVF::ICFGWTOComp* wtoNode)
     if (const ICFGSingletonWTO* node = SVFUtil::dyn_cast<ICFGSingletonWTO>(wtoNode))
     {
         if (mergeStatesFromPredecessors(node->getICFGNode()))
+        {
+            if (Options::AESharedTopLevel())
+                materializeNodeView(node->getICFGNode());
             handleSingletonWTO(node);
+            if (Options::AESharedTopLevel())
+                flushNodeView(node->getICFGNode());
+        }
     }
     // Handle WTO cycles
     else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(wtoNode))
@@ -652,7 +904,11 @@ void AbstractInterpretation::recursiveCallPass(const SVF::CallICFGNode *callNode
             }
         }
     }
+    if (Options::AESharedTopLevel())
+        flushNodeView(callNode);
     _abstractTrace[retNode] = as;
+    if (Options::AESharedTopLevel())
+        materializeNodeView(callNode);
 }
 
 bool AbstractInterpretation::isDirectCall(const SVF::CallICFGNode *callNode)
@@ -666,16 +922,20 @@ void AbstractInterpretation::directCallFunPass(const SVF::CallICFGNode *callNode
     const SVFFunction *callfun = SVFUtil::getCallee(callNode->getCallSite());
     _callSiteStack.push_back(callNode);
 
+    // the callee reads the local state of the call at its entry
+    if (Options::AESharedTopLevel())
+        flushNodeView(callNode);
     _abstractTrace[callNode] = as;
 
-    ICFGWTO* wto = _funcToWTO[callfun];
-    handleWTOComponents(wto->getWTOComponents());
+    handleCallee(callfun);
 
     _callSiteStack.pop_back();
     // handle Ret node
     const RetICFGNode *retNode = callNode->getRetICFGNode();
     // resume ES to callnode
     _abstractTrace[retNode] = _abstractTrace[callNode];
+    if (Options::AESharedTopLevel())
+        materializeNodeView(callNode);
 }
 
 bool AbstractInterpretation::isIndirectCall(const SVF::CallICFGNode *callNode)
@@ -700,40 +960,410 @@ void AbstractInterpretation::indirectCallFunPass(const SVF::CallICFGNode *callNo
     if (callfun)
     {
         _callSiteStack.push_back(callNode);
+        if (Options::AESharedTopLevel())
+            flushNodeView(callNode);
         _abstractTrace[callNode] = as;
 
-        ICFGWTO* wto = _funcToWTO[callfun];
-        handleWTOComponents(wto->getWTOComponents());
+        handleCallee(callfun);
         _callSiteStack.pop_back();
         // handle Ret node
         const RetICFGNode *retNode = callNode->getRetICFGNode();
         _abstractTrace[retNode] = _abstractTrace[callNode];
+        if (Options::AESharedTopLevel())
+            materializeNodeView(callNode);
     }
 }
 
 
+/**
+ * @brief Analyse a callee, or reuse one of its summaries (-ae-summary or -ae-incremental)
+ *
+ * A summary records the entries of the abstract state the callee accessed, with their values
+ * at the entry (input) and at the exit (output). The output is the entries of the exit state
+ * not shared with the entry state. The input is the entries the callee updated or read, where
+ * the reads are recorded by AbstractState::setReadRecorder, as read-only accesses leave the
+ * entries shared. Variables and stack objects of the callee and its callees are defined before
+ * they are used, so they are left out of the input. A summary is reused if the entry state is
+ * contained within its input on these entries, its output then overwrites the entry state to
+ * give the exit state, and its input entries count as reads of the caller. Inputs are dense
+ * states over the slots of the callee, so the entry state is looked up once per call and
+ * matched against each input by a scan. At most Options::AESummaryLimit() summaries are kept
+ * per callee. Summaries are not used in the shared top-level mode, where the states miss the
+ * top-level variables.
+ */
+void AbstractInterpretation::handleCallee(const SVFFunction* callee)
+{
+    ICFGWTO* wto = _funcToWTO[callee];
+    const ICFGNode* entry = _icfg->getFunEntryICFGNode(callee);
+    const ICFGNode* exit = _icfg->getFunExitICFGNode(callee);
+    if ((!Options::AESummary() && Options::AEIncremental().empty()) || Options::AESharedTopLevel() ||
+            !mergeStatesFromPredecessors(entry))
+    {
+        handleWTOComponents(wto->getWTOComponents());
+        return;
+    }
+
+    const AbstractState input = _abstractTrace[entry];
+    std::vector<FunSummary>& summaries = _funcToSummaries[callee];
+    DenseStateIndex& index = _funcToSummaryIndex[callee];
+    /// the input at the slots of all summaries, each summary is then checked by a scan
+    const DenseAbstractState denseInput(index, input);
+    for (auto it = summaries.rbegin(); it != summaries.rend(); ++it)
+    {
+        if (denseInput.containedWithinAt(it->input))
+        {
+            if (AbstractState::ReadSet* reads = AbstractState::getReadRecorder())
+            {
+                for (u32_t slot = 0; slot < it->input.size(); ++slot)
+                {
+                    if (it->input.isDefined(slot))
+                        (index.isAddr(slot) ? reads->addrs : reads->vars).set(index.getID(slot));
+                }
+            }
+            AbstractState exitState = input;
+            exitState.updateWith(it->output);
+            _abstractTrace[exit] = exitState;
+            _stat->getSummaryReuse()++;
+            return;
+        }
+    }
+
+    /// the exit state of an earlier call is kept if the exit is unreachable
+    AbstractState staleExit;
+    auto eit = _abstractTrace.find(exit);
+    bool hadExit = eit != _abstractTrace.end();
+    if (hadExit)
+    {
+        staleExit = eit->second;
+        _abstractTrace.erase(eit);
+    }
+    AbstractState::ReadSet reads;
+    AbstractState::ReadSet* callerReads = AbstractState::setReadRecorder(&reads);
+    handleWTOComponents(wto->getWTOComponents());
+    AbstractState::setReadRecorder(callerReads);
+    if (callerReads)
+    {
+        callerReads->vars |= reads.vars;
+        callerReads->addrs |= reads.addrs;
+    }
+    eit = _abstractTrace.find(exit);
+    if (eit == _abstractTrace.end())
+    {
+        if (hadExit)
+            _abstractTrace[exit] = staleExit;
+        return;
+    }
+
+    const NodeBS& locals = getCalleeLocals(callee);
+    FunSummary summary;
+    summary.output = eit->second.updatedSince(input);
+    AbstractState keys = summary.output;
+    for (u32_t id : reads.vars)
+        keys[id];
+    for (u32_t id : reads.addrs)
+        keys.load(AbstractState::getVirtualMemAddress(id));
+    summary.input = DenseAbstractState::fromEntries(index, input.projectTo(keys.select([&](u32_t id)
+    {
+        return !isCalleeLocal(locals, id);
+    })));
+    /// drop the summaries of smaller inputs
+    summaries.erase(std::remove_if(summaries.begin(), summaries.end(), [&](const FunSummary& s)
+    {
+        return s.input.containedWithin(summary.input);
+    }), summaries.end());
+    if (Options::AESummaryLimit() > 0 && summaries.size() >= Options::AESummaryLimit())
+        summaries.erase(summaries.begin(), summaries.begin() + (summaries.size() - Options::AESummaryLimit() + 1));
+    summaries.push_back(summary);
+    _stat->getSummaryNum()++;
+}
+
+/// Whether id is a variable or stack object of locals, or a field of such an object
+bool AbstractInterpretation::isCalleeLocal(const NodeBS& locals, NodeID id) const
+{
+    if (locals.test(id))
+        return true;
+    return _svfir->hasGNode(id) && SVFUtil::isa<ObjVar>(_svfir->getGNode(id)) &&
+           locals.test(_svfir->getBaseObjVar(id));
+}
+
+/// Variables and stack objects defined in a function and its callees
+const NodeBS& AbstractInterpretation::getCalleeLocals(const SVFFunction* fun)
+{
+    auto it = _funcToCalleeLocals.find(fun);
+    if (it != _funcToCalleeLocals.end())
+        return it->second;
+
+    if (_funcToLocals.empty())
+    {
+        for (ICFG::const_iterator nit = _icfg->begin(), neit = _icfg->end(); nit != neit; ++nit)
+        {
+            const ICFGNode* node = nit->second;
+            if (node->getFun() == nullptr)
+                continue;
+            NodeBS& locals = _funcToLocals[node->getFun()];
+            for (const SVFStmt* stmt : node->getSVFStmts())
+            {
+                if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(stmt))
+                {
+                    if (_svfir->getBaseObj(addr->getRHSVarID())->isStack())
+                        locals.set(addr->getRHSVarID());
+                }
+                if (SVFUtil::isa<StoreStmt>(stmt))
+                    continue;
+                if (const AssignStmt* assign = SVFUtil::dyn_cast<AssignStmt>(stmt))
+                    locals.set(assign->getLHSVarID());
+                else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+                    locals.set(multi->getResID());
+            }
+        }
+    }
+
+    CallGraph* callGraph = AndersenWaveDiff::createAndersenWaveDiff(_svfir)->getCallGraph();
+    NodeBS& locals = _funcToCalleeLocals[fun];
+    FIFOWorkList<const SVFFunction*> worklist;
+    Set<const SVFFunction*> visited;
+    worklist.push(fun);
+    visited.insert(fun);
+    while (!worklist.empty())
+    {
+        const SVFFunction* cur = worklist.pop();
+        locals |= _funcToLocals[cur];
+        for (const CallGraphEdge* edge : callGraph->getCallGraphNode(cur)->getOutEdges())
+        {
+            const SVFFunction* callee = edge->getDstNode()->getFunction();
+            if (visited.insert(callee).second)
+                worklist.push(callee);
+        }
+    }
+    return locals;
+}
+
+/**
+ * @brief Shared top-level values (-ae-shared-top-level)
+ *
+ * A top-level variable is defined once and its value only flows from the definition to the
+ * uses, so it is kept in _topLevelState rather than in the states of all the nodes in between.
+ * The state of a node keeps the address-taken objects, whose values are strongly updated along
+ * the ICFG, and the top-level variables refined by the branches on the way to the node. A node
+ * is handled on a view of its state with all top-level variables, then the variables it defined
+ * are moved to _topLevelState, i.e., to their uses.
+ * This is not a sparse analysis: every node is still handled in WTO order, only the copies of
+ * the top-level variables along the ICFG are saved.
+ */
+void AbstractInterpretation::materializeNodeView(const ICFGNode* node)
+{
+    const ICFGNode* repNode = _icfg->getRepNode(node);
+    // the node calling a function is flushed before handling the callee
+    assert(_viewNode == nullptr && "another node is materialized");
+    AbstractState& as = _abstractTrace[repNode];
+    // a definition at this node kills the refined value of the variable
+    AbstractState::VarToAbsValMap refined;
+    for (const auto& item : as.getVarToVal())
+    {
+        if (!isDefinedAt(item.first, repNode))
+            refined[item.first] = item.second;
+    }
+    AbstractState::AddrToAbsValMap addrs = as.getLocToVal();
+    _localState = AbstractState(refined, addrs);
+    as = getFullView(_localState);
+    _viewNode = repNode;
+    _viewBase = as;
+}
+
+void AbstractInterpretation::flushNodeView(const ICFGNode* node)
+{
+    const ICFGNode* repNode = _icfg->getRepNode(node);
+    if (_viewNode != repNode)
+        return;
+    AbstractState& as = _abstractTrace[repNode];
+    as = getLocalState(std::move(as), std::move(_viewBase), _localState, false);
+    _localState = AbstractState();
+    _viewNode = nullptr;
+}
+
+AbstractState AbstractInterpretation::getFullView(const AbstractState& local)
+{
+    AbstractState::VarToAbsValMap vars = _topLevelState.getVarToVal();
+    for (const auto& item : local.getVarToVal())
+        vars[item.first] = item.second;
+    AbstractState::AddrToAbsValMap addrs = local.getLocToVal();
+    return AbstractState(vars, addrs);
+}
+
+AbstractState AbstractInterpretation::getLocalState(AbstractState&& view, AbstractState&& base,
+        const AbstractState& local, bool refine)
+{
+    AbstractState::VarToAbsValMap refined = local.getVarToVal();
+    std::vector<std::pair<u32_t, AbstractValue>> updated;
+    view.getVarToVal().forEachUpdated(base.getVarToVal(), [&](u32_t id, const AbstractValue& val)
+    {
+        updated.emplace_back(id, val);
+    });
+    AbstractState::AddrToAbsValMap addrs = view.getLocToVal();
+    // without other copies, _topLevelState is updated in place
+    view = AbstractState();
+    base = AbstractState();
+    for (const auto& item : updated)
+    {
+        if (refine || refined.count(item.first))
+            refined[item.first] = item.second;
+        else
+            _topLevelState[item.first] = item.second;
+    }
+    // a refined value equal to the one of its definition is redundant
+    AbstractState::VarToAbsValMap vars;
+    const AbstractState::VarToAbsValMap& topLevel = _topLevelState.getVarToVal();
+    for (const auto& item : refined)
+    {
+        auto it = topLevel.find(item.first);
+        if (it == topLevel.end() || !it->second.equals(item.second))
+            vars[item.first] = item.second;
+    }
+    return AbstractState(vars, addrs);
+}
+
+bool AbstractInterpretation::widenTopLevelState(const AbstractState& prev, bool widen,
+        const std::vector<s64_t>& thresholds)
+{
+    bool stable = true;
+    AbstractState updated = _topLevelState.updatedSince(prev);
+    const AbstractState::VarToAbsValMap& prevVals = prev.getVarToVal();
+    for (const auto& item : updated.getVarToVal())
+    {
+        auto it = prevVals.find(item.first);
+        if (it == prevVals.end())
+        {
+            stable = false;
+            continue;
+        }
+        AbstractValue val = it->second;
+        if (widen)
+            val.widen_with(item.second, thresholds);
+        else
+            val.narrow_with(item.second, thresholds);
+        if (!val.equals(it->second))
+            stable = false;
+        _topLevelState[item.first] = val;
+    }
+    return stable;
+}
+
+/// Whether a statement of the node assigns the variable
+bool AbstractInterpretation::isDefinedAt(NodeID id, const ICFGNode* repNode) const
+{
+    for (const ICFGNode* node : _icfg->getSubNodes(repNode))
+    {
+        for (const SVFStmt* stmt : node->getSVFStmts())
+        {
+            if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(stmt))
+            {
+                if (addr->getLHSVarID() == id || addr->getRHSVarID() == id)
+                    return true;
+            }
+            else if (const AssignStmt* assign = SVFUtil::dyn_cast<AssignStmt>(stmt))
+            {
+                if (!SVFUtil::isa<StoreStmt>(stmt) && assign->getLHSVarID() == id)
+                    return true;
+            }
+            else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+            {
+                if (multi->getResID() == id)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// Constants compared in a function, each with its neighbours so that both strict and
+/// non-strict comparisons against it yield a threshold
+const std::vector<s64_t>& AbstractInterpretation::getWidenThresholds(const SVFFunction* fun)
+{
+    auto it = _funcToThresholds.find(fun);
+    if (it != _funcToThresholds.end())
+        return it->second;
+
+    std::vector<s64_t>& thresholds = _funcToThresholds[fun];
+    for (const SVFBasicBlock* block : fun->getBasicBlockList())
+    {
+        for (const SVFInstruction* inst : block->getInstructionList())
+        {
+            for (const SVFStmt* stmt : _icfg->getICFGNode(inst)->getSVFStmts())
+            {
+                const CmpStmt* cmp = SVFUtil::dyn_cast<CmpStmt>(stmt);
+                if (!cmp)
+                    continue;
+                for (const SVFVar* opnd : {cmp->getOpVar(0), cmp->getOpVar(1)})
+                {
+                    if (!opnd->hasValue())
+                        continue;
+                    if (const SVFConstantInt* k = SVFUtil::dyn_cast<SVFConstantInt>(opnd->getValue()))
+                    {
+                        s64_t v = k->getSExtValue();
+                        thresholds.push_back(v);
+                        if (v > std::numeric_limits<s64_t>::min())
+                            thresholds.push_back(v - 1);
+                        if (v < std::numeric_limits<s64_t>::max())
+                            thresholds.push_back(v + 1);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+    return thresholds;
+}
+
+/// The widen delay, or the trip count of the loop headed by the node plus one
+/// if it is at most -ae-exact-loop-iter, so that the loop is iterated exactly
+u32_t AbstractInterpretation::getWidenDelay(const ICFGNode* cycleHead)
+{
+    u32_t delay = Options::WidenDelay();
+    if (Options::AEExactLoopIter() == 0 || !_icfg->isInLoop(cycleHead))
+        return delay;
+    for (const SVFLoop* loop : _icfg->getSVFLoops(cycleHead))
+    {
+        for (const ICFGEdge* edge : cycleHead->getInEdges())
+        {
+            if (loop->isBackICFGEdge(edge) && loop->getLoopBound() <= Options::AEExactLoopIter())
+            {
+                delay = std::max(delay, loop->getLoopBound() + 1);
+                break;
+            }
+        }
+    }
+    return delay;
+}
 
 /// handle wto cycle (loop)
 void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
 {
     const ICFGNode* cycle_head = cycle->head()->getICFGNode();
+    const u32_t widenDelay = getWidenDelay(cycle_head);
+    static const std::vector<s64_t> noThresholds;
+    const std::vector<s64_t>& thresholds = Options::AEWidenThresholds() ?
+                                           getWidenThresholds(cycle_head->getFun()) : noThresholds;
     // Flag to indicate if we are in the increasing phase
     bool increasing = true;
     // Infinite loop until a fixpoint is reached,
     for (u32_t cur_iter = 0;; cur_iter++)
     {
         // Start widening or narrowing if cur_iter >= widen threshold (widen delay)
-        if (cur_iter >= Options::WidenDelay())
+        if (cur_iter >= widenDelay)
         {
             // Widen or narrow after processing cycle head node
             AbstractState prev_head_state = _abstractTrace[cycle_head];
+            // in the shared top-level mode, the top-level variables updated by the head are widened too
+            const AbstractState prev_top_level_state = _topLevelState;
             handleWTOComponent(cycle->head());
             AbstractState cur_head_state = _abstractTrace[cycle_head];
             if (increasing)
             {
                 // Widening phase
-                _abstractTrace[cycle_head] = prev_head_state.widening(cur_head_state);
-                if (_abstractTrace[cycle_head] == prev_head_state)
+                _abstractTrace[cycle_head] = prev_head_state.widening(cur_head_state, thresholds);
+                bool topLevelStable = !Options::AESharedTopLevel() || widenTopLevelState(prev_top_level_state, true, thresholds);
+                if (_abstractTrace[cycle_head] == prev_head_state && topLevelStable)
                 {
                     increasing = false;
                     continue;
@@ -742,10 +1372,12 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
             else
             {
                 // Widening's fixpoint reached in the widening phase, switch to narrowing
-                _abstractTrace[cycle_head] = prev_head_state.narrowing(cur_head_state);
-                if (_abstractTrace[cycle_head] == prev_head_state)
+                _abstractTrace[cycle_head] = prev_head_state.narrowing(cur_head_state, thresholds);
+                bool topLevelStable = !Options::AESharedTopLevel() || widenTopLevelState(prev_top_level_state, false, thresholds);
+                if (_abstractTrace[cycle_head] == prev_head_state && topLevelStable)
                 {
                     // Narrowing's fixpoint reached in the narrowing phase, exit loop
+                    _stat->cycleIterNum[cycle_head] += cur_iter + 1;
                     break;
                 }
             }
@@ -753,7 +1385,11 @@ void AbstractInterpretation::handleCycleWTO(const ICFGCycleWTO*cycle)
         else
         {
             // Handle the cycle head
+            if (Options::AESharedTopLevel())
+                materializeNodeView(cycle_head);
             handleSingletonWTO(cycle->head());
+            if (Options::AESharedTopLevel())
+                flushNodeView(cycle_head);
         }
         // Handle the cycle body
         handleWTOComponents(cycle->getWTOComponents());
@@ -928,6 +1564,16 @@ void AEStat::finializeStat()
     generalNumMap["EXT_CallSite_Num"] = extCallSiteNum;
     generalNumMap["NonEXT_CallSite_Num"] = callSiteNum;
     generalNumMap["Bug_Num"] = _ae->_nodeToBugInfo.size();
+    u32_t cycleIterMax = 0;
+    u32_t cycleIterTotal = 0;
+    for (const auto& it : cycleIterNum)
+    {
+        cycleIterMax = std::max(cycleIterMax, it.second);
+        cycleIterTotal += it.second;
+    }
+    generalNumMap["Cycle_Num"] = cycleIterNum.size();
+    generalNumMap["Cycle_Iter_Num"] = cycleIterTotal;
+    generalNumMap["Cycle_Iter_Max"] = cycleIterMax;
     timeStatMap["Total_Time(sec)"] = (double)(endTime - startTime) / TIMEINTERVAL;
 
 }
@@ -986,10 +1632,18 @@ void AEStat::reportBug()
     f << "######################Full Overflow (" + std::to_string(_ae->_nodeToBugInfo.size()) + " found)######################\n";
     std::cerr << "---------------------------------------------\n";
     f << "---------------------------------------------\n";
+    // in the order of nodes, reports do not depend on addresses or the schedule of workers
+    std::vector<const ICFGNode*> nodes;
     for (auto& it: _ae->_nodeToBugInfo)
+        nodes.push_back(it.first);
+    std::sort(nodes.begin(), nodes.end(), [](const ICFGNode* a, const ICFGNode* b)
+    {
+        return a->getId() < b->getId();
+    });
+    for (const ICFGNode* node: nodes)
     {
-        std::cerr << it.second << "\n---------------------------------------------\n";
-        f << it.second << "\n---------------------------------------------\n";
+        std::cerr << _ae->_nodeToBugInfo[node] << "\n---------------------------------------------\n";
+        f << _ae->_nodeToBugInfo[node] << "\n---------------------------------------------\n";
     }
 }
 
@@ -1732,7 +2386,10 @@ void AbstractInterpretation::updateStateOnPhi(const PhiStmt *phi)
         if (hasAbsStateFromTrace(opICFGNode))
         {
             AbstractState& opAs = getAbsStateFromTrace(opICFGNode);
-            rhs.join_with(opAs[curId]);
+            if (Options::AESharedTopLevel() && opAs.getVarToVal().count(curId) == 0)
+                rhs.join_with(_topLevelState[curId]);
+            else
+                rhs.join_with(opAs[curId]);
         }
     }
     as[res] = rhs;
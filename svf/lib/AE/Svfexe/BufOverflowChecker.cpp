@@ -811,6 +811,13 @@ void BufOverflowChecker::addBugToRecoder(const BufOverflowException& e, const IC
         eventStack.push_back(callSiteEvent);
     }
     eventStack.push_back(sourceInstEvent);
+    recordBug(e, node, eventStack);
+}
+
+void BufOverflowChecker::recordBug(const BufOverflowException& e, const ICFGNode* node,
+                                   const GenericBug::EventStack& eventStack)
+{
+    _bugFuns.insert(node->getFun());
     if (eventStack.size() == 0) return;
     std::string loc = eventStack.back().getEventLoc();
     if (_bugLoc.find(loc) != _bugLoc.end())
@@ -824,6 +831,35 @@ void BufOverflowChecker::addBugToRecoder(const BufOverflowException& e, const IC
     _recoder.addAbsExecBug(GenericBug::FULLBUFOVERFLOW, eventStack, e.getAllocLb(), e.getAllocUb(), e.getAccessLb(),
                            e.getAccessUb());
     _nodeToBugInfo[node] = e.what();
+    _bugRecords.push_back(BugRecord{e, node, eventStack});
+}
+
+void BufOverflowChecker::mergeWorker(AbstractInterpretation* worker)
+{
+    AbstractInterpretation::mergeWorker(worker);
+    BufOverflowChecker* checker = SVFUtil::cast<BufOverflowChecker>(worker);
+    for (const auto& it : checker->_addrToGep)
+        _addrToGep.emplace(it.first, it.second);
+    // bugs at reported locations are dropped as if the worker ran after this analysis
+    for (const BugRecord& bug : checker->_bugRecords)
+        recordBug(bug.exception, bug.node, bug.eventStack);
+}
+
+void BufOverflowChecker::getCachedVarPairs(AEIncrementalCache::VarPairs& varPairs) const
+{
+    for (const auto& it : _addrToGep)
+        varPairs.push_back(std::make_pair(it.first, it.second->getLHSVarID()));
+}
+
+void BufOverflowChecker::setCachedVarPairs(const AEIncrementalCache::VarPairs& varPairs)
+{
+    // the objects of the functions analysed again are mapped again by their gep statements
+    for (const auto& pair : varPairs)
+    {
+        const SVFVar* lhs = _svfir->getGNode(pair.second);
+        if (lhs->hasIncomingEdges(SVFStmt::Gep))
+            _addrToGep[pair.first] = SVFUtil::cast<GepStmt>(*lhs->getIncomingEdgesBegin(SVFStmt::Gep));
+    }
 }
 
 }
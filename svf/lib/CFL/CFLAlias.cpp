@@ -207,7 +207,10 @@ void CFLAlias::initialize()
 
 void CFLAlias::initializeSolver()
 {
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLThreads() > 1)
+        solver = new ParallelCFLSolver(graph, grammar, Options::CFLThreads());
+    else
+        solver = new CFLSolver(graph, grammar);
 }
 
 void CFLAlias::finalize()
@@ -230,7 +233,17 @@ void CFLAlias::solve()
     // Start solving
     double start = stat->getClk(true);
 
+    /// Only derive from the edges not solved by an earlier run or summarized
+    bool loaded = !Options::CFLSolvedFile().empty() && solver->loadSolvedEdges(Options::CFLSolvedFile());
+    if (!loaded && Options::CFLSummary())
+        summarizeFunctions();
+
     solver->solve();
+    /// Saved before the call graph is updated, which adds dummy nodes for the indirect calls
+    /// on the fly. The edges solved so far are over the nodes of the graph as built, so a
+    /// later run on the same graph can load them, and then resolves the indirect calls again.
+    if (!Options::CFLSolvedFile().empty())
+        solver->saveSolvedEdges(Options::CFLSolvedFile());
     if (Options::CFLGraph().empty())
     {
         while (updateCallGraph(svfir->getIndirectCallsites()))
@@ -244,6 +257,19 @@ void CFLAlias::solve()
     timeOfSolving += (end - start) / TIMEINTERVAL;
 }
 
+void CFLAlias::getNodeFunctions(CFLSummary::NodeToFunMap& nodeToFun)
+{
+    if (!Options::CFLGraph().empty())
+        return;
+    for (CFLGraph::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        if (!svfir->hasGNode(it->first))
+            continue;
+        if (const SVFFunction* fun = svfir->getGNode(it->first)->getFunction())
+            nodeToFun[it->first] = fun;
+    }
+}
+
 void POCRAlias::initializeSolver()
 {
     solver = new POCRSolver(graph, grammar);
@@ -253,3 +279,8 @@ void POCRHybrid::initializeSolver()
 {
     solver = new POCRHybridSolver(graph, grammar);
 }
+
+void MatrixCFLAlias::initializeSolver()
+{
+    solver = new MatrixCFLSolver(graph, grammar);
+}
@@ -45,6 +45,9 @@ double CFLBase::numOfNonterminalEdges = 0;
 double CFLBase::numOfStartEdges = 0;
 double CFLBase::numOfIteration = 1;
 double CFLBase::numOfChecks = 1;
+double CFLBase::numOfSummarizedFuns = 0;
+double CFLBase::numOfReusedSummaries = 0;
+double CFLBase::timeOfSummaries = 0;
 
 void CFLBase::checkParameter()
 {
@@ -120,12 +123,46 @@ void CFLBase::solve()
     // Start solving
     double start = stat->getClk(true);
 
+    /// Only derive from the edges not solved by an earlier run or summarized
+    bool loaded = !Options::CFLSolvedFile().empty() && solver->loadSolvedEdges(Options::CFLSolvedFile());
+    if (!loaded && Options::CFLSummary())
+        summarizeFunctions();
+
     solver->solve();
+    if (!Options::CFLSolvedFile().empty())
+        solver->saveSolvedEdges(Options::CFLSolvedFile());
 
     double end = stat->getClk(true);
     timeOfSolving += (end - start) / TIMEINTERVAL;
 }
 
+/*!
+ * The summaries of functions are the fixpoints of their intra-procedural subgraphs,
+ * and the union of them is closed under the grammar
+ */
+void CFLBase::summarizeFunctions()
+{
+    if (!solver->isIncremental())
+        return;
+    double start = stat->getClk(true);
+
+    CFLSummary::NodeToFunMap nodeToFun;
+    getNodeFunctions(nodeToFun);
+    CFLSummary summary(graph, grammar, nodeToFun);
+    if (!Options::CFLSummaryFile().empty())
+        summary.load(Options::CFLSummaryFile());
+    CFLSolver::SolvedEdges edges;
+    summary.summarize(edges);
+    solver->addSolvedEdges(edges);
+    if (!Options::CFLSummaryFile().empty())
+        summary.save(Options::CFLSummaryFile());
+    numOfSummarizedFuns = summary.getNumOfSummarizedFuns();
+    numOfReusedSummaries = summary.getNumOfReusedFuns();
+
+    double end = stat->getClk(true);
+    timeOfSummaries += (end - start) / TIMEINTERVAL;
+}
+
 void CFLBase::finalize()
 {
     numOfChecks = solver->numOfChecks;
@@ -149,7 +186,7 @@ CFLGraph* CFLBase::getCFLGraph()
 
 void CFLBase::countSumEdges()
 {
-    numOfStartEdges = 0;
+    numOfStartEdges = getCFLGraph()->getDerivedEdgeNum(grammar->getStartKind());
     for(auto it = getCFLGraph()->getCFLEdges().begin(); it != getCFLGraph()->getCFLEdges().end(); it++ )
     {
         if ((*it)->getEdgeKind() == grammar->getStartKind())
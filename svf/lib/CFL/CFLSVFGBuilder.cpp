@@ -37,6 +37,8 @@ void CFLSVFGBuilder::buildSVFG()
 
     MemSSA* mssa = svfg->getMSSA();
     svfg->buildSVFG();
+    /// The steps below and the CFL analysis traverse indirect edges directly
+    svfg->materializeAllFunctions();
     BVDataPTAImpl* pta = mssa->getPTA();
     DBOUT(DGENERAL, outs() << pasMsg("\tCollect Global Variables\n"));
 
@@ -28,11 +28,39 @@
  */
 
 #include "CFL/CFLSolver.h"
+#include "Util/SVFUtil.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
 
 using namespace SVF;
 
 double CFLSolver::numOfChecks = 0;
 
+namespace
+{
+
+/// A file of solved edges is a Header, numInputs EdgeRecords (input edges of the solved graph)
+/// and numSolved EdgeRecords (all edges of the solved graph, sorted)
+static const u32_t SolvedFileVersion = 1;
+static const char SolvedFileMagic[8] = {'S', 'V', 'F', 'C', 'F', 'L', 'R', '\0'};
+
+struct Header
+{
+    char magic[8];
+    u32_t version;
+    u32_t reserved;
+    u64_t numInputs;
+    u64_t numSolved;
+};
+
+typedef CFLSolver::SolvedEdge EdgeRecord;
+
+} // End anonymous namespace
+
 void CFLSolver::initialize()
 {
     for(auto it = graph->begin(); it!= graph->end(); it++)
@@ -118,8 +146,12 @@ void CFLSolver::processCFLEdge(const CFLEdge* Y_edge)
 
 void CFLSolver::solve()
 {
-    /// initial worklist
-    initialize();
+    /// initial worklist, later solves only process the edges pushed since
+    if (!solved || !isIncremental())
+    {
+        recordInputEdges();
+        initialize();
+    }
 
     while(!isWorklistEmpty())
     {
@@ -127,6 +159,144 @@ void CFLSolver::solve()
         const CFLEdge* Y_edge = popFromWorklist();
         processCFLEdge(Y_edge);
     }
+    solved = true;
+}
+
+void CFLSolver::recordInputEdges()
+{
+    if (inputRecorded)
+        return;
+    inputRecorded = true;
+    for (const CFLEdge* edge : graph->getCFLEdges())
+        inputEdges.emplace_back(edge->getSrcID(), edge->getDstID(), edge->getEdgeKind());
+}
+
+/*!
+ * The edges solved from a subgraph of the graph are all in the fixpoint of the graph, since
+ * CFL-reachability is monotone. Starting from them, only the edges of the graph that were not
+ * solved (e.g., inserted by a program change) have to be processed.
+ */
+bool CFLSolver::loadSolvedEdges(const std::string& filename)
+{
+    if (solved || !isIncremental())
+        return false;
+
+    std::ifstream F(filename, std::ios::binary | std::ios::ate);
+    if (!F.is_open())
+        return false;
+    u64_t size = F.tellg();
+    F.seekg(0);
+    Header h;
+    /// the record counts are checked against the file size without overflowing
+    u64_t numRecords = size >= sizeof(Header) ? (size - sizeof(Header)) / sizeof(EdgeRecord) : 0;
+    if (size < sizeof(Header) || !F.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+            !std::equal(std::begin(SolvedFileMagic), std::end(SolvedFileMagic), h.magic) || h.version != SolvedFileVersion ||
+            (size - sizeof(Header)) % sizeof(EdgeRecord) != 0 || h.numInputs > numRecords ||
+            h.numSolved != numRecords - h.numInputs)
+    {
+        SVFUtil::writeWrnMsg("invalid solved CFL edges in " + filename);
+        return false;
+    }
+    std::vector<EdgeRecord> oldInputs(h.numInputs);
+    std::vector<EdgeRecord> oldSolved(h.numSolved);
+    F.read(reinterpret_cast<char*>(oldInputs.data()), h.numInputs * sizeof(EdgeRecord));
+    F.read(reinterpret_cast<char*>(oldSolved.data()), h.numSolved * sizeof(EdgeRecord));
+    if (!F)
+        return false;
+
+    recordInputEdges();
+    for (const EdgeRecord& rec : oldInputs)
+    {
+        if (!graph->hasGNode(rec.src) || !graph->hasGNode(rec.dst) || !graph->hasEdge(rec.src, rec.dst, rec.label))
+        {
+            SVFUtil::writeWrnMsg("solved CFL edges in " + filename + " do not fit the graph, solving from scratch");
+            return false;
+        }
+    }
+    if (!addSolvedEdges(oldSolved))
+    {
+        SVFUtil::writeWrnMsg("solved CFL edges in " + filename + " do not fit the graph, solving from scratch");
+        return false;
+    }
+    return true;
+}
+
+bool CFLSolver::addSolvedEdges(const SolvedEdges& edges)
+{
+    if (solved || !isIncremental())
+        return false;
+    for (const SolvedEdge& edge : edges)
+    {
+        if (!graph->hasGNode(edge.src) || !graph->hasGNode(edge.dst))
+            return false;
+    }
+
+    recordInputEdges();
+    for (const SolvedEdge& edge : edges)
+        addSolvedEdge(edge.src, edge.dst, edge.label);
+
+    /// Edges of the graph not yet solved
+    for (const CFLEdge* edge : graph->getCFLEdges())
+    {
+        SolvedEdge rec = {edge->getSrcID(), edge->getDstID(), (CFLEdge::GEdgeFlag) edge->getEdgeKind()};
+        if (!std::binary_search(edges.begin(), edges.end(), rec))
+            pushIntoWorklist(edge);
+    }
+    for (const Production& prod : grammar->getEpsilonProds())
+    {
+        Symbol X = grammar->getLHSSymbol(prod);
+        for (auto it = graph->begin(); it != graph->end(); it++)
+        {
+            CFLNode* i = (*it).second;
+            if (graph->hasEdge(i->getId(), i->getId(), X))
+                continue;
+            if (const CFLEdge* edge = graph->addCFLEdge(i, i, X))
+                pushIntoWorklist(edge);
+        }
+    }
+    solved = true;
+    return true;
+}
+
+bool CFLSolver::saveSolvedEdges(const std::string& filename)
+{
+    recordInputEdges();
+    std::vector<EdgeRecord> inputs;
+    for (const std::tuple<NodeID, NodeID, CFLEdge::GEdgeFlag>& edge : inputEdges)
+        inputs.push_back({std::get<0>(edge), std::get<1>(edge), std::get<2>(edge)});
+    std::vector<EdgeRecord> edges;
+    for (const CFLEdge* edge : graph->getCFLEdges())
+        edges.push_back({edge->getSrcID(), edge->getDstID(), (CFLEdge::GEdgeFlag) edge->getEdgeKind()});
+    for (const auto& succs : graph->getDerivedSuccs())
+        for (const auto& labelSuccs : succs.second)
+            for (NodeID dst : labelSuccs.second)
+                edges.push_back({succs.first, dst, labelSuccs.first});
+    std::sort(edges.begin(), edges.end());
+
+    Header h;
+    std::copy(std::begin(SolvedFileMagic), std::end(SolvedFileMagic), h.magic);
+    h.version = SolvedFileVersion;
+    h.reserved = 0;
+    h.numInputs = inputs.size();
+    h.numSolved = edges.size();
+
+    std::string tmpName = filename + ".tmp";
+    std::ofstream F(tmpName, std::ios::binary | std::ios::trunc);
+    if (!F.is_open())
+    {
+        SVFUtil::writeWrnMsg("failed to write solved CFL edges " + filename);
+        return false;
+    }
+    F.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    F.write(reinterpret_cast<const char*>(inputs.data()), inputs.size() * sizeof(EdgeRecord));
+    F.write(reinterpret_cast<const char*>(edges.data()), edges.size() * sizeof(EdgeRecord));
+    F.close();
+    if (F.fail() || std::rename(tmpName.c_str(), filename.c_str()) != 0)
+    {
+        SVFUtil::writeWrnMsg("failed to write solved CFL edges " + filename);
+        return false;
+    }
+    return true;
 }
 
 void POCRSolver::buildCFLData()
@@ -378,4 +548,508 @@ void POCRHybridSolver::meld_h(NodeID x, TreeNode* uNode, TreeNode* vNode)
     {
         meld_h(x, newVNode, vChild);
     }
-}
\ No newline at end of file
+}
+
+ParallelCFLSolver::ParallelCFLSolver(CFLGraph* _graph, CFGrammar* _grammar, u32_t threads)
+    : CFLSolver(_graph, _grammar), numThreads(std::max(threads, 1U)), numShards(numThreads * 4),
+      predShards(numShards)
+{
+}
+
+void ParallelCFLSolver::solve()
+{
+    /// initial worklist, later solves only process the edges pushed since
+    if (!solved)
+    {
+        recordInputEdges();
+        initialize();
+    }
+    /// so that the threads only modify the derived edges of existing nodes
+    graph->initDerivedSuccs();
+
+    /// Edges of the graph (or pushed by clients) not yet derived form the first round
+    Edges delta;
+    while(!isWorklistEmpty())
+    {
+        const CFLEdge* edge = popFromWorklist();
+        Edge e = {edge->getSrcID(), edge->getDstID(), (u32_t) edge->getEdgeKind()};
+        const NodeBS* succs = getDerivedSuccs(e.src, e.label);
+        if (!succs || !succs->test(e.dst))
+            delta.push_back(e);
+    }
+
+    while(!delta.empty())
+    {
+        Edges newDelta;
+        solveRound(delta, newDelta);
+        delta.swap(newDelta);
+    }
+    solved = true;
+}
+
+void ParallelCFLSolver::addSolvedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+{
+    if (graph->addDerivedEdge(src, dst, label))
+        addDerivedPred({src, dst, (u32_t) label});
+}
+
+const NodeBS* ParallelCFLSolver::getDerivedSuccs(NodeID src, u32_t label) const
+{
+    const CFLGraph::LabelToNodesMap* succs = graph->getDerivedSuccs(src);
+    if (succs == nullptr)
+        return nullptr;
+    CFLGraph::LabelToNodesMap::const_iterator lit = succs->find(label);
+    return lit == succs->end() ? nullptr : &lit->second;
+}
+
+const NodeBS* ParallelCFLSolver::getDerivedPreds(NodeID dst, u32_t label) const
+{
+    const Shard& shard = predShards[getShard(dst)];
+    Shard::const_iterator it = shard.find(dst);
+    if (it == shard.end())
+        return nullptr;
+    LabelToNodesMap::const_iterator lit = it->second.find(label);
+    return lit == it->second.end() ? nullptr : &lit->second;
+}
+
+void ParallelCFLSolver::deriveEdges(const Edge& edge, std::vector<Edges>& candidates, u64_t& checks) const
+{
+    NodeID i = edge.src;
+    NodeID j = edge.dst;
+
+    /// For each production X -> Y
+    ///     add X(i,j)
+    Symbol Y = edge.label;
+    if (grammar->hasProdsFromSingleRHS(Y))
+        for(const Production& prod : grammar->getProdsFromSingleRHS(Y))
+        {
+            checks++;
+            candidates[getShard(i)].push_back({i, j, grammar->getLHSSymbol(prod)});
+        }
+
+    /// For each production X -> Y Z
+    /// Foreach outgoing edge Z(j,k) from node j do
+    ///     add X(i,k)
+    if (grammar->hasProdsFromFirstRHS(Y))
+        for(const Production& prod : grammar->getProdsFromFirstRHS(Y))
+        {
+            u32_t X = grammar->getLHSSymbol(prod);
+            u32_t Z = grammar->getSecondRHSSymbol(prod);
+            if (const CFLEdge::CFLEdgeSetTy* edges = graph->getGNode(j)->findOutEdgeWithTy(Z))
+                for (const CFLEdge* Z_edge : *edges)
+                {
+                    checks++;
+                    candidates[getShard(i)].push_back({i, Z_edge->getDstID(), X});
+                }
+            if (const NodeBS* succs = getDerivedSuccs(j, Z))
+                for (NodeID k : *succs)
+                {
+                    checks++;
+                    candidates[getShard(i)].push_back({i, k, X});
+                }
+        }
+
+    /// For each production X -> Z Y
+    /// Foreach incoming edge Z(k,i) to node i do
+    ///     add X(k,j)
+    if(grammar->hasProdsFromSecondRHS(Y))
+        for(const Production& prod : grammar->getProdsFromSecondRHS(Y))
+        {
+            u32_t X = grammar->getLHSSymbol(prod);
+            u32_t Z = grammar->getFirstRHSSymbol(prod);
+            if (const CFLEdge::CFLEdgeSetTy* edges = graph->getGNode(i)->findInEdgeWithTy(Z))
+                for (const CFLEdge* Z_edge : *edges)
+                {
+                    NodeID k = Z_edge->getSrcID();
+                    checks++;
+                    candidates[getShard(k)].push_back({k, j, X});
+                }
+            if (const NodeBS* preds = getDerivedPreds(i, Z))
+                for (NodeID k : *preds)
+                {
+                    checks++;
+                    candidates[getShard(k)].push_back({k, j, X});
+                }
+        }
+}
+
+/*!
+ * One round in three parallel steps:
+ * (1) derive candidates from chunks of the delta, only reading the edges;
+ * (2) the owner of each source shard adds the new candidates to the derived edges of the graph;
+ * (3) the owner of each destination shard adds the new edges to the incoming derived edges.
+ */
+void ParallelCFLSolver::solveRound(const Edges& delta, Edges& newDelta)
+{
+    const u32_t chunkSize = 1024;
+    u32_t numChunks = (delta.size() + chunkSize - 1) / chunkSize;
+
+    std::vector<std::vector<Edges>> candidates(numChunks, std::vector<Edges>(numShards));
+    std::vector<u64_t> checks(numChunks, 0);
+    parallelForEach(numChunks, [&](u32_t c)
+    {
+        for (u32_t i = c * chunkSize, e = std::min<u32_t>(delta.size(), i + chunkSize); i < e; ++i)
+            deriveEdges(delta[i], candidates[c], checks[c]);
+    });
+    for (u64_t num : checks)
+        numOfChecks += num;
+
+    /// newEdges[src shard][dst shard]
+    std::vector<std::vector<Edges>> newEdges(numShards, std::vector<Edges>(numShards));
+    parallelForEach(numShards, [&](u32_t s)
+    {
+        for (std::vector<Edges>& chunk : candidates)
+        {
+            for (const Edge& edge : chunk[s])
+                if (!graph->hasEdge(graph->getGNode(edge.src), graph->getGNode(edge.dst), edge.label) &&
+                        graph->addDerivedSucc(edge.src, edge.dst, edge.label))
+                    newEdges[s][getShard(edge.dst)].push_back(edge);
+            Edges().swap(chunk[s]);
+        }
+    });
+
+    parallelForEach(numShards, [&](u32_t d)
+    {
+        for (u32_t s = 0; s < numShards; ++s)
+            for (const Edge& edge : newEdges[s][d])
+                addDerivedPred(edge);
+    });
+
+    for (u32_t s = 0; s < numShards; ++s)
+        for (u32_t d = 0; d < numShards; ++d)
+            newDelta.insert(newDelta.end(), newEdges[s][d].begin(), newEdges[s][d].end());
+    graph->addDerivedEdgeNum(newDelta.size());
+}
+
+void ParallelCFLSolver::parallelForEach(u32_t numTasks, const std::function<void(u32_t)>& task) const
+{
+    std::atomic<u32_t> nextTask(0);
+    auto worker = [&nextTask, numTasks, &task]()
+    {
+        for (u32_t i = nextTask++; i < numTasks; i = nextTask++)
+            task(i);
+    };
+    std::vector<std::thread> threads;
+    for (u32_t t = 1; t < std::min(numThreads, numTasks); ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+namespace
+{
+
+/// Dense row of a boolean matrix, only as long as its last set bit requires
+struct DenseBitRow
+{
+    std::vector<u64_t> words;
+};
+
+/// Row operations on dense and sparse rows
+//@{
+inline bool setBit(DenseBitRow& row, NodeID k)
+{
+    u32_t w = k / 64;
+    if (w >= row.words.size())
+        row.words.resize(w + 1, 0);
+    u64_t mask = 1ULL << (k % 64);
+    if (row.words[w] & mask)
+        return false;
+    row.words[w] |= mask;
+    return true;
+}
+
+inline bool testBit(const DenseBitRow& row, NodeID k)
+{
+    u32_t w = k / 64;
+    return w < row.words.size() && (row.words[w] & (1ULL << (k % 64)));
+}
+
+/// dst |= src, return whether dst has changed
+inline bool orRows(DenseBitRow& dst, const DenseBitRow& src)
+{
+    if (dst.words.size() < src.words.size())
+        dst.words.resize(src.words.size(), 0);
+    u64_t* d = dst.words.data();
+    const u64_t* s = src.words.data();
+    u64_t added = 0;
+    for (u32_t w = 0, e = src.words.size(); w < e; ++w)
+    {
+        added |= s[w] & ~d[w];
+        d[w] |= s[w];
+    }
+    return added != 0;
+}
+
+/// dst = a & b
+inline void andRows(DenseBitRow& dst, const DenseBitRow& a, const DenseBitRow& b)
+{
+    u32_t num = std::min(a.words.size(), b.words.size());
+    dst.words.resize(num);
+    for (u32_t w = 0; w < num; ++w)
+        dst.words[w] = a.words[w] & b.words[w];
+}
+
+template<typename Func>
+inline void forEachBit(const DenseBitRow& row, Func func)
+{
+    for (u32_t w = 0, e = row.words.size(); w < e; ++w)
+        for (u64_t bits = row.words[w]; bits; bits &= bits - 1)
+            func(w * 64 + __builtin_ctzll(bits));
+}
+
+inline bool setBit(NodeBS& row, NodeID k)
+{
+    return row.test_and_set(k);
+}
+
+inline bool testBit(const NodeBS& row, NodeID k)
+{
+    return row.test(k);
+}
+
+inline bool orRows(NodeBS& dst, const NodeBS& src)
+{
+    return dst |= src;
+}
+
+inline void andRows(NodeBS& dst, const NodeBS& a, const NodeBS& b)
+{
+    dst = a & b;
+}
+
+template<typename Func>
+inline void forEachBit(const NodeBS& row, Func func)
+{
+    for (NodeID k : row)
+        func(k);
+}
+//@}
+
+} // End anonymous namespace
+
+class MatrixCFLSolver::Relation
+{
+public:
+    virtual ~Relation() {}
+
+    /// Add an edge before solving, return false if it exists
+    virtual bool addEdge(NodeID src, NodeID dst, u32_t label) = 0;
+
+    /// Add an edge already solved, which is not joined with the others again, return false if it exists
+    virtual bool addSolvedEdge(NodeID src, NodeID dst, u32_t label) = 0;
+
+    /// Compute the fixpoint and add the derived edges to graph
+    virtual void solve(CFLGraph* graph, CFGrammar* grammar, double& checks) = 0;
+};
+
+namespace
+{
+
+template<class Row>
+class RowRelation : public MatrixCFLSolver::Relation
+{
+public:
+    bool addEdge(NodeID src, NodeID dst, u32_t label) override
+    {
+        u32_t l = getLabelIdx(label);
+        if (!setBit(getRow(l, src), dst))
+            return false;
+        nonEmptyRows[l].set(src);
+        nextRows[l].set(src);
+        return true;
+    }
+
+    bool addSolvedEdge(NodeID src, NodeID dst, u32_t label) override
+    {
+        u32_t l = getLabelIdx(label);
+        if (!setBit(getRow(l, src), dst))
+            return false;
+        nonEmptyRows[l].set(src);
+        return true;
+    }
+
+    void solve(CFLGraph* graph, CFGrammar* grammar, double& checks) override
+    {
+        indexProductions(grammar);
+        /// rows of all labels exist for all nodes, so rows are never moved while being read
+        for (CFLGraph::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it)
+            setNumRows(it->first + 1);
+
+        std::vector<NodeBS> changedRows(rows.size());
+        std::vector<Row> changedMasks(rows.size());
+        while (true)
+        {
+            bool changed = false;
+            for (u32_t l = 0; l < rows.size(); ++l)
+            {
+                changedRows[l].clear();
+                std::swap(changedRows[l], nextRows[l]);
+                changedMasks[l] = Row();
+                for (NodeID i : changedRows[l])
+                    setBit(changedMasks[l], i);
+                changed |= !changedRows[l].empty();
+            }
+            if (!changed)
+                break;
+
+            /// X -> Y
+            for (const std::pair<u32_t, u32_t>& prod : unaryProds)
+            {
+                for (NodeID i : changedRows[prod.second])
+                {
+                    checks++;
+                    orRow(prod.first, i, rows[prod.second][i]);
+                }
+            }
+
+            /// X -> Y Z
+            for (const std::array<u32_t, 3>& prod : binaryProds)
+            {
+                u32_t X = prod[0], Y = prod[1], Z = prod[2];
+                if (changedRows[Y].empty() && changedRows[Z].empty())
+                    continue;
+                NodeBS rowsOfY = nonEmptyRows[Y];
+                Row joined;
+                for (NodeID i : rowsOfY)
+                {
+                    /// a changed row of Y joins all rows of Z, otherwise only the changed ones
+                    if (changedRows[Y].test(i))
+                        joined = rows[Y][i];
+                    else
+                        andRows(joined, rows[Y][i], changedMasks[Z]);
+                    forEachBit(joined, [&](NodeID j)
+                    {
+                        checks++;
+                        orRow(X, i, rows[Z][j]);
+                    });
+                }
+            }
+        }
+
+        /// add derived edges to the graph
+        for (u32_t l = 0; l < rows.size(); ++l)
+        {
+            for (const std::pair<const NodeID, Row>& it : origRows[l])
+            {
+                NodeID i = it.first;
+                forEachBit(rows[l][i], [&](NodeID k)
+                {
+                    if (!testBit(it.second, k))
+                        graph->addDerivedEdge(i, k, labels[l]);
+                });
+            }
+            origRows[l].clear();
+        }
+    }
+
+private:
+    void setNumRows(u32_t num)
+    {
+        if (num <= numRows)
+            return;
+        numRows = num;
+        for (u32_t l = 0; l < rows.size(); ++l)
+            rows[l].resize(numRows);
+    }
+
+    inline u32_t getLabelIdx(u32_t label)
+    {
+        Map<u32_t, u32_t>::const_iterator it = labelToIdx.find(label);
+        if (it != labelToIdx.end())
+            return it->second;
+        u32_t l = labels.size();
+        labelToIdx[label] = l;
+        labels.push_back(label);
+        rows.emplace_back(numRows);
+        nonEmptyRows.emplace_back();
+        nextRows.emplace_back();
+        origRows.emplace_back();
+        return l;
+    }
+
+    inline Row& getRow(u32_t l, NodeID i)
+    {
+        if (i >= rows[l].size())
+            setNumRows(i + 1);
+        return rows[l][i];
+    }
+
+    /// X[i] |= src, keeping the row of the graph to find derived edges
+    inline void orRow(u32_t X, NodeID i, const Row& src)
+    {
+        Row& dst = rows[X][i];
+        if (origRows[X].find(i) == origRows[X].end())
+            origRows[X][i] = dst;
+        if (orRows(dst, src))
+        {
+            nonEmptyRows[X].set(i);
+            nextRows[X].set(i);
+        }
+    }
+
+    void indexProductions(CFGrammar* grammar)
+    {
+        unaryProds.clear();
+        binaryProds.clear();
+        for (auto& it : grammar->getSingleRHSToProds())
+            for (const CFGrammar::Production& prod : it.second)
+                unaryProds.push_back({getLabelIdx(grammar->getLHSSymbol(prod)), getLabelIdx(grammar->getFirstRHSSymbol(prod))});
+        for (auto& it : grammar->getFirstRHSToProds())
+            for (const CFGrammar::Production& prod : it.second)
+                binaryProds.push_back({getLabelIdx(grammar->getLHSSymbol(prod)), getLabelIdx(grammar->getFirstRHSSymbol(prod)),
+                                       getLabelIdx(grammar->getSecondRHSSymbol(prod))
+                                      });
+    }
+
+    u32_t numRows = 0;
+    Map<u32_t, u32_t> labelToIdx;
+    std::vector<u32_t> labels;
+    std::vector<std::vector<Row>> rows;             ///< label -> node -> row
+    std::vector<NodeBS> nonEmptyRows;
+    std::vector<NodeBS> nextRows;                   ///< rows changed in the current round
+    std::vector<Map<NodeID, Row>> origRows;         ///< rows before the current solve
+    std::vector<std::pair<u32_t, u32_t>> unaryProds;
+    std::vector<std::array<u32_t, 3>> binaryProds;
+};
+
+} // End anonymous namespace
+
+MatrixCFLSolver::MatrixCFLSolver(CFLGraph* _graph, CFGrammar* _grammar) : CFLSolver(_graph, _grammar)
+{
+    if (graph->getTotalNodeNum() <= MaxDenseNodes)
+        relation = new RowRelation<DenseBitRow>();
+    else
+        relation = new RowRelation<NodeBS>();
+}
+
+MatrixCFLSolver::~MatrixCFLSolver()
+{
+    delete relation;
+}
+
+void MatrixCFLSolver::solve()
+{
+    /// initial worklist, later solves only process the edges pushed since
+    if (!solved)
+    {
+        recordInputEdges();
+        initialize();
+    }
+
+    while(!isWorklistEmpty())
+    {
+        const CFLEdge* edge = popFromWorklist();
+        Symbol label = edge->getEdgeKind();
+        relation->addEdge(edge->getSrcID(), edge->getDstID(), label);
+    }
+    relation->solve(graph, grammar, numOfChecks);
+    solved = true;
+}
+
+void MatrixCFLSolver::addSolvedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+{
+    if (relation->addSolvedEdge(src, dst, label))
+        graph->addDerivedEdge(src, dst, label);
+}
@@ -51,7 +51,7 @@ void  CFLStat::CFLGraphStat()
 
     timeStatMap["BuildingTime"] = pta->timeOfBuildCFLGraph;
     PTNumStatMap["NumOfNodes"] = CFLGraph->getTotalNodeNum();
-    PTNumStatMap["NumOfEdges"] = CFLGraph->getCFLEdges().size();
+    PTNumStatMap["NumOfEdges"] = CFLGraph->getCFLEdges().size() + CFLGraph->getDerivedEdgeNum();
 
     PTAStat::printStat("CFLGraph Stats");
 }
@@ -70,6 +70,12 @@ void CFLStat::CFLSolverStat()
     PTNumStatMap["numOfChecks"] = pta->numOfChecks;
     PTNumStatMap["numOfIteration"] = pta->numOfIteration;
     PTNumStatMap["SumEdges"] = pta->numOfStartEdges;
+    if (Options::CFLSummary())
+    {
+        timeStatMap["SummaryTime"] = pta->timeOfSummaries;
+        PTNumStatMap["SummarizedFuns"] = pta->numOfSummarizedFuns;
+        PTNumStatMap["ReusedSummaries"] = pta->numOfReusedSummaries;
+    }
 
     PTAStat::printStat("CFL-reachability Solver Stats");
 }
@@ -0,0 +1,282 @@
+//===----- CFLSummary.cpp -- Function summaries of CFL-reachability--------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CFLSummary.cpp
+ */
+
+#include "CFL/CFLSummary.h"
+#include "Util/Options.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+namespace
+{
+
+/// FNV-1a, stable across runs and platforms
+inline void hashWord(u64_t& h, u64_t w)
+{
+    for (u32_t i = 0; i < 8; ++i, w >>= 8)
+    {
+        h ^= (w & 0xff);
+        h *= 1099511628211ULL;
+    }
+}
+
+inline u64_t hashString(const std::string& str)
+{
+    u64_t h = 14695981039346656037ULL;
+    for (char c : str)
+    {
+        h ^= (unsigned char) c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/// Productions are unordered, their hashes are summed
+u64_t hashProductions(const CFGrammar::Productions& prods)
+{
+    u64_t sum = 0;
+    for (const CFGrammar::Production& prod : prods)
+    {
+        u64_t h = 14695981039346656037ULL;
+        for (const CFGrammar::Symbol& symbol : prod)
+            hashWord(h, (u32_t) symbol);
+        sum += h;
+    }
+    return sum;
+}
+
+} // End anonymous namespace
+
+CFLSummary::CFLSummary(const CFLGraph* graph, CFGrammar* g, const NodeToFunMap& nodeToFun) : grammar(g)
+{
+    grammarHash = hashProductions(grammar->getEpsilonProds());
+    for (auto& it : grammar->getSingleRHSToProds())
+        grammarHash += hashProductions(it.second);
+    for (auto& it : grammar->getFirstRHSToProds())
+        grammarHash += hashProductions(it.second);
+
+    /// Intra-procedural edges, by global IDs first
+    Map<const SVFFunction*, u32_t> funToIdx;
+    for (const CFLEdge* edge : graph->getCFLEdges())
+    {
+        NodeToFunMap::const_iterator sit = nodeToFun.find(edge->getSrcID());
+        NodeToFunMap::const_iterator dit = nodeToFun.find(edge->getDstID());
+        if (sit == nodeToFun.end() || dit == nodeToFun.end() || sit->second != dit->second)
+            continue;
+        auto it = funToIdx.emplace(sit->second, funGraphs.size());
+        if (it.second)
+        {
+            funGraphs.emplace_back();
+            funGraphs.back().name = hashString(sit->second->getName());
+        }
+        FunGraph& fun = funGraphs[it.first->second];
+        fun.edges.push_back({edge->getSrcID(), edge->getDstID(), (CFLEdge::GEdgeFlag) edge->getEdgeKind()});
+        fun.nodes.push_back(edge->getSrcID());
+        fun.nodes.push_back(edge->getDstID());
+    }
+
+    for (FunGraph& fun : funGraphs)
+    {
+        std::sort(fun.nodes.begin(), fun.nodes.end());
+        fun.nodes.erase(std::unique(fun.nodes.begin(), fun.nodes.end()), fun.nodes.end());
+        for (CFLSolver::SolvedEdge& edge : fun.edges)
+        {
+            edge.src = getLocalID(fun, edge.src);
+            edge.dst = getLocalID(fun, edge.dst);
+        }
+        std::sort(fun.edges.begin(), fun.edges.end());
+
+        fun.content = 14695981039346656037ULL;
+        hashWord(fun.content, fun.nodes.size());
+        for (const CFLSolver::SolvedEdge& edge : fun.edges)
+        {
+            hashWord(fun.content, edge.src);
+            hashWord(fun.content, edge.dst);
+            hashWord(fun.content, edge.label);
+        }
+    }
+}
+
+bool CFLSummary::load(const std::string& filename)
+{
+    using namespace CFLSummaryFile;
+
+    std::ifstream F(filename, std::ios::binary | std::ios::ate);
+    if (!F.is_open())
+        return false;
+    u64_t size = F.tellg();
+    F.seekg(0);
+    Header h;
+    if (size < sizeof(Header) || !F.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+            !std::equal(std::begin(Magic), std::end(Magic), h.magic) || h.version != CFLSummaryFile::Version ||
+            h.grammar != grammarHash ||
+            size != sizeof(Header) + h.numFuns * sizeof(FunRecord) + h.numEdges * sizeof(CFLSolver::SolvedEdge))
+        return false;
+
+    std::vector<FunRecord> funs(h.numFuns);
+    SolvedEdges edges(h.numEdges);
+    F.read(reinterpret_cast<char*>(funs.data()), h.numFuns * sizeof(FunRecord));
+    F.read(reinterpret_cast<char*>(edges.data()), h.numEdges * sizeof(CFLSolver::SolvedEdge));
+    if (!F)
+        return false;
+
+    for (const FunRecord& fun : funs)
+    {
+        if (fun.edgeBegin + fun.edgeNum > h.numEdges)
+            return false;
+        loaded[fun.name] = std::make_tuple(fun.content, fun.numNodes,
+                                           SolvedEdges(edges.begin() + fun.edgeBegin, edges.begin() + fun.edgeBegin + fun.edgeNum));
+    }
+    return true;
+}
+
+bool CFLSummary::save(const std::string& filename) const
+{
+    using namespace CFLSummaryFile;
+
+    /// Summaries of this run replace the loaded ones of the same functions
+    OrderedMap<u64_t, std::tuple<u64_t, u32_t, const SolvedEdges*>> summaries;
+    for (const auto& it : loaded)
+        summaries[it.first] = std::make_tuple(std::get<0>(it.second), std::get<1>(it.second), &std::get<2>(it.second));
+    for (const FunGraph& fun : funGraphs)
+        summaries[fun.name] = std::make_tuple(fun.content, (u32_t) fun.nodes.size(), &fun.summary);
+
+    Header h;
+    std::copy(std::begin(Magic), std::end(Magic), h.magic);
+    h.version = CFLSummaryFile::Version;
+    h.reserved = 0;
+    h.grammar = grammarHash;
+    h.numFuns = summaries.size();
+    h.numEdges = 0;
+    std::vector<FunRecord> funs;
+    for (const auto& it : summaries)
+    {
+        const SolvedEdges* summary = std::get<2>(it.second);
+        funs.push_back({it.first, std::get<0>(it.second), std::get<1>(it.second), (u32_t) summary->size(), h.numEdges});
+        h.numEdges += summary->size();
+    }
+
+    std::string tmpName = filename + ".tmp";
+    std::ofstream F(tmpName, std::ios::binary | std::ios::trunc);
+    if (!F.is_open())
+    {
+        writeWrnMsg("failed to write CFL summaries " + filename);
+        return false;
+    }
+    F.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    F.write(reinterpret_cast<const char*>(funs.data()), funs.size() * sizeof(FunRecord));
+    for (const auto& it : summaries)
+    {
+        const SolvedEdges* summary = std::get<2>(it.second);
+        F.write(reinterpret_cast<const char*>(summary->data()), summary->size() * sizeof(CFLSolver::SolvedEdge));
+    }
+    F.close();
+    if (F.fail() || std::rename(tmpName.c_str(), filename.c_str()) != 0)
+    {
+        writeWrnMsg("failed to write CFL summaries " + filename);
+        return false;
+    }
+    return true;
+}
+
+void CFLSummary::summarize(SolvedEdges& edges)
+{
+    std::vector<u32_t> unsolved;
+    for (u32_t i = 0; i < funGraphs.size(); ++i)
+    {
+        FunGraph& fun = funGraphs[i];
+        auto it = loaded.find(fun.name);
+        if (it != loaded.end() && std::get<0>(it->second) == fun.content && std::get<1>(it->second) == fun.nodes.size())
+        {
+            fun.summary = std::get<2>(it->second);
+            numOfReusedFuns++;
+        }
+        else
+            unsolved.push_back(i);
+    }
+    solveFunctions(unsolved);
+    numOfSummarizedFuns = unsolved.size();
+
+    for (const FunGraph& fun : funGraphs)
+    {
+        for (const CFLSolver::SolvedEdge& edge : fun.summary)
+        {
+            if (edge.src < fun.nodes.size() && edge.dst < fun.nodes.size())
+                edges.push_back({fun.nodes[edge.src], fun.nodes[edge.dst], edge.label});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+}
+
+void CFLSummary::solveFunctions(const std::vector<u32_t>& funs)
+{
+    if (funs.empty())
+        return;
+
+    /// Nodes keep their global IDs, so that the fixpoint is split by the functions of nodes
+    CFLGraph* graph = new CFLGraph(0);
+    Map<NodeID, u32_t> nodeToFun;
+    for (u32_t idx : funs)
+    {
+        const FunGraph& fun = funGraphs[idx];
+        for (NodeID id : fun.nodes)
+        {
+            graph->addCFLNode(id, new CFLNode(id));
+            nodeToFun[id] = idx;
+        }
+        for (const CFLSolver::SolvedEdge& edge : fun.edges)
+            graph->addCFLEdge(graph->getGNode(fun.nodes[edge.src]), graph->getGNode(fun.nodes[edge.dst]), edge.label);
+    }
+
+    /// The solver owns the graph and the grammar
+    CFLSolver* solver;
+    if (Options::CFLMatrix())
+        solver = new MatrixCFLSolver(graph, new CFGrammar(*grammar));
+    else if (Options::CFLThreads() > 1)
+        solver = new ParallelCFLSolver(graph, new CFGrammar(*grammar), Options::CFLThreads());
+    else
+        solver = new CFLSolver(graph, new CFGrammar(*grammar));
+    solver->solve();
+
+    auto addSummaryEdge = [&](NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+    {
+        FunGraph& fun = funGraphs[nodeToFun[src]];
+        fun.summary.push_back({getLocalID(fun, src), getLocalID(fun, dst), label});
+    };
+    for (const CFLEdge* edge : graph->getCFLEdges())
+        addSummaryEdge(edge->getSrcID(), edge->getDstID(), edge->getEdgeKind());
+    for (const auto& succs : graph->getDerivedSuccs())
+        for (const auto& labelSuccs : succs.second)
+            for (NodeID dst : labelSuccs.second)
+                addSummaryEdge(succs.first, dst, labelSuccs.first);
+    for (u32_t idx : funs)
+        std::sort(funGraphs[idx].summary.begin(), funGraphs[idx].summary.end());
+
+    delete solver;
+}
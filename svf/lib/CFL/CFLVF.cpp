@@ -66,7 +66,25 @@ void CFLVF::initialize()
     normalizeCFLGrammar();
 
     // Initialize solver
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLMatrix())
+        solver = new MatrixCFLSolver(graph, grammar);
+    else if (Options::CFLThreads() > 1)
+        solver = new ParallelCFLSolver(graph, grammar, Options::CFLThreads());
+    else
+        solver = new CFLSolver(graph, grammar);
+}
+
+void CFLVF::getNodeFunctions(CFLSummary::NodeToFunMap& nodeToFun)
+{
+    if (!Options::CFLGraph().empty())
+        return;
+    for (CFLGraph::iterator it = graph->begin(), eit = graph->end(); it != eit; ++it)
+    {
+        if (!svfg->hasVFGNode(it->first))
+            continue;
+        if (const SVFFunction* fun = svfg->getSVFGNode(it->first)->getFun())
+            nodeToFun[it->first] = fun;
+    }
 }
 
 void CFLVF::checkParameter()
@@ -41,7 +41,7 @@ using namespace SVFUtil;
  */
 ContextDDA::ContextDDA(SVFIR* _pag,  DDAClient* client)
     : CondPTAImpl<ContextCond>(_pag, PointerAnalysis::Cxt_DDA),DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>(),
-      _client(client)
+      _client(client), budgetCredit(0)
 {
     flowDDA = new FlowDDA(_pag, client);
 }
@@ -66,6 +66,9 @@ void ContextDDA::initialize()
     setCallGraph(getCallGraph());
     setCallGraphSCC(getCallGraphSCC());
     stat = setDDAStat(new DDAStat(this));
+    /// a read-only SVFG serves the fall-back flow-sensitive analysis as well
+    if(sharedSVFG)
+        flowDDA->shareSVFG(getSVFG());
     flowDDA->initialize();
 }
 
@@ -76,22 +79,60 @@ const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var)
 {
 
     resetQuery();
-    LocDPItem::setMaxBudget(Options::CxtBudget());
 
     NodeID id = var.get_id();
     PAGNode* node = getPAG()->getGNode(id);
     CxtLocDPItem dpm = getDPIm(var, getDefSVFGNode(node));
+    const SVFFunction* fun = dpm.getLoc()->getFun();
+    LocDPItem::setMaxBudget(computeQueryBudget(id, fun));
+
+    /// take the result of a query completed by another solver
+    if(isbkVisited(dpm) == false)
+    {
+        if(const CxtPtSet* completedPts = findCompletedQuery(dpm))
+        {
+            markbkVisited(dpm);
+            updateCachedPointsTo(dpm,*completedPts);
+            unionPts(var,*completedPts);
+            dependOnCompletedQuery(dpm);
+            addPersistentQuery(dpm,*completedPts);
+            return this->getPts(var);
+        }
+    }
+
+    /// answer from the persistent query cache without traversing the SVFG
+    CxtPtSet cachedPts;
+    if(isbkVisited(dpm) == false && findPersistentQuery(dpm, cachedPts))
+    {
+        markbkVisited(dpm);
+        updateCachedPointsTo(dpm,cachedPts);
+        unionPts(var,cachedPts);
+        addPersistentQuery(dpm,cachedPts);
+        addCompletedQuery(dpm,cachedPts);
+        return this->getPts(var);
+    }
 
     // start DDA analysis
     DOTIMESTAT(double start = DDAStat::getClk(true));
+    /// the cost is timed by itself, as it is recorded without DOTIMESTAT
+    DOSTAT(double costStart = DDAStat::getClk(true));
     const CxtPtSet& cpts = findPT(dpm);
+    DOSTAT(ddaStat->addQueryCost(ddaStat->_NumOfStep, DDAStat::getClk(true) - costStart));
     DOTIMESTAT(ddaStat->_AnaTimePerQuery = DDAStat::getClk(true) - start);
     DOTIMESTAT(ddaStat->_TotalTimeOfQueries += ddaStat->_AnaTimePerQuery);
+    learnQueryCost(fun, ddaStat->_NumOfStep, isOutOfBudgetQuery());
 
     if(isOutOfBudgetQuery() == false)
+    {
         unionPts(var,cpts);
+        addPersistentQuery(dpm,cpts);
+        addCompletedQuery(dpm,cpts);
+    }
     else
+    {
         handleOutOfBudgetDpm(dpm);
+        dependOnAllFunctions();
+    }
 
     if (this->printStat())
         DOSTAT(stat->performStatPerQuery(id));
@@ -109,6 +150,74 @@ void ContextDDA::computeDDAPts(NodeID id)
     computeDDAPts(var);
 }
 
+/*!
+ *  Compute points-to sets for a batch of unconditional pointers
+ */
+void ContextDDA::computeDDAPtsInBatch(const NodeBS& ids)
+{
+    beginQueryBatch();
+    for (NodeID id : ids)
+        computeDDAPts(id);
+    endQueryBatch();
+}
+
+/*!
+ * Step budget of a query.
+ * With -cxt-bg-scale, steps left unspent by earlier queries are credited and only queries
+ * likely to become more precise than Andersen's draw on the credit, at most (scale-1)*cxt-bg
+ * each. The steps of all queries thus stay within cxt-bg per query plus one raised budget.
+ */
+u32_t ContextDDA::computeQueryBudget(NodeID id, const SVFFunction* fun)
+{
+    u32_t budget = Options::CxtBudget();
+    u32_t scale = Options::CxtBudgetScale();
+    if(scale <= 1)
+        return budget;
+
+    /// a singleton can not become more precise, downgrade early
+    u32_t numOfObj = getAndersenAnalysis()->getPts(id).count();
+    if(numOfObj <= 1)
+    {
+        DOSTAT(ddaStat->_NumOfLoweredBudget++);
+        return budget / scale;
+    }
+
+    /// function pointers of indirect call sites may refine the call graph
+    if(getPAG()->isFunPtr(id))
+    {
+        s64_t extra = std::min<s64_t>(budgetCredit, (s64_t) budget * (scale - 1));
+        if(extra > 0)
+        {
+            DOSTAT(ddaStat->_NumOfRaisedBudget++);
+            return budget + extra;
+        }
+        return budget;
+    }
+
+    /// most queries of this function ran out of budget, the next one likely does too
+    Map<const SVFFunction*, FunCost>::const_iterator it = funToCost.find(fun);
+    if(it != funToCost.end() && it->second.numOfQuery >= 2 && it->second.numOfOOBQuery * 2 > it->second.numOfQuery)
+    {
+        DOSTAT(ddaStat->_NumOfLoweredBudget++);
+        return budget / scale;
+    }
+    return budget;
+}
+
+/*!
+ * Record the steps spent by a query
+ */
+void ContextDDA::learnQueryCost(const SVFFunction* fun, u64_t steps, bool oob)
+{
+    if(Options::CxtBudgetScale() <= 1)
+        return;
+    FunCost& cost = funToCost[fun];
+    cost.numOfQuery++;
+    if(oob)
+        cost.numOfOOBQuery++;
+    budgetCredit += (s64_t) Options::CxtBudget() - (s64_t) steps;
+}
+
 /*!
  * Handle out-of-budget dpm
  */
@@ -54,19 +54,24 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
 
     collectCandidateQueries(pta->getPAG());
 
-    u32_t count = 0;
-    for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
-            nIter != candidateQueries.end(); ++nIter,++count)
+    if (Options::DDABatchSize() > 0)
+        answerQueriesInBatch(pta);
+    else
     {
-        PAGNode* node = pta->getPAG()->getGNode(*nIter);
-        if(pta->getPAG()->isValidTopLevelPtr(node))
+        u32_t count = 0;
+        for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
+                nIter != candidateQueries.end(); ++nIter,++count)
         {
-            DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            setCurrentQueryPtr(node->getId());
-            pta->computeDDAPts(node->getId());
+            PAGNode* node = pta->getPAG()->getGNode(*nIter);
+            if(pta->getPAG()->isValidTopLevelPtr(node))
+            {
+                DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
+                      " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
+                DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
+                      " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
+                setCurrentQueryPtr(node->getId());
+                pta->computeDDAPts(node->getId());
+            }
         }
     }
 
@@ -75,6 +80,42 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
     stat->setMemUsageAfter(vmrss, vmsize);
 }
 
+/*!
+ * Queries of pointers in the same function mostly traverse the same value-flows,
+ * answer them in batches of at most Options::DDABatchSize() queries
+ */
+void DDAClient::answerQueriesInBatch(PointerAnalysis* pta)
+{
+    /// group queries by function, in the order of the candidates
+    Map<const SVFFunction*, u32_t> funToGroup;
+    std::vector<std::vector<NodeID>> groups;
+    for (OrderedNodeSet::iterator nIter = candidateQueries.begin(); nIter != candidateQueries.end(); ++nIter)
+    {
+        PAGNode* node = pta->getPAG()->getGNode(*nIter);
+        if(pta->getPAG()->isValidTopLevelPtr(node))
+        {
+            std::pair<Map<const SVFFunction*, u32_t>::iterator, bool> res = funToGroup.emplace(node->getFunction(), groups.size());
+            if (res.second)
+                groups.emplace_back();
+            groups[res.first->second].push_back(node->getId());
+        }
+    }
+
+    for (const std::vector<NodeID>& queries : groups)
+    {
+        for (u32_t begin = 0; begin < queries.size(); begin += Options::DDABatchSize())
+        {
+            NodeBS batch;
+            u32_t end = std::min<u32_t>(begin + Options::DDABatchSize(), queries.size());
+            for (u32_t i = begin; i < end; ++i)
+                batch.set(queries[i]);
+            DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for a batch of " << batch.count() << " pointers\n");
+            setCurrentQueryPtr(queries[begin]);
+            pta->computeDDAPtsInBatch(batch);
+        }
+    }
+}
+
 OrderedNodeSet& FunptrDDAClient::collectCandidateQueries(SVFIR* p)
 {
     setPAG(p);
@@ -37,6 +37,8 @@
 
 #include <sstream>
 #include <limits.h>
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -137,8 +139,24 @@ void DDAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
     {
         ///initialize
         _pta->initialize();
+        std::unique_ptr<DDAQueryCache> queryCache;
+        if (!Options::DDAQueryCacheFile().empty())
+        {
+            queryCache = std::make_unique<DDAQueryCache>(pag, AndersenWaveDiff::createAndersenWaveDiff(pag), kind);
+            if (!queryCache->load(Options::DDAQueryCacheFile()))
+                DBOUT(DGENERAL, outs() << "No valid DDA query cache in " << Options::DDAQueryCacheFile() << "\n");
+            setQueryCache(kind, queryCache.get());
+        }
         ///compute points-to
-        _client->answerQueries(_pta.get());
+        if (Options::DDAThreads() > 1)
+            answerQueriesInParallel(pag, kind);
+        else
+            _client->answerQueries(_pta.get());
+        if (queryCache)
+        {
+            queryCache->save(Options::DDAQueryCacheFile());
+            setQueryCache(kind, nullptr);
+        }
         ///finalize
         _pta->finalize();
         if(Options::PrintCPts())
@@ -153,6 +171,119 @@ void DDAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
 }
 
 
+/*!
+ * Answer queries with one solver per thread. The workers share the SVFG of the
+ * solver of this pass, which is read-only from here on: the indirect calls of the
+ * pre-analysis are connected up front and each worker only follows those it resolves
+ * in its own call graph. Workers add the points-to sets of the queries they complete
+ * to a shared cache, also read by the other workers. The solver of this pass then
+ * takes the completed queries from the cache and the resolved calls from the workers,
+ * and only solves the out-of-budget queries again. With a persistent query cache, each
+ * worker records its own dependencies, and a solver reusing the result of another one
+ * takes over its dependencies and resolved calls.
+ */
+template <class DDA>
+static void answerQueriesWithWorkers(SVFIR* pag, DDAClient* client, DDA* pta)
+{
+    SVFG* svfg = pta->getSVFG();
+    svfg->materializeAllFunctions();
+    AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    if (Options::SVFGWithIndirectCall() == false)
+        svfg->updateCallGraph(ander);
+    pta->shareSVFG(svfg);
+
+    typename DDA::ResultCache cache;
+    std::vector<std::unique_ptr<DDA>> workers;
+    for (u32_t i = 0; i < Options::DDAThreads(); ++i)
+    {
+        workers.push_back(std::make_unique<DDA>(pag, client));
+        workers.back()->disablePrintStat();
+        workers.back()->shareSVFG(svfg);
+        workers.back()->initialize();
+        workers.back()->setResultCache(&cache);
+        workers.back()->setQueryCache(pta->getQueryCache());
+    }
+
+    /// The pre-analysis is read by all workers, touch its points-to sets
+    /// here as getPts may insert an empty one.
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        ander->getPts(it->first);
+
+    std::vector<NodeID> queries;
+    const OrderedNodeSet& candidates = client->collectCandidateQueries(pag);
+    for (OrderedNodeSet::const_iterator it = candidates.begin(), eit = candidates.end(); it != eit; ++it)
+    {
+        if (pag->isValidTopLevelPtr(pag->getGNode(*it)))
+            queries.push_back(*it);
+    }
+
+    std::atomic<u32_t> nextQuery(0);
+    std::vector<std::thread> threads;
+    for (std::unique_ptr<DDA>& worker : workers)
+    {
+        DDA* solver = worker.get();
+        threads.emplace_back([&queries, &nextQuery, solver]()
+        {
+            for (u32_t i = nextQuery++; i < queries.size(); i = nextQuery++)
+                solver->computeDDAPts(queries[i]);
+        });
+    }
+    for (std::thread& t : threads)
+        t.join();
+
+    DBOUT(DGENERAL, outs() << "DDA workers completed " << cache.size() << " of " << queries.size() << " queries\n");
+
+    /// merge the indirect calls resolved by the workers
+    for (std::unique_ptr<DDA>& worker : workers)
+    {
+        for (const auto& item : worker->getIndCallMap())
+        {
+            const CallICFGNode* cs = item.first;
+            for (const SVFFunction* callee : item.second)
+            {
+                if (pta->getIndCallMap()[cs].insert(callee).second)
+                    pta->getCallGraph()->addIndirectCallGraphEdge(cs, cs->getCaller(), callee);
+            }
+        }
+    }
+    pta->getCallGraphSCC()->find();
+
+    pta->setResultCache(&cache);
+    client->answerQueries(pta);
+    pta->setResultCache(nullptr);
+}
+
+void DDAPass::answerQueriesInParallel(SVFIR* pag, u32_t kind)
+{
+    switch (kind)
+    {
+    case PointerAnalysis::Cxt_DDA:
+        answerQueriesWithWorkers(pag, _client, static_cast<ContextDDA*>(_pta.get()));
+        break;
+    case PointerAnalysis::FlowS_DDA:
+        answerQueriesWithWorkers(pag, _client, static_cast<FlowDDA*>(_pta.get()));
+        break;
+    default:
+        _client->answerQueries(_pta.get());
+        break;
+    }
+}
+
+void DDAPass::setQueryCache(u32_t kind, DDAQueryCache* cache)
+{
+    switch (kind)
+    {
+    case PointerAnalysis::Cxt_DDA:
+        static_cast<ContextDDA*>(_pta.get())->setQueryCache(cache);
+        break;
+    case PointerAnalysis::FlowS_DDA:
+        static_cast<FlowDDA*>(_pta.get())->setQueryCache(cache);
+        break;
+    default:
+        break;
+    }
+}
+
 /*!
  * Initialize context insensitive Edge for DDA
  */
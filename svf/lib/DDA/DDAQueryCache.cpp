@@ -0,0 +1,430 @@
+//===- DDAQueryCache.cpp -- Persistent cache of DDA query results-----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DDAQueryCache.cpp
+ */
+
+#include "DDA/DDAQueryCache.h"
+#include "Util/Options.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+namespace
+{
+
+/// FNV-1a, stable across runs and platforms
+inline void hashWord(u64_t& h, u64_t w)
+{
+    for (u32_t i = 0; i < 8; ++i, w >>= 8)
+    {
+        h ^= (w & 0xff);
+        h *= 1099511628211ULL;
+    }
+}
+
+inline u64_t hashString(const std::string& str)
+{
+    u64_t h = 14695981039346656037ULL;
+    for (char c : str)
+    {
+        h ^= (unsigned char) c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/// Statements of an ICFG node and the pre-analysis points-to sets of their operands
+void hashICFGNode(u64_t& h, const ICFGNode* node, BVDataPTAImpl* pre)
+{
+    hashWord(h, node->getId());
+    hashWord(h, node->getNodeKind());
+    for (const SVFStmt* stmt : node->getSVFStmts())
+    {
+        hashWord(h, stmt->getEdgeKind());
+        hashWord(h, stmt->getSrcID());
+        hashWord(h, stmt->getDstID());
+        for (NodeID id : {stmt->getSrcID(), stmt->getDstID()})
+        {
+            const PointsTo& pts = pre->getPts(id);
+            hashWord(h, pts.count());
+            for (NodeID o : pts)
+                hashWord(h, o);
+        }
+    }
+}
+
+} // End anonymous namespace
+
+DDAQueryCache::DDAQueryCache(SVFIR* p, BVDataPTAImpl* pre, u32_t k)
+    : pag(p), kind(k), fingerprint(14695981039346656037ULL), base(nullptr), size(0), header(nullptr), oldStreams(nullptr),
+      oldVisitOrder(nullptr), oldCalls(nullptr), oldEntries(nullptr), oldWords(nullptr), unchanged(false)
+{
+    const SVFModule::FunctionSetType& funs = pag->getModule()->getFunctionSet();
+    for (const SVFFunction* fun : funs)
+    {
+        funToIdx[fun] = nameHashes.size();
+        idxToFun.push_back(fun);
+        nameHashes.push_back(hashString(fun->getName()));
+    }
+    contentHashes.resize(funs.size(), 14695981039346656037ULL);
+
+    /// Only analysis settings and statements outside functions go into the
+    /// fingerprint. Node IDs are hashed with the statements of each function, so
+    /// a function whose IDs shift is invalidated on its own.
+    hashWord(fingerprint, kind);
+    hashWord(fingerprint, Options::CxtBudget());
+    hashWord(fingerprint, Options::CxtBudgetScale());
+    hashWord(fingerprint, Options::FlowBudget());
+    hashWord(fingerprint, Options::MaxContextLen());
+    hashWord(fingerprint, Options::MaxPathLen());
+
+    ICFG* icfg = pag->getICFG();
+    for (ICFG::const_iterator it = icfg->begin(), eit = icfg->end(); it != eit; ++it)
+    {
+        const ICFGNode* node = it->second;
+        Map<const SVFFunction*, u32_t>::const_iterator fit = funToIdx.find(node->getFun());
+        if (fit != funToIdx.end())
+            hashICFGNode(contentHashes[fit->second], node, pre);
+        else
+            hashICFGNode(fingerprint, node, pre);
+    }
+}
+
+DDAQueryCache::~DDAQueryCache()
+{
+    if (base != nullptr && munmap(const_cast<char*>(base), size) == -1)
+        perror("munmap()");
+}
+
+bool DDAQueryCache::load(const std::string& filename)
+{
+    using namespace DDAQueryFile;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat buf;
+    if (fstat(fd, &buf) == -1 || (u64_t) buf.st_size < sizeof(Header))
+    {
+        close(fd);
+        return false;
+    }
+    void* addr = mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+    base = static_cast<const char*>(addr);
+    size = buf.st_size;
+
+    header = reinterpret_cast<const Header*>(base);
+    u64_t expected = sizeof(Header) + (u64_t) header->numFuns * sizeof(FunRecord) +
+                     (u64_t) header->numStreams * sizeof(StreamRecord) + (u64_t) header->numVisited * sizeof(u32_t) +
+                     (u64_t) header->numCalls * sizeof(CallRecord) + (u64_t) header->numEntries * sizeof(EntryRecord) +
+                     (u64_t) header->numWords * sizeof(u32_t);
+    if (!std::equal(std::begin(Magic), std::end(Magic), header->magic) || header->version != DDAQueryFile::Version ||
+            header->kind != kind || header->fingerprint != fingerprint || size != expected)
+    {
+        header = nullptr;
+        return false;
+    }
+
+    const FunRecord* oldFuns = reinterpret_cast<const FunRecord*>(base + sizeof(Header));
+    oldStreams = reinterpret_cast<const StreamRecord*>(oldFuns + header->numFuns);
+    oldVisitOrder = reinterpret_cast<const u32_t*>(oldStreams + header->numStreams);
+    oldCalls = reinterpret_cast<const CallRecord*>(oldVisitOrder + header->numVisited);
+    oldEntries = reinterpret_cast<const EntryRecord*>(oldCalls + header->numCalls);
+    oldWords = reinterpret_cast<const u32_t*>(oldEntries + header->numEntries);
+    for (u32_t i = 0; i < header->numStreams; ++i)
+    {
+        const StreamRecord& rec = oldStreams[i];
+        if ((u64_t) rec.visitBegin + rec.visitNum > header->numVisited || (u64_t) rec.callBegin + rec.callNum > header->numCalls)
+        {
+            header = nullptr;
+            return false;
+        }
+    }
+
+    /// Match functions by name
+    Map<u64_t, u32_t> nameToIdx;
+    for (u32_t i = 0; i < nameHashes.size(); ++i)
+        nameToIdx[nameHashes[i]] = i;
+    unchanged = header->numFuns == nameHashes.size();
+    oldToCurFun.resize(header->numFuns, AllFuns);
+    for (u32_t i = 0; i < header->numFuns; ++i)
+    {
+        Map<u64_t, u32_t>::const_iterator it = nameToIdx.find(oldFuns[i].name);
+        if (it != nameToIdx.end() && contentHashes[it->second] == oldFuns[i].content)
+            oldToCurFun[i] = it->second;
+        else
+            unchanged = false;
+    }
+    auto isCurFun = [&](u32_t idx)
+    {
+        return idx < header->numFuns && oldToCurFun[idx] != AllFuns;
+    };
+    validPrefix.resize(header->numStreams, 0);
+    validCalls.resize(header->numStreams, 0);
+    ICFG* icfg = pag->getICFG();
+    for (u32_t i = 0; i < header->numStreams; ++i)
+    {
+        const StreamRecord& stream = oldStreams[i];
+        while (validPrefix[i] < stream.visitNum && isCurFun(oldVisitOrder[stream.visitBegin + validPrefix[i]]))
+            ++validPrefix[i];
+        /// a call site is valid while its caller is unchanged
+        for (; validCalls[i] < stream.callNum; ++validCalls[i])
+        {
+            const CallRecord& call = oldCalls[stream.callBegin + validCalls[i]];
+            if (!isCurFun(call.caller) || !isCurFun(call.callee) || !icfg->hasICFGNode(call.cs))
+                break;
+            const CallICFGNode* cs = SVFUtil::dyn_cast<CallICFGNode>(icfg->getICFGNode(call.cs));
+            if (cs == nullptr || cs->getCaller() != idxToFun[oldToCurFun[call.caller]])
+                break;
+        }
+    }
+    return true;
+}
+
+bool DDAQueryCache::isValid(const DDAQueryFile::EntryRecord& rec) const
+{
+    if (rec.stream >= header->numStreams || rec.calls > validCalls[rec.stream] ||
+            (u64_t) rec.ptsBegin + rec.ptsNum > header->numWords)
+        return false;
+    if (rec.deps == DDAQueryFile::AllFuns)
+        return unchanged;
+    return rec.deps <= validPrefix[rec.stream];
+}
+
+DDAQueryCache::Stream* DDAQueryCache::addStream()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    streams.push_back(std::make_unique<Stream>());
+    Stream* stream = streams.back().get();
+    stream->visited.resize(nameHashes.size(), false);
+    streamToIdx[stream] = streams.size() - 1;
+    return stream;
+}
+
+void DDAQueryCache::resolveCall(Stream* stream, const CallICFGNode* cs, const SVFFunction* callee)
+{
+    Map<const SVFFunction*, u32_t>::const_iterator it = funToIdx.find(callee);
+    if (it == funToIdx.end() || !stream->resolved.insert(std::make_pair(cs, it->second)).second)
+        return;
+    std::lock_guard<std::mutex> guard(lock);
+    stream->calls.push_back(std::make_pair(cs, it->second));
+}
+
+const u32_t* DDAQueryCache::find(Stream* stream, NodeID ptr, NodeID loc, u32_t& num, CallEdgeMap& calls)
+{
+    if (header == nullptr)
+        return nullptr;
+
+    const DDAQueryFile::EntryRecord* eit = oldEntries + header->numEntries;
+    const DDAQueryFile::EntryRecord* it = std::lower_bound(oldEntries, eit, Key(ptr, loc),
+                                          [](const DDAQueryFile::EntryRecord& rec, const Key& key)
+    {
+        return Key(rec.ptr, rec.loc) < key;
+    });
+    if (it == eit || it->ptr != ptr || it->loc != loc || !isValid(*it))
+        return nullptr;
+
+    const DDAQueryFile::StreamRecord& oldStream = oldStreams[it->stream];
+    if (it->deps == DDAQueryFile::AllFuns)
+        dependOnAll(stream);
+    else
+    {
+        for (u32_t i = 0; i < it->deps; ++i)
+            visitFunctionIdx(stream, oldToCurFun[oldVisitOrder[oldStream.visitBegin + i]]);
+    }
+    ICFG* icfg = pag->getICFG();
+    for (u32_t i = 0; i < it->calls; ++i)
+    {
+        const DDAQueryFile::CallRecord& call = oldCalls[oldStream.callBegin + i];
+        const CallICFGNode* cs = SVFUtil::cast<CallICFGNode>(icfg->getICFGNode(call.cs));
+        calls[cs].insert(idxToFun[oldToCurFun[call.callee]]);
+    }
+    num = it->ptsNum;
+    return oldWords + it->ptsBegin;
+}
+
+void DDAQueryCache::appendPrefix(Stream* stream, const Stream* other, u32_t deps, u32_t calls, CallEdgeMap& callMap)
+{
+    if (deps == DDAQueryFile::AllFuns)
+        stream->allFuns = true;
+    else
+    {
+        for (u32_t i = 0; i < deps; ++i)
+        {
+            u32_t idx = other->visitOrder[i];
+            if (!stream->visited[idx])
+            {
+                stream->visited[idx] = true;
+                stream->visitOrder.push_back(idx);
+            }
+        }
+    }
+    for (u32_t i = 0; i < calls; ++i)
+        callMap[other->calls[i].first].insert(idxToFun[other->calls[i].second]);
+}
+
+bool DDAQueryCache::dependOnQuery(Stream* stream, NodeID ptr, NodeID loc, CallEdgeMap& calls)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    OrderedMap<Key, Entry>::const_iterator it = entries.find(Key(ptr, loc));
+    if (it == entries.end())
+        return false;
+    appendPrefix(stream, streams[it->second.stream].get(), it->second.deps, it->second.calls, calls);
+    return true;
+}
+
+void DDAQueryCache::add(Stream* stream, NodeID ptr, NodeID loc, const Words& pts)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    u32_t deps = stream->allFuns ? DDAQueryFile::AllFuns : stream->visitOrder.size();
+    entries.emplace(Key(ptr, loc), Entry{streamToIdx[stream], deps, (u32_t) stream->calls.size(), pts});
+}
+
+bool DDAQueryCache::save(const std::string& filename) const
+{
+    using namespace DDAQueryFile;
+
+    Header h;
+    std::copy(std::begin(Magic), std::end(Magic), h.magic);
+    h.version = DDAQueryFile::Version;
+    h.kind = kind;
+    h.fingerprint = fingerprint;
+    h.numFuns = nameHashes.size();
+    h.numStreams = streams.size();
+    h.numVisited = 0;
+    h.numCalls = 0;
+    for (const std::unique_ptr<Stream>& stream : streams)
+    {
+        h.numVisited += stream->visitOrder.size();
+        h.numCalls += stream->calls.size();
+    }
+    h.numEntries = entries.size();
+    h.numWords = 0;
+    for (OrderedMap<Key, Entry>::const_iterator it = entries.begin(), eit = entries.end(); it != eit; ++it)
+        h.numWords += it->second.pts.size();
+
+    /// The old file may still be mapped, write a new one and rename it
+    std::string tmpName = filename + ".tmp";
+    std::ofstream F(tmpName, std::ios::binary | std::ios::trunc);
+    if (!F.is_open())
+    {
+        writeWrnMsg("failed to write DDA query cache " + filename);
+        return false;
+    }
+    F.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    for (u32_t i = 0; i < h.numFuns; ++i)
+    {
+        FunRecord rec = {nameHashes[i], contentHashes[i]};
+        F.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+    u32_t visitBegin = 0, callBegin = 0;
+    for (const std::unique_ptr<Stream>& stream : streams)
+    {
+        StreamRecord rec = {visitBegin, (u32_t) stream->visitOrder.size(), callBegin, (u32_t) stream->calls.size()};
+        F.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        visitBegin += rec.visitNum;
+        callBegin += rec.callNum;
+    }
+    for (const std::unique_ptr<Stream>& stream : streams)
+        F.write(reinterpret_cast<const char*>(stream->visitOrder.data()), stream->visitOrder.size() * sizeof(u32_t));
+    for (const std::unique_ptr<Stream>& stream : streams)
+    {
+        for (const std::pair<const CallICFGNode*, u32_t>& call : stream->calls)
+        {
+            Map<const SVFFunction*, u32_t>::const_iterator it = funToIdx.find(call.first->getCaller());
+            CallRecord rec = {call.first->getId(), it != funToIdx.end() ? it->second : AllFuns, call.second};
+            F.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        }
+    }
+    u32_t ptsBegin = 0;
+    for (OrderedMap<Key, Entry>::const_iterator it = entries.begin(), eit = entries.end(); it != eit; ++it)
+    {
+        const Entry& entry = it->second;
+        EntryRecord rec = {it->first.first, it->first.second, entry.stream, entry.deps, entry.calls, ptsBegin, (u32_t) entry.pts.size()};
+        F.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        ptsBegin += rec.ptsNum;
+    }
+    for (OrderedMap<Key, Entry>::const_iterator it = entries.begin(), eit = entries.end(); it != eit; ++it)
+        F.write(reinterpret_cast<const char*>(it->second.pts.data()), it->second.pts.size() * sizeof(u32_t));
+    F.close();
+
+    if (F.fail() || std::rename(tmpName.c_str(), filename.c_str()) != 0)
+    {
+        writeWrnMsg("failed to write DDA query cache " + filename);
+        return false;
+    }
+    return true;
+}
+
+void DDAQueryCache::encode(const PointsTo& pts, Words& words)
+{
+    for (NodeID o : pts)
+        words.push_back(o);
+}
+
+/// Each element is its object, whether its context is concrete, the context length and the context
+void DDAQueryCache::encode(const CxtPtSet& pts, Words& words)
+{
+    for (CxtPtSet::iterator it = pts.begin(), eit = pts.end(); it != eit; ++it)
+    {
+        const ContextCond& cxt = it->get_cond();
+        words.push_back(it->get_id());
+        words.push_back(cxt.isConcreteCxt());
+        words.push_back(cxt.cxtSize());
+        words.insert(words.end(), cxt.begin(), cxt.end());
+    }
+}
+
+void DDAQueryCache::decode(const u32_t* words, u32_t num, PointsTo& pts)
+{
+    for (u32_t i = 0; i < num; ++i)
+        pts.set(words[i]);
+}
+
+void DDAQueryCache::decode(const u32_t* words, u32_t num, CxtPtSet& pts)
+{
+    for (u32_t i = 0; i + 2 < num;)
+    {
+        NodeID id = words[i];
+        bool concrete = words[i + 1];
+        u32_t len = words[i + 2];
+        i += 3;
+        ContextCond cxt;
+        cxt.getContexts().assign(words + i, words + std::min(i + len, num));
+        if (!concrete)
+            cxt.setNonConcreteCxt();
+        pts.set(CxtVar(cxt, id));
+        i += len;
+    }
+}
@@ -33,6 +33,7 @@
 #include "Graphs/SVFGStat.h"
 #include "MemoryModel/PointsTo.h"
 
+#include <algorithm>
 #include <iomanip>
 
 using namespace SVF;
@@ -72,6 +73,10 @@ void DDAStat::initDefault()
     _AnaTimeCyclePerQuery = 0;
 
 
+    _NumOfCachedQuery = 0;
+    _NumOfReusedDPM = 0;
+    _NumOfRaisedBudget = 0;
+    _NumOfLoweredBudget = 0;
     _NumOfDPM = 0;
     _NumOfStrongUpdates = 0;
     _NumOfMustAliases = 0;
@@ -243,6 +248,10 @@ void DDAStat::performStat()
 
     PTNumStatMap["NumOfQuery"] = _TotalNumOfQuery;
     PTNumStatMap["NumOfOOBQuery"] = _TotalNumOfOutOfBudgetQuery;
+    PTNumStatMap["NumOfCachedQuery"] = _NumOfCachedQuery;
+    PTNumStatMap["NumOfReusedDPM"] = _NumOfReusedDPM;
+    PTNumStatMap["NumOfRaisedBudget"] = _NumOfRaisedBudget;
+    PTNumStatMap["NumOfLoweredBudget"] = _NumOfLoweredBudget;
     PTNumStatMap["NumOfDPM"] = _TotalNumOfDPM;
     PTNumStatMap["NumOfSU"] = _TotalNumOfStrongUpdates;
     PTNumStatMap["NumOfStoreSU"] = _StrongUpdateStores.count();
@@ -266,9 +275,33 @@ void DDAStat::performStat()
     timeStatMap["MemoryUsageVmrss"] = _vmrssUsageAfter - _vmrssUsageBefore;
     timeStatMap["MemoryUsageVmsize"] = _vmsizeUsageAfter - _vmsizeUsageBefore;
 
+    costDistributionStat();
+
     printStat();
 }
 
+/*!
+ * Median, 90th, 99th percentile and maximum of the steps and time spent per query
+ */
+void DDAStat::costDistributionStat()
+{
+    if(_StepsPerQuery.empty())
+        return;
+
+    std::vector<u64_t> steps(_StepsPerQuery);
+    std::vector<double> times(_TimePerQuery);
+    std::sort(steps.begin(), steps.end());
+    std::sort(times.begin(), times.end());
+
+    const std::pair<const char*, u32_t> percentiles[] = {{"P50", 50}, {"P90", 90}, {"P99", 99}, {"Max", 100}};
+    for(const auto& p : percentiles)
+    {
+        size_t idx = std::min(steps.size() - 1, steps.size() * p.second / 100);
+        PTNumStatMap[std::string("StepPerQuery") + p.first] = steps[idx];
+        timeStatMap[std::string("TimePerQuery") + p.first] = times[idx]/TIMEINTERVAL;
+    }
+}
+
 void DDAStat::printStatPerQuery(NodeID ptr, const PointsTo& pts)
 {
 
@@ -48,16 +48,52 @@ void FlowDDA::computeDDAPts(NodeID id)
     PAGNode* node = getPAG()->getGNode(id);
     LocDPItem dpm = getDPIm(node->getId(),getDefSVFGNode(node));
 
+    /// take the result of a query completed by another solver
+    if(isbkVisited(dpm) == false)
+    {
+        if(const PointsTo* completedPts = findCompletedQuery(dpm))
+        {
+            markbkVisited(dpm);
+            updateCachedPointsTo(dpm,*completedPts);
+            unionPts(node->getId(),*completedPts);
+            dependOnCompletedQuery(dpm);
+            addPersistentQuery(dpm,*completedPts);
+            return;
+        }
+    }
+
+    /// answer from the persistent query cache without traversing the SVFG
+    PointsTo cachedPts;
+    if(isbkVisited(dpm) == false && findPersistentQuery(dpm, cachedPts))
+    {
+        markbkVisited(dpm);
+        updateCachedPointsTo(dpm,cachedPts);
+        unionPts(node->getId(),cachedPts);
+        addPersistentQuery(dpm,cachedPts);
+        addCompletedQuery(dpm,cachedPts);
+        return;
+    }
+
     /// start DDA analysis
     DOTIMESTAT(double start = DDAStat::getClk(true));
+    /// the cost is timed by itself, as it is recorded without DOTIMESTAT
+    DOSTAT(double costStart = DDAStat::getClk(true));
     const PointsTo& pts = findPT(dpm);
+    DOSTAT(ddaStat->addQueryCost(ddaStat->_NumOfStep, DDAStat::getClk(true) - costStart));
     DOTIMESTAT(ddaStat->_AnaTimePerQuery = DDAStat::getClk(true) - start);
     DOTIMESTAT(ddaStat->_TotalTimeOfQueries += ddaStat->_AnaTimePerQuery);
 
     if(isOutOfBudgetQuery() == false)
+    {
         unionPts(node->getId(),pts);
+        addPersistentQuery(dpm,pts);
+        addCompletedQuery(dpm,pts);
+    }
     else
+    {
         handleOutOfBudgetDpm(dpm);
+        dependOnAllFunctions();
+    }
 
     if(this->printStat())
         DOSTAT(stat->performStatPerQuery(node->getId()));
@@ -66,6 +102,17 @@ void FlowDDA::computeDDAPts(NodeID id)
 }
 
 
+/*!
+ * Compute points-to sets for a batch of queries
+ */
+void FlowDDA::computeDDAPtsInBatch(const NodeBS& ids)
+{
+    beginQueryBatch();
+    for (NodeID id : ids)
+        computeDDAPts(id);
+    endQueryBatch();
+}
+
 /*!
  * Handle out-of-budget dpm
  */
@@ -70,6 +70,57 @@ const CFLEdge* CFLGraph::hasEdge(CFLNode* src, CFLNode* dst, CFLEdge::GEdgeFlag
         return nullptr;
 }
 
+bool CFLGraph::addDerivedEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+{
+    if (hasEdge(getGNode(src), getGNode(dst), label))
+        return false;
+    if (!derivedSuccs[src][label].test_and_set(dst))
+        return false;
+    numOfDerivedEdges++;
+    return true;
+}
+
+bool CFLGraph::hasEdge(NodeID src, NodeID dst, CFLEdge::GEdgeFlag label)
+{
+    if (hasEdge(getGNode(src), getGNode(dst), label))
+        return true;
+    auto it = derivedSuccs.find(src);
+    if (it == derivedSuccs.end())
+        return false;
+    auto lit = it->second.find(label);
+    return lit != it->second.end() && lit->second.test(dst);
+}
+
+void CFLGraph::getSuccs(NodeID src, CFLEdge::GEdgeFlag label, NodeBS& succs)
+{
+    for (const CFLEdge* edge : getGNode(src)->getOutEdgeWithTy(label))
+        succs.set(edge->getDstID());
+    auto it = derivedSuccs.find(src);
+    if (it == derivedSuccs.end())
+        return;
+    auto lit = it->second.find(label);
+    if (lit != it->second.end())
+        succs |= lit->second;
+}
+
+void CFLGraph::initDerivedSuccs()
+{
+    for (const auto& it : *this)
+        derivedSuccs[it.first];
+}
+
+u32_t CFLGraph::getDerivedEdgeNum(CFLEdge::GEdgeFlag label) const
+{
+    u32_t num = 0;
+    for (const auto& it : derivedSuccs)
+    {
+        auto lit = it.second.find(label);
+        if (lit != it.second.end())
+            num += lit->second.count();
+    }
+    return num;
+}
+
 void CFLGraph::dump(const std::string& filename)
 {
     GraphPrinter::WriteGraphToFile(SVFUtil::outs(), filename, this);
@@ -39,6 +39,7 @@ using namespace SVFUtil;
 CallGraph::CallSiteToIdMap CallGraph::csToIdMap;
 CallGraph::IdToCallSiteMap CallGraph::idToCSMap;
 CallSiteID CallGraph::totalCallSiteNum = 1;
+std::mutex CallGraph::callSiteLock;
 
 
 /// Add direct and indirect callsite
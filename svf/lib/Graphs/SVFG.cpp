@@ -326,95 +326,173 @@ void SVFG::addSVFGNodesForAddrTakenVars()
 void SVFG::connectIndirectSVFGEdges()
 {
 
+    if (Options::SVFGThreads() > 1)
+    {
+        connectIntraIndirectSVFGEdgesInParallel(Options::SVFGThreads());
+    }
+    else
+    {
+        for(iterator it = begin(), eit = end(); it!=eit; ++it)
+        {
+            IndirectVFEdgeList edges;
+            collectIntraIndirectSVFGEdges(it->second, edges);
+            for (const auto& edge : edges)
+                addIntraIndirectVFEdge(std::get<0>(edge), std::get<1>(edge), *std::get<2>(edge));
+        }
+    }
+
     for(iterator it = begin(), eit = end(); it!=eit; ++it)
     {
-        NodeID nodeId = it->first;
-        const SVFGNode* node = it->second;
-        if(const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+        connectInterIndirectSVFGEdges(it->second);
+    }
+
+    connectFromGlobalToProgEntry();
+}
+
+/*
+ * Collect intra-procedural def-use chains for indirect value-flow into a node
+ */
+void SVFG::collectIntraIndirectSVFGEdges(const SVFGNode* node, IndirectVFEdgeList& edges)
+{
+    NodeID nodeId = node->getId();
+    if(const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+    {
+        MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getPAGEdge()));
+        for(MUSet::iterator it = muSet.begin(), eit = muSet.end(); it!=eit; ++it)
         {
-            MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getPAGEdge()));
-            for(MUSet::iterator it = muSet.begin(), eit = muSet.end(); it!=eit; ++it)
+            if(LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*it))
             {
-                if(LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*it))
-                {
-                    NodeID def = getDef(mu->getMRVer());
-                    addIntraIndirectVFEdge(def,nodeId, mu->getMRVer()->getMR()->getPointsTo());
-                }
+                NodeID def = getDef(mu->getMRVer());
+                edges.push_back(std::make_tuple(def, nodeId, &mu->getMRVer()->getMR()->getPointsTo()));
             }
         }
-        else if(const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    }
+    else if(const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    {
+        CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getPAGEdge()));
+        for(CHISet::iterator it = chiSet.begin(), eit = chiSet.end(); it!=eit; ++it)
         {
-            CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getPAGEdge()));
-            for(CHISet::iterator it = chiSet.begin(), eit = chiSet.end(); it!=eit; ++it)
+            if(STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*it))
             {
-                if(STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*it))
-                {
-                    NodeID def = getDef(chi->getOpVer());
-                    addIntraIndirectVFEdge(def,nodeId, chi->getOpVer()->getMR()->getPointsTo());
-                }
+                NodeID def = getDef(chi->getOpVer());
+                edges.push_back(std::make_tuple(def, nodeId, &chi->getOpVer()->getMR()->getPointsTo()));
             }
         }
-        else if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+    }
+    else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+    {
+        NodeID def = getDef(formalOut->getMRVer());
+        edges.push_back(std::make_tuple(def, nodeId, &formalOut->getMRVer()->getMR()->getPointsTo()));
+    }
+    else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+    {
+        const MRVer* ver = actualIn->getMRVer();
+        NodeID def = getDef(ver);
+        edges.push_back(std::make_tuple(def, nodeId, &ver->getMR()->getPointsTo()));
+    }
+    else if(SVFUtil::isa<ActualOUTSVFGNode>(node))
+    {
+        /// There's no need to connect actual out node to its definition site in the same function.
+    }
+    else if(const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+    {
+        for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
+                it != eit; it++)
         {
-            CallGraphEdge::CallInstSet callInstSet;
-            mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalIn->getFun(),callInstSet);
-            for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+            const MRVer* op = it->second;
+            NodeID def = getDef(op);
+            edges.push_back(std::make_tuple(def, nodeId, &op->getMR()->getPointsTo()));
+        }
+    }
+}
+
+/*
+ * Connect inter-procedural def-use chains for indirect value-flow into a formal-in/out node
+ */
+void SVFG::connectInterIndirectSVFGEdges(const SVFGNode* node)
+{
+    if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+    {
+        CallGraphEdge::CallInstSet callInstSet;
+        mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalIn->getFun(),callInstSet);
+        for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+        {
+            const CallICFGNode* cs = *it;
+            if(!mssa->hasMU(cs))
+                continue;
+            ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
+            for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait)
             {
-                const CallICFGNode* cs = *it;
-                if(!mssa->hasMU(cs))
-                    continue;
-                ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
-                for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait)
-                {
-                    const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
-                }
+                const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(*ait));
+                addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
             }
         }
-        else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
-        {
-            CallGraphEdge::CallInstSet callInstSet;
-            // const MemSSA::RETMU* retMu = formalOut->getRetMU();
-            mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalOut->getFun(),callInstSet);
-            for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+    }
+    else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+    {
+        CallGraphEdge::CallInstSet callInstSet;
+        // const MemSSA::RETMU* retMu = formalOut->getRetMU();
+        mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalOut->getFun(),callInstSet);
+        for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+        {
+            const CallICFGNode* cs = *it;
+            if(!mssa->hasCHI(cs))
+                continue;
+            ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
+            for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait)
             {
-                const CallICFGNode* cs = *it;
-                if(!mssa->hasCHI(cs))
-                    continue;
-                ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
-                for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait)
-                {
-                    const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
-                }
+                const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
+                addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
             }
-            NodeID def = getDef(formalOut->getMRVer());
-            addIntraIndirectVFEdge(def,nodeId, formalOut->getMRVer()->getMR()->getPointsTo());
-        }
-        else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
-        {
-            const MRVer* ver = actualIn->getMRVer();
-            NodeID def = getDef(ver);
-            addIntraIndirectVFEdge(def,nodeId, ver->getMR()->getPointsTo());
-        }
-        else if(SVFUtil::isa<ActualOUTSVFGNode>(node))
-        {
-            /// There's no need to connect actual out node to its definition site in the same function.
         }
-        else if(const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+    }
+}
+
+/*
+ * Connect intra-procedural indirect value-flows function by function in parallel.
+ * As for direct value-flows (VFG::connectIntraDirectVFGEdgesInParallel), a worker
+ * only adds edges inside its function and buffers the rest for a serial commit.
+ */
+void SVFG::connectIntraIndirectSVFGEdgesInParallel(u32_t numThreads)
+{
+    std::vector<const SVFFunction*> funs;
+    std::vector<std::vector<NodeID>> groups;
+    getNodeGroupsOfFunctions(funs, groups);
+
+    /// "Touch" the mu/chi maps of loads/stores so that workers only look them up.
+    for (const std::vector<NodeID>& group : groups)
+    {
+        for (NodeID id : group)
         {
-            for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
-                    it != eit; it++)
-            {
-                const MRVer* op = it->second;
-                NodeID def = getDef(op);
-                addIntraIndirectVFEdge(def,nodeId, op->getMR()->getPointsTo());
-            }
+            const SVFGNode* node = getSVFGNode(id);
+            if (const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+                mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getPAGEdge()));
+            else if (const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+                mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getPAGEdge()));
         }
     }
 
+    std::vector<IndirectVFEdgeList> deferredEdges(groups.size());
+    parallelForEach(groups.size(), numThreads, [this, &funs, &groups, &deferredEdges](u32_t i)
+    {
+        const SVFFunction* fun = funs[i];
+        IndirectVFEdgeList edges;
+        for (NodeID id : groups[i])
+            collectIntraIndirectSVFGEdges(getSVFGNode(id), edges);
+        for (const auto& edge : edges)
+        {
+            if (fun != nullptr && getSVFGNode(std::get<0>(edge))->getFun() == fun)
+                addIntraIndirectVFEdge(std::get<0>(edge), std::get<1>(edge), *std::get<2>(edge));
+            else
+                deferredEdges[i].push_back(edge);
+        }
+    });
 
-    connectFromGlobalToProgEntry();
+    for (const IndirectVFEdgeList& edges : deferredEdges)
+    {
+        for (const auto& edge : edges)
+            addIntraIndirectVFEdge(std::get<0>(edge), std::get<1>(edge), *std::get<2>(edge));
+    }
 }
 
 
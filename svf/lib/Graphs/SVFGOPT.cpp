@@ -47,6 +47,8 @@ static std::string KeepNoneSelfCycle = "none";
 void SVFGOPT::buildSVFG()
 {
     SVFG::buildSVFG();
+    /// The optimisation traverses the indirect edges of every function
+    materializeAllFunctions();
 
     if(Options::DumpVFG())
         dump("SVFG_before_opt");
@@ -56,11 +58,17 @@ void SVFGOPT::buildSVFG()
     keepActualOutFormalIn = Options::KeepAOFI();
 
     stat->sfvgOptStart();
+    numOfRemovedNodes = 0;
+    numOfRemovedEdges = 0;
+
+    stat->svfgOptInterStart();
     handleInterValueFlow();
+    stat->svfgOptInterEnd();
 
     handleIntraValueFlow();
     stat->sfvgOptEnd();
 
+    stat->setSVFGOptRemovedNum(numOfRemovedNodes, numOfRemovedEdges);
 }
 /*!
  *
@@ -100,6 +108,12 @@ void SVFGOPT::handleInterValueFlow()
             candidates.insert(node);
     }
 
+    /// Retargeting actual-in/formal-out only reads their own edges, so the edges
+    /// can be computed in parallel and added below in the serial order.
+    AInFOutRetargetMap retargets;
+    if (Options::SVFGThreads() > 1)
+        collectRetargetedEdgesInParallel(candidates, retargets, Options::SVFGThreads());
+
     SVFGNodeSet nodesToBeDeleted;
     for (SVFGNodeSet::const_iterator it = candidates.begin(), eit = candidates.end();
             it!=eit; ++it)
@@ -121,7 +135,11 @@ void SVFGOPT::handleInterValueFlow()
         }
         else if (SVFUtil::isa<ActualINSVFGNode, FormalOUTSVFGNode>(node))
         {
-            retargetEdgesOfAInFOut(node);
+            AInFOutRetargetMap::const_iterator rit = retargets.find(node->getId());
+            if (rit != retargets.end())
+                applyRetargetedEdgesOfAInFOut(node, rit->second);
+            else
+                retargetEdgesOfAInFOut(node);
             nodesToBeDeleted.insert(node);
         }
         else if (SVFUtil::isa<ActualOUTSVFGNode, FormalINSVFGNode>(node))
@@ -141,10 +159,37 @@ void SVFGOPT::handleInterValueFlow()
 
             removeAllEdges(node);
             removeSVFGNode(node);
+            numOfRemovedNodes++;
         }
     }
 }
 
+/*!
+ * Compute the retargeted edges of actual-in/formal-out candidates, grouped by function.
+ * The map is filled with all candidates up front so that workers only look up their entries.
+ */
+void SVFGOPT::collectRetargetedEdgesInParallel(const SVFGNodeSet& candidates, AInFOutRetargetMap& retargets, u32_t numThreads)
+{
+    Map<const SVFFunction*, u32_t> funToGroup;
+    std::vector<std::vector<const SVFGNode*>> groups;
+    for (const SVFGNode* node : candidates)
+    {
+        if (!SVFUtil::isa<ActualINSVFGNode, FormalOUTSVFGNode>(node))
+            continue;
+        auto git = funToGroup.emplace(node->getFun(), groups.size()).first;
+        if (git->second == groups.size())
+            groups.emplace_back();
+        groups[git->second].push_back(node);
+        retargets[node->getId()];
+    }
+
+    parallelForEach(groups.size(), numThreads, [this, &groups, &retargets](u32_t i)
+    {
+        for (const SVFGNode* node : groups[i])
+            collectRetargetedEdgesOfAInFOut(node, retargets.find(node->getId())->second);
+    });
+}
+
 /*!
  *
  */
@@ -202,10 +247,20 @@ void SVFGOPT::replaceFParamARetWithPHI(PHISVFGNode* phi, SVFGNode* svfgNode)
  * to formal-in/actual-out directly if they exist.
  */
 void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
+{
+    AInFOutRetarget retarget;
+    collectRetargetedEdgesOfAInFOut(node, retarget);
+    applyRetargetedEdgesOfAInFOut(node, retarget);
+}
+
+/*!
+ * Find the def site of actual-in/formal-out and the points-to sets flowing
+ * from it to each successor. The graph is not modified.
+ */
+void SVFGOPT::collectRetargetedEdgesOfAInFOut(const SVFGNode* node, AInFOutRetarget& retarget) const
 {
     assert(node->getInEdges().size() == 1 && "actual-in/formal-out can only have one incoming edge as its def size");
 
-    SVFGNode* def = nullptr;
     NodeBS inPointsTo;
 
     SVFGNode::const_iterator it = node->InEdgeBegin();
@@ -214,12 +269,7 @@ void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
     {
         const IndirectSVFGEdge* inEdge = SVFUtil::cast<IndirectSVFGEdge>(*it);
         inPointsTo = inEdge->getPointsTo();
-
-        def = inEdge->getSrcNode();
-        if (SVFUtil::isa<ActualINSVFGNode>(node))
-            setActualINDef(node->getId(), def->getId());
-        else if (SVFUtil::isa<FormalOUTSVFGNode>(node))
-            setFormalOUTDef(node->getId(), def->getId());
+        retarget.def = inEdge->getSrcID();
     }
 
     it = node->OutEdgeBegin(), eit = node->OutEdgeEnd();
@@ -232,11 +282,28 @@ void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
         if (intersection.empty())
             continue;
 
-        SVFGNode* dstNode = outEdge->getDstNode();
-        if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(outEdge))
-            addCallIndirectSVFGEdge(def->getId(), dstNode->getId(), callEdge->getCallSiteId(), intersection);
-        else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(outEdge))
-            addRetIndirectSVFGEdge(def->getId(), dstNode->getId(), retEdge->getCallSiteId(), intersection);
+        retarget.outEdges.emplace_back(outEdge, std::move(intersection));
+    }
+}
+
+/*!
+ * Record the def site of actual-in/formal-out and connect it to the successors directly.
+ */
+void SVFGOPT::applyRetargetedEdgesOfAInFOut(SVFGNode* node, const AInFOutRetarget& retarget)
+{
+    NodeID def = retarget.def;
+    if (SVFUtil::isa<ActualINSVFGNode>(node))
+        setActualINDef(node->getId(), def);
+    else if (SVFUtil::isa<FormalOUTSVFGNode>(node))
+        setFormalOUTDef(node->getId(), def);
+
+    for (const auto& outEdge : retarget.outEdges)
+    {
+        NodeID dstId = outEdge.first->getDstID();
+        if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(outEdge.first))
+            addCallIndirectSVFGEdge(def, dstId, callEdge->getCallSiteId(), outEdge.second);
+        else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(outEdge.first))
+            addRetIndirectSVFGEdge(def, dstId, retEdge->getCallSiteId(), outEdge.second);
         else
             assert(false && "expecting an inter-procedural SVFG edge");
     }
@@ -392,44 +459,141 @@ void SVFGOPT::handleIntraValueFlow()
 {
     parseSelfCycleHandleOption();
 
+    stat->svfgOptIntraStart();
+    bool parallel = Options::SVFGThreads() > 1;
+    if (parallel)
+    {
+        removeLocalMSSAPHINodesInParallel(Options::SVFGThreads());
+        stat->svfgOptIntraEnd();
+        /// the remaining phis (e.g., with call/ret edges) are handled serially
+        stat->svfgOptMergeStart();
+    }
+
     initialWorkList();
 
-    while (!worklist.empty())
-    {
-        const MSSAPHISVFGNode* node = worklist.pop();
+    while (!worklist.phis.empty())
+        handleMSSAPHINode(worklist.phis.pop(), worklist);
 
-        /// Skip nodes which have self cycle
-        if (checkSelfCycleEdges(node))
-            continue;
+    if (parallel)
+        stat->svfgOptMergeEnd();
+    else
+        stat->svfgOptIntraEnd();
+}
 
-        if (node->hasOutgoingEdge() && node->hasIncomingEdge())
-            bypassMSSAPHINode(node);
+/*!
+ * Remove MSSAPHI nodes whose value-flows stay inside their function.
+ * Bypassing such a phi only adds edges between nodes of the same function,
+ * so each function is handled by one worker without locking. Removed nodes
+ * are deleted from the graph after the workers join.
+ */
+void SVFGOPT::removeLocalMSSAPHINodesInParallel(u32_t numThreads)
+{
+    std::vector<const SVFFunction*> funs;
+    std::vector<std::vector<NodeID>> groups;
+    getNodeGroupsOfFunctions(funs, groups);
 
-        /// remove node's edges if it only has incoming or outgoing edges.
-        if (node->hasIncomingEdge() && node->hasOutgoingEdge() == false)
+    ConstSVFGNodeSet localPHIs;
+    for (u32_t i = 0; i < groups.size(); ++i)
+    {
+        if (funs[i] == nullptr)
+            continue;
+        for (NodeID id : groups[i])
         {
-            /// remove all the incoming edges;
-            SVFGNode::const_iterator edgeIt = node->InEdgeBegin();
-            SVFGNode::const_iterator edgeEit = node->InEdgeEnd();
-            for (; edgeIt != edgeEit; ++edgeIt)
-                addIntoWorklist((*edgeIt)->getSrcNode());
-
-            removeInEdges(node);
+            const MSSAPHISVFGNode* phi = SVFUtil::dyn_cast<MSSAPHISVFGNode>(getSVFGNode(id));
+            if (phi != nullptr && isDefOfAInFOut(phi) == false && isLocalMSSAPHINode(phi))
+                localPHIs.insert(phi);
         }
-        else if (node->hasOutgoingEdge() && node->hasIncomingEdge() == false)
-        {
-            /// remove all the outgoing edges;
-            SVFGNode::const_iterator edgeIt = node->OutEdgeBegin();
-            SVFGNode::const_iterator edgeEit = node->OutEdgeEnd();
-            for (; edgeIt != edgeEit; ++edgeIt)
-                addIntoWorklist((*edgeIt)->getDstNode());
+    }
+
+    std::vector<MSSAPHIWorkList> worklists(groups.size());
+    for (u32_t i = 0; i < groups.size(); ++i)
+    {
+        worklists[i].localPHIs = &localPHIs;
+        for (NodeID id : groups[i])
+            addIntoWorklist(getSVFGNode(id), worklists[i]);
+    }
+
+    parallelForEach(groups.size(), numThreads, [this, &worklists](u32_t i)
+    {
+        MSSAPHIWorkList& wl = worklists[i];
+        while (!wl.phis.empty())
+            handleMSSAPHINode(wl.phis.pop(), wl);
+    });
 
-            removeOutEdges(node);
+    for (const MSSAPHIWorkList& wl : worklists)
+    {
+        for (const MSSAPHISVFGNode* phi : wl.deadPHIs)
+        {
+            removeSVFGNode(const_cast<MSSAPHISVFGNode*>(phi));
+            numOfRemovedNodes++;
         }
+    }
+}
 
-        /// remove this node if it has no edges
-        if (node->hasIncomingEdge() == false && node->hasOutgoingEdge() == false)
+/*!
+ * Return TRUE if all edges of a MSSAPHI node are intra-procedural edges
+ * from/to nodes of the phi's function.
+ */
+bool SVFGOPT::isLocalMSSAPHINode(const MSSAPHISVFGNode* node) const
+{
+    const SVFFunction* fun = node->getFun();
+    for (const SVFGEdge* edge : node->getInEdges())
+    {
+        if (edge->getEdgeKind() != SVFGEdge::IntraIndirectVF || edge->getSrcNode()->getFun() != fun)
+            return false;
+    }
+    for (const SVFGEdge* edge : node->getOutEdges())
+    {
+        if (edge->getEdgeKind() != SVFGEdge::IntraIndirectVF || edge->getDstNode()->getFun() != fun)
+            return false;
+    }
+    return true;
+}
+
+/*!
+ * Bypass a MSSAPHI node or drop its dangling edges, and remove it once it has no edges.
+ */
+void SVFGOPT::handleMSSAPHINode(const MSSAPHISVFGNode* node, MSSAPHIWorkList& wl)
+{
+    /// Skip nodes which have self cycle
+    if (checkSelfCycleEdges(node))
+        return;
+
+    if (node->hasOutgoingEdge() && node->hasIncomingEdge())
+        bypassMSSAPHINode(node, wl);
+
+    /// remove node's edges if it only has incoming or outgoing edges.
+    if (node->hasIncomingEdge() && node->hasOutgoingEdge() == false)
+    {
+        /// remove all the incoming edges;
+        SVFGNode::const_iterator edgeIt = node->InEdgeBegin();
+        SVFGNode::const_iterator edgeEit = node->InEdgeEnd();
+        for (; edgeIt != edgeEit; ++edgeIt)
+            addIntoWorklist((*edgeIt)->getSrcNode(), wl);
+
+        removeInEdges(node);
+    }
+    else if (node->hasOutgoingEdge() && node->hasIncomingEdge() == false)
+    {
+        /// remove all the outgoing edges;
+        SVFGNode::const_iterator edgeIt = node->OutEdgeBegin();
+        SVFGNode::const_iterator edgeEit = node->OutEdgeEnd();
+        for (; edgeIt != edgeEit; ++edgeIt)
+            addIntoWorklist((*edgeIt)->getDstNode(), wl);
+
+        removeOutEdges(node);
+    }
+
+    /// remove this node if it has no edges
+    if (node->hasIncomingEdge() == false && node->hasOutgoingEdge() == false)
+    {
+        if (wl.localPHIs != nullptr)
+            wl.deadPHIs.push_back(node);
+        else
+        {
             removeSVFGNode(const_cast<MSSAPHISVFGNode*>(node));
+            numOfRemovedNodes++;
+        }
     }
 }
 
@@ -467,6 +631,7 @@ bool SVFGOPT::checkSelfCycleEdges(const MSSAPHISVFGNode* node)
             {
                 assert(SVFUtil::isa<IndirectSVFGEdge>(preEdge) && "can only remove indirect SVFG edge");
                 removeSVFGEdge(preEdge);
+                numOfRemovedEdges++;
             }
         }
     }
@@ -477,7 +642,7 @@ bool SVFGOPT::checkSelfCycleEdges(const MSSAPHISVFGNode* node)
 /*!
  * Remove MSSAPHI node if possible
  */
-void SVFGOPT::bypassMSSAPHINode(const MSSAPHISVFGNode* node)
+void SVFGOPT::bypassMSSAPHINode(const MSSAPHISVFGNode* node, MSSAPHIWorkList& wl)
 {
     SVFGNode::const_iterator inEdgeIt = node->InEdgeBegin();
     SVFGNode::const_iterator inEdgeEit = node->InEdgeEnd();
@@ -501,7 +666,7 @@ void SVFGOPT::bypassMSSAPHINode(const MSSAPHISVFGNode* node)
             {
                 /// if no new edge is added, the number of dst node's incoming edges may be decreased.
                 /// try to analyze it again.
-                addIntoWorklist(dstNode);
+                addIntoWorklist(dstNode, wl);
             }
         }
 
@@ -509,7 +674,7 @@ void SVFGOPT::bypassMSSAPHINode(const MSSAPHISVFGNode* node)
         {
             /// if no new edge is added, the number of src node's outgoing edges may be decreased.
             /// try to analyze it again.
-            addIntoWorklist(srcNode);
+            addIntoWorklist(srcNode, wl);
         }
     }
 
@@ -32,7 +32,12 @@
 #include "Graphs/SVFG.h"
 #include "Graphs/SVFGStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
+#include <algorithm>
 #include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "Util/Options.h"
 
 using namespace SVF;
@@ -46,6 +51,11 @@ using namespace std;
 // srcSVFGNodeID: <id> => dstSVFGNodeID: <id> >= <edge type> | MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }}
 void SVFG::writeToFile(const string& filename)
 {
+    if (Options::SVFGBinary())
+    {
+        writeBinaryFile(filename);
+        return;
+    }
     outs() << "Writing SVFG analysis to '" << filename << "'...";
     error_code err;
     std::fstream f(filename.c_str(), std::ios_base::out);
@@ -206,6 +216,11 @@ void SVFG::writeToFile(const string& filename)
 
 void SVFG::readFile(const string& filename)
 {
+    if (SVFGBinaryReader::isBinaryFile(filename))
+    {
+        readBinaryFile(filename);
+        return;
+    }
     outs() << "Loading SVFG analysis results from '" << filename << "'...";
     ifstream F(filename.c_str());
     if (!F.is_open())
@@ -477,4 +492,651 @@ MRVer* SVFG::getMRVERFromString(const string& s)
     // create mrver
     tempMRVer = new MRVer(tempMemRegion, obj2, tempDef);
     return tempMRVer;
-}
\ No newline at end of file
+}
+namespace
+{
+
+/// Size of a record of each section of the binary format
+const u64_t sectionRecordSize[SVFGBinary::NumSections] =
+{
+    sizeof(SVFGBinary::PtsRecord),
+    sizeof(u32_t),
+    sizeof(SVFGBinary::MRRecord),
+    sizeof(SVFGBinary::MRVerRecord),
+    sizeof(SVFGBinary::NodeRecord),
+    sizeof(SVFGBinary::PhiOpRecord),
+    sizeof(SVFGBinary::EdgeRecord),
+    sizeof(SVFGBinary::FunRecord),
+    sizeof(u32_t),
+};
+
+inline u64_t alignTo8(u64_t offset)
+{
+    return (offset + 7) & ~(u64_t)7;
+}
+
+/// Points-to sets of the binary format, each distinct set stored once
+class PtsTableBuilder
+{
+public:
+    std::vector<SVFGBinary::PtsRecord> index;
+    std::vector<u32_t> data;
+
+    u32_t add(const NodeBS& pts)
+    {
+        size_t h = pts.count();
+        for (NodeID o : pts)
+            h = h * 31 + o;
+        std::vector<u32_t>& bucket = buckets[h];
+        for (u32_t idx : bucket)
+        {
+            if (isSame(index[idx], pts))
+                return idx;
+        }
+        SVFGBinary::PtsRecord rec;
+        rec.begin = data.size();
+        rec.num = pts.count();
+        for (NodeID o : pts)
+            data.push_back(o);
+        bucket.push_back(index.size());
+        index.push_back(rec);
+        return index.size() - 1;
+    }
+
+private:
+    Map<size_t, std::vector<u32_t>> buckets;
+
+    bool isSame(const SVFGBinary::PtsRecord& rec, const NodeBS& pts) const
+    {
+        if (rec.num != pts.count())
+            return false;
+        u32_t i = rec.begin;
+        for (NodeID o : pts)
+        {
+            if (data[i++] != o)
+                return false;
+        }
+        return true;
+    }
+};
+
+template <typename T>
+void writeSection(std::ofstream& f, const std::vector<T>& records, SVFGBinary::Section& section)
+{
+    section.offset = alignTo8(f.tellp());
+    section.num = records.size();
+    while ((u64_t)f.tellp() < section.offset)
+        f.put('\0');
+    if (!records.empty())
+        f.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+}
+
+} // End anonymous namespace
+
+/*!
+ * Write the memory SSA nodes and indirect edges in the binary format.
+ * Nodes are grouped by function and each function lists the edges incident
+ * to its nodes, so that a reader can materialize a single function.
+ */
+void SVFG::writeBinaryFile(const string& filename)
+{
+    outs() << "Writing SVFG analysis to '" << filename << "' (binary)...";
+    std::ofstream f(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    PtsTableBuilder ptsTable;
+    std::vector<SVFGBinary::MRRecord> mrTable;
+    std::vector<SVFGBinary::MRVerRecord> mrVerTable;
+    Map<const MemRegion*, u32_t> mrToIdx;
+    Map<const MRVer*, u32_t> mrVerToIdx;
+    auto addMRVer = [&](const MRVer* ver) -> u32_t
+    {
+        Map<const MRVer*, u32_t>::const_iterator it = mrVerToIdx.find(ver);
+        if (it != mrVerToIdx.end())
+            return it->second;
+        const MemRegion* mr = ver->getMR();
+        Map<const MemRegion*, u32_t>::const_iterator mit = mrToIdx.find(mr);
+        u32_t mrIdx;
+        if (mit == mrToIdx.end())
+        {
+            mrIdx = mrTable.size();
+            mrTable.push_back({ptsTable.add(mr->getPointsTo())});
+            mrToIdx[mr] = mrIdx;
+        }
+        else
+            mrIdx = mit->second;
+        u32_t idx = mrVerTable.size();
+        mrVerTable.push_back({mrIdx, ver->getSSAVersion(), (u32_t) ver->getDef()->getType()});
+        mrVerToIdx[ver] = idx;
+        return idx;
+    };
+
+    /// Functions in the order they are first seen, globals (nullptr) included
+    std::vector<const SVFFunction*> funs;
+    Map<const SVFFunction*, u32_t> funToIdx;
+    auto getFunIdx = [&](const SVFFunction* fun) -> u32_t
+    {
+        Map<const SVFFunction*, u32_t>::const_iterator it = funToIdx.find(fun);
+        if (it != funToIdx.end())
+            return it->second;
+        funToIdx[fun] = funs.size();
+        funs.push_back(fun);
+        return funs.size() - 1;
+    };
+
+    std::vector<std::vector<SVFGBinary::NodeRecord>> funNodes;
+    std::vector<std::vector<u32_t>> funEdges;
+    std::vector<SVFGBinary::PhiOpRecord> phiOpTable;
+    std::vector<SVFGBinary::EdgeRecord> edgeTable;
+    for(iterator it = begin(), eit = end(); it!=eit; ++it)
+    {
+        const SVFGNode* node = it->second;
+        SVFGBinary::NodeRecord rec = {node->getId(), (u32_t) node->getNodeKind(), 0, 0, 0, 0};
+        if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        {
+            rec.icfgNode = formalIn->getFunEntryNode()->getId();
+            rec.mrVer = addMRVer(formalIn->getMRVer());
+        }
+        else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            rec.icfgNode = formalOut->getFunExitNode()->getId();
+            rec.mrVer = addMRVer(formalOut->getMRVer());
+        }
+        else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        {
+            rec.icfgNode = actualIn->getCallSite()->getId();
+            rec.mrVer = addMRVer(actualIn->getMRVer());
+        }
+        else if(const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+        {
+            rec.icfgNode = actualOut->getCallSite()->getId();
+            rec.mrVer = addMRVer(actualOut->getMRVer());
+        }
+        else if(const IntraMSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<IntraMSSAPHISVFGNode>(node))
+        {
+            rec.icfgNode = phiNode->getICFGNode()->getId();
+            rec.mrVer = addMRVer(phiNode->getResVer());
+            rec.opBegin = phiOpTable.size();
+            for (MemSSA::PHI::OPVers::const_iterator oit = phiNode->opVerBegin(), oeit = phiNode->opVerEnd();
+                    oit != oeit; ++oit)
+                phiOpTable.push_back({oit->first, addMRVer(oit->second)});
+            rec.opNum = phiOpTable.size() - rec.opBegin;
+        }
+        else
+        {
+            assert(!SVFUtil::isa<MSSAPHISVFGNode>(node) && "inter memory SSA phis are not written before optimisation");
+            rec.kind = SVFGBinary::Invalid;
+        }
+
+        if (rec.kind != SVFGBinary::Invalid)
+        {
+            u32_t funIdx = getFunIdx(node->getFun());
+            funNodes.resize(funs.size());
+            funNodes[funIdx].push_back(rec);
+        }
+
+        for (const SVFGEdge* edge : node->getOutEdges())
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == nullptr)
+                continue;
+            CallSiteID csId = 0;
+            if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(indEdge))
+                csId = callEdge->getCallSiteId();
+            else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(indEdge))
+                csId = retEdge->getCallSiteId();
+            u32_t edgeIdx = edgeTable.size();
+            edgeTable.push_back({edge->getSrcID(), edge->getDstID(), (u32_t) edge->getEdgeKind(),
+                                 ptsTable.add(indEdge->getPointsTo()), csId});
+            u32_t srcFunIdx = getFunIdx(edge->getSrcNode()->getFun());
+            u32_t dstFunIdx = getFunIdx(edge->getDstNode()->getFun());
+            funEdges.resize(funs.size());
+            funEdges[srcFunIdx].push_back(edgeIdx);
+            if (dstFunIdx != srcFunIdx)
+                funEdges[dstFunIdx].push_back(edgeIdx);
+        }
+    }
+    funNodes.resize(funs.size());
+    funEdges.resize(funs.size());
+
+    std::vector<SVFGBinary::NodeRecord> nodeTable;
+    std::vector<u32_t> funEdgeTable;
+    std::vector<SVFGBinary::FunRecord> funTable;
+    for (u32_t i = 0; i < funs.size(); ++i)
+    {
+        SVFGBinary::FunRecord rec;
+        rec.entry = funs[i] ? pag->getICFG()->getFunEntryICFGNode(funs[i])->getId() : SVFGBinary::Invalid;
+        rec.nodeBegin = nodeTable.size();
+        rec.nodeNum = funNodes[i].size();
+        rec.edgeBegin = funEdgeTable.size();
+        rec.edgeNum = funEdges[i].size();
+        nodeTable.insert(nodeTable.end(), funNodes[i].begin(), funNodes[i].end());
+        funEdgeTable.insert(funEdgeTable.end(), funEdges[i].begin(), funEdges[i].end());
+        funTable.push_back(rec);
+    }
+
+    SVFGBinary::Header header = {};
+    std::copy(std::begin(SVFGBinary::Magic), std::end(SVFGBinary::Magic), header.magic);
+    header.version = SVFGBinary::Version;
+    header.numSections = SVFGBinary::NumSections;
+    header.totalNodeNum = totalVFGNode;
+
+    SVFGBinary::Section sections[SVFGBinary::NumSections] = {};
+    for (u32_t i = 0; i < SVFGBinary::NumSections; ++i)
+        sections[i].kind = i;
+    /// Reserve the header and section table, written again once the offsets are known
+    f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    f.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+    writeSection(f, ptsTable.index, sections[SVFGBinary::PtsIndex]);
+    writeSection(f, ptsTable.data, sections[SVFGBinary::PtsData]);
+    writeSection(f, mrTable, sections[SVFGBinary::MRTable]);
+    writeSection(f, mrVerTable, sections[SVFGBinary::MRVerTable]);
+    writeSection(f, nodeTable, sections[SVFGBinary::NodeTable]);
+    writeSection(f, phiOpTable, sections[SVFGBinary::PhiOpTable]);
+    writeSection(f, edgeTable, sections[SVFGBinary::EdgeTable]);
+    writeSection(f, funTable, sections[SVFGBinary::FunTable]);
+    writeSection(f, funEdgeTable, sections[SVFGBinary::FunEdgeTable]);
+    f.seekp(sizeof(header));
+    f.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+
+    f.close();
+    if (f.good())
+        outs() << "\n";
+    else
+        outs() << "  error writing file!\n";
+}
+
+/*!
+ * Whether the ICFG nodes of a binary SVFG exist and are of the kinds its nodes are attached to,
+ * and its node IDs are not taken by the nodes of top-level pointers
+ */
+bool SVFG::checkBinaryICFGNodes(const SVFGBinaryReader& reader) const
+{
+    ICFG* icfg = pag->getICFG();
+    const SVFGBinary::FunRecord* funs = reader.getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable);
+    for (u32_t i = 0, e = reader.getRecordNum(SVFGBinary::FunTable); i < e; ++i)
+    {
+        if (funs[i].entry != SVFGBinary::Invalid &&
+                (!icfg->hasGNode(funs[i].entry) || !SVFUtil::isa<FunEntryICFGNode>(icfg->getGNode(funs[i].entry))))
+            return false;
+    }
+    const SVFGBinary::NodeRecord* nodes = reader.getRecords<SVFGBinary::NodeRecord>(SVFGBinary::NodeTable);
+    for (u32_t i = 0, e = reader.getRecordNum(SVFGBinary::NodeTable); i < e; ++i)
+    {
+        const SVFGBinary::NodeRecord& rec = nodes[i];
+        if (hasGNode(rec.id) || !icfg->hasGNode(rec.icfgNode))
+            return false;
+        const ICFGNode* icfgNode = icfg->getGNode(rec.icfgNode);
+        if ((rec.kind == VFGNode::FPIN && !SVFUtil::isa<FunEntryICFGNode>(icfgNode)) ||
+                (rec.kind == VFGNode::FPOUT && !SVFUtil::isa<FunExitICFGNode>(icfgNode)) ||
+                ((rec.kind == VFGNode::APIN || rec.kind == VFGNode::APOUT) && !SVFUtil::isa<CallICFGNode>(icfgNode)))
+            return false;
+    }
+    return true;
+}
+
+/*!
+ * Read the memory SSA nodes and indirect edges in the binary format.
+ * With -svfg-lazy-load only the global part is added here and every other
+ * function is materialized when it is first requested.
+ */
+void SVFG::readBinaryFile(const string& filename)
+{
+    outs() << "Loading SVFG analysis results from '" << filename << "' (binary)...";
+    std::unique_ptr<SVFGBinaryReader> reader = std::make_unique<SVFGBinaryReader>();
+    if (!reader->open(filename) || !checkBinaryICFGNodes(*reader))
+    {
+        outs() << " error reading binary SVFG file!\n";
+        return;
+    }
+
+    PAGEdge::PAGEdgeSetTy& stores = getPAGEdgeSet(PAGEdge::Store);
+    for (PAGEdge::PAGEdgeSetTy::iterator iter = stores.begin(), eiter =
+                stores.end(); iter != eiter; ++iter)
+    {
+        StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for(CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi!=epi; ++pi)
+            setDef((*pi)->getResVer(),sNode);
+    }
+
+    /// Node IDs of functions not materialized yet must not be reused
+    if (totalVFGNode < reader->getHeader()->totalNodeNum)
+        totalVFGNode = reader->getHeader()->totalNodeNum;
+
+    const SVFGBinary::FunRecord* funs = reader->getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable);
+    u32_t numFuns = reader->getRecordNum(SVFGBinary::FunTable);
+    for (u32_t i = 0; i < numFuns; ++i)
+    {
+        const SVFFunction* fun = nullptr;
+        if (funs[i].entry != SVFGBinary::Invalid)
+            fun = pag->getICFG()->getICFGNode(funs[i].entry)->getFun();
+        reader->setFunRecord(fun, i);
+    }
+    binaryReader = std::move(reader);
+
+    if (Options::SVFGLazyLoad())
+    {
+        materializeFunction(nullptr);
+    }
+    else
+    {
+        stat->ATVFNodeStart();
+        for (u32_t i = 0; i < numFuns; ++i)
+            addBinarySVFGNodes(i);
+        stat->ATVFNodeEnd();
+        stat->indVFEdgeStart();
+        for (u32_t i = 0; i < numFuns; ++i)
+            addBinarySVFGEdges(i);
+        stat->indVFEdgeEnd();
+    }
+    outs() << "\n";
+}
+
+/*!
+ * Add the nodes of a function and all edges incident to them, i.e., also the nodes
+ * of the functions at the other end of its call, return and thread edges
+ */
+void SVFG::materializeFunction(const SVFFunction* fun)
+{
+    if (!binaryReader)
+        return;
+    u32_t funIdx = binaryReader->getFunRecord(fun);
+    if (funIdx == SVFGBinary::Invalid || binaryReader->isFunComplete(funIdx))
+        return;
+
+    if (!binaryReader->isFunLoaded(funIdx))
+        addBinarySVFGNodes(funIdx);
+    std::vector<u32_t> loaded;
+    const SVFGBinary::FunRecord& funRec = binaryReader->getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable)[funIdx];
+    const u32_t* funEdges = binaryReader->getRecords<u32_t>(SVFGBinary::FunEdgeTable);
+    const SVFGBinary::EdgeRecord* edges = binaryReader->getRecords<SVFGBinary::EdgeRecord>(SVFGBinary::EdgeTable);
+    for (u32_t i = funRec.edgeBegin, e = funRec.edgeBegin + funRec.edgeNum; i < e; ++i)
+    {
+        const SVFGBinary::EdgeRecord& rec = edges[funEdges[i]];
+        for (NodeID id : {rec.src, rec.dst})
+        {
+            u32_t otherIdx = binaryReader->getNodeFunRecord(id);
+            if (otherIdx != SVFGBinary::Invalid && !binaryReader->isFunLoaded(otherIdx))
+            {
+                addBinarySVFGNodes(otherIdx);
+                loaded.push_back(otherIdx);
+            }
+        }
+    }
+    addBinarySVFGEdges(funIdx);
+    for (u32_t idx : loaded)
+        addBinarySVFGEdges(idx);
+    binaryReader->setFunComplete(funIdx);
+}
+
+void SVFG::materializeAllFunctions()
+{
+    if (!binaryReader)
+        return;
+    u32_t numFuns = binaryReader->getRecordNum(SVFGBinary::FunTable);
+    for (u32_t i = 0; i < numFuns; ++i)
+    {
+        if (!binaryReader->isFunLoaded(i))
+        {
+            addBinarySVFGNodes(i);
+            addBinarySVFGEdges(i);
+        }
+    }
+}
+
+void SVFG::addBinarySVFGNodes(u32_t funIdx)
+{
+    const SVFGBinary::FunRecord& fun = binaryReader->getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable)[funIdx];
+    const SVFGBinary::NodeRecord* nodes = binaryReader->getRecords<SVFGBinary::NodeRecord>(SVFGBinary::NodeTable);
+    const SVFGBinary::PhiOpRecord* phiOps = binaryReader->getRecords<SVFGBinary::PhiOpRecord>(SVFGBinary::PhiOpTable);
+    binaryReader->setFunLoaded(funIdx);
+    for (u32_t i = fun.nodeBegin, e = fun.nodeBegin + fun.nodeNum; i < e; ++i)
+    {
+        const SVFGBinary::NodeRecord& rec = nodes[i];
+        ICFGNode* icfgNode = pag->getICFG()->getICFGNode(rec.icfgNode);
+        const MRVer* ver = binaryReader->getMRVer(rec.mrVer);
+        switch (rec.kind)
+        {
+        case VFGNode::FPIN:
+            addFormalINSVFGNode(SVFUtil::cast<FunEntryICFGNode>(icfgNode), ver, rec.id);
+            break;
+        case VFGNode::FPOUT:
+            addFormalOUTSVFGNode(SVFUtil::cast<FunExitICFGNode>(icfgNode), ver, rec.id);
+            break;
+        case VFGNode::APIN:
+            addActualINSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, rec.id);
+            break;
+        case VFGNode::APOUT:
+            addActualOUTSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, rec.id);
+            break;
+        case VFGNode::MIntraPhi:
+        {
+            Map<u32_t,const MRVer*> opVers;
+            for (u32_t j = rec.opBegin, je = rec.opBegin + rec.opNum; j < je; ++j)
+                opVers[phiOps[j].pos] = binaryReader->getMRVer(phiOps[j].mrVer);
+            addIntraMSSAPHISVFGNode(icfgNode, opVers.begin(), opVers.end(), ver, rec.id);
+            break;
+        }
+        default:
+            assert(false && "unexpected node kind in a binary SVFG");
+        }
+    }
+}
+
+void SVFG::addBinarySVFGEdges(u32_t funIdx)
+{
+    const SVFGBinary::FunRecord& fun = binaryReader->getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable)[funIdx];
+    const u32_t* funEdges = binaryReader->getRecords<u32_t>(SVFGBinary::FunEdgeTable);
+    const SVFGBinary::EdgeRecord* edges = binaryReader->getRecords<SVFGBinary::EdgeRecord>(SVFGBinary::EdgeTable);
+    for (u32_t i = fun.edgeBegin, e = fun.edgeBegin + fun.edgeNum; i < e; ++i)
+    {
+        u32_t edgeIdx = funEdges[i];
+        const SVFGBinary::EdgeRecord& rec = edges[edgeIdx];
+        /// An edge between two functions is added once the second one is materialized
+        if (binaryReader->isEdgeLoaded(edgeIdx) || !hasSVFGNode(rec.src) || !hasSVFGNode(rec.dst))
+            continue;
+        binaryReader->setEdgeLoaded(edgeIdx);
+        NodeBS pts = binaryReader->getPts(rec.pts);
+        switch (rec.kind)
+        {
+        case SVFGEdge::IntraIndirectVF:
+            addIntraIndirectVFEdge(rec.src, rec.dst, pts);
+            break;
+        case SVFGEdge::CallIndVF:
+            addCallIndirectVFEdge(rec.src, rec.dst, pts, rec.csId);
+            break;
+        case SVFGEdge::RetIndVF:
+            addRetIndirectVFEdge(rec.src, rec.dst, pts, rec.csId);
+            break;
+        case SVFGEdge::TheadMHPIndirectVF:
+            addThreadMHPIndirectVFEdge(rec.src, rec.dst, pts);
+            break;
+        default:
+            assert(false && "unexpected edge kind in a binary SVFG");
+        }
+    }
+}
+
+SVFGBinaryReader::~SVFGBinaryReader()
+{
+    for (MRVer* ver : mrVers)
+        delete ver;
+    for (MSSADEF* def : defs)
+        delete def;
+    for (MemRegion* mr : mrs)
+        delete mr;
+    if (base != nullptr && munmap(const_cast<char*>(base), size) == -1)
+        perror("munmap()");
+}
+
+bool SVFGBinaryReader::isBinaryFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    char magic[sizeof(SVFGBinary::Magic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return std::equal(std::begin(magic), std::end(magic), std::begin(SVFGBinary::Magic));
+}
+
+bool SVFGBinaryReader::open(const string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat buf;
+    if (fstat(fd, &buf) == -1 || (u64_t) buf.st_size < sizeof(SVFGBinary::Header))
+    {
+        close(fd);
+        return false;
+    }
+    void* addr = mmap(nullptr, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+    base = static_cast<const char*>(addr);
+    size = buf.st_size;
+
+    header = reinterpret_cast<const SVFGBinary::Header*>(base);
+    if (!std::equal(std::begin(SVFGBinary::Magic), std::end(SVFGBinary::Magic), header->magic) ||
+            header->version != SVFGBinary::Version || header->numSections != SVFGBinary::NumSections ||
+            size < sizeof(SVFGBinary::Header) + sizeof(sections))
+        return false;
+    std::copy_n(reinterpret_cast<const SVFGBinary::Section*>(base + sizeof(SVFGBinary::Header)),
+                SVFGBinary::NumSections, sections);
+    for (u32_t i = 0; i < SVFGBinary::NumSections; ++i)
+    {
+        const SVFGBinary::Section& section = sections[i];
+        if (section.kind != i || section.offset % 8 != 0 || section.offset > size ||
+                section.num > (size - section.offset) / sectionRecordSize[i])
+            return false;
+    }
+    if (!checkRecords())
+        return false;
+
+    const SVFGBinary::FunRecord* funs = getRecords<SVFGBinary::FunRecord>(SVFGBinary::FunTable);
+    const SVFGBinary::NodeRecord* nodes = getRecords<SVFGBinary::NodeRecord>(SVFGBinary::NodeTable);
+    for (u32_t i = 0; i < getRecordNum(SVFGBinary::FunTable); ++i)
+    {
+        for (u32_t j = funs[i].nodeBegin, e = funs[i].nodeBegin + funs[i].nodeNum; j < e; ++j)
+        {
+            if (!nodeToFunRecord.emplace(nodes[j].id, i).second)
+                return false;
+        }
+    }
+
+    mrs.resize(getRecordNum(SVFGBinary::MRTable), nullptr);
+    mrVers.resize(getRecordNum(SVFGBinary::MRVerTable), nullptr);
+    funLoaded.resize(getRecordNum(SVFGBinary::FunTable), false);
+    funComplete.resize(getRecordNum(SVFGBinary::FunTable), false);
+    edgeLoaded.resize(getRecordNum(SVFGBinary::EdgeTable), false);
+    return true;
+}
+
+/*!
+ * Check that every index in a record refers to an existing record (and every kind is
+ * one written by writeBinaryFile), so nodes and edges of a malformed file are not read
+ * beyond its sections. ICFG nodes are checked when the file is read into a SVFG.
+ */
+bool SVFGBinaryReader::checkRecords() const
+{
+    using namespace SVFGBinary;
+    const u64_t numPts = getRecordNum(PtsIndex), numMRs = getRecordNum(MRTable);
+    const u64_t numMRVers = getRecordNum(MRVerTable), numEdges = getRecordNum(EdgeTable);
+    const u64_t totalNodeNum = header->totalNodeNum;
+
+    const PtsRecord* pts = getRecords<PtsRecord>(PtsIndex);
+    for (u64_t i = 0; i < numPts; ++i)
+    {
+        if (!inSection(PtsData, pts[i].begin, pts[i].num))
+            return false;
+    }
+    const MRRecord* mrRecs = getRecords<MRRecord>(MRTable);
+    for (u64_t i = 0; i < numMRs; ++i)
+    {
+        if (mrRecs[i].pts >= numPts)
+            return false;
+    }
+    const MRVerRecord* verRecs = getRecords<MRVerRecord>(MRVerTable);
+    for (u64_t i = 0; i < numMRVers; ++i)
+    {
+        if (verRecs[i].mr >= numMRs || verRecs[i].defType > MSSADEF::SSAPHI)
+            return false;
+    }
+    const NodeRecord* nodes = getRecords<NodeRecord>(NodeTable);
+    for (u64_t i = 0, e = getRecordNum(NodeTable); i < e; ++i)
+    {
+        const NodeRecord& rec = nodes[i];
+        if (rec.id >= totalNodeNum || rec.mrVer >= numMRVers)
+            return false;
+        if (rec.kind == VFGNode::MIntraPhi)
+        {
+            if (!inSection(PhiOpTable, rec.opBegin, rec.opNum))
+                return false;
+        }
+        else if (rec.kind != VFGNode::FPIN && rec.kind != VFGNode::FPOUT &&
+                 rec.kind != VFGNode::APIN && rec.kind != VFGNode::APOUT)
+            return false;
+    }
+    const PhiOpRecord* phiOps = getRecords<PhiOpRecord>(PhiOpTable);
+    for (u64_t i = 0, e = getRecordNum(PhiOpTable); i < e; ++i)
+    {
+        if (phiOps[i].mrVer >= numMRVers)
+            return false;
+    }
+    const EdgeRecord* edges = getRecords<EdgeRecord>(EdgeTable);
+    for (u64_t i = 0; i < numEdges; ++i)
+    {
+        const EdgeRecord& rec = edges[i];
+        if (rec.src >= totalNodeNum || rec.dst >= totalNodeNum || rec.pts >= numPts)
+            return false;
+        if (rec.kind != SVFGEdge::IntraIndirectVF && rec.kind != SVFGEdge::CallIndVF &&
+                rec.kind != SVFGEdge::RetIndVF && rec.kind != SVFGEdge::TheadMHPIndirectVF)
+            return false;
+    }
+    const FunRecord* funs = getRecords<FunRecord>(FunTable);
+    for (u64_t i = 0, e = getRecordNum(FunTable); i < e; ++i)
+    {
+        if (!inSection(NodeTable, funs[i].nodeBegin, funs[i].nodeNum) ||
+                !inSection(FunEdgeTable, funs[i].edgeBegin, funs[i].edgeNum))
+            return false;
+    }
+    const u32_t* funEdges = getRecords<u32_t>(FunEdgeTable);
+    for (u64_t i = 0, e = getRecordNum(FunEdgeTable); i < e; ++i)
+    {
+        if (funEdges[i] >= numEdges)
+            return false;
+    }
+    return true;
+}
+
+NodeBS SVFGBinaryReader::getPts(u32_t idx) const
+{
+    const SVFGBinary::PtsRecord& rec = getRecords<SVFGBinary::PtsRecord>(SVFGBinary::PtsIndex)[idx];
+    const u32_t* data = getRecords<u32_t>(SVFGBinary::PtsData);
+    NodeBS pts;
+    for (u32_t i = rec.begin, e = rec.begin + rec.num; i < e; ++i)
+        pts.set(data[i]);
+    return pts;
+}
+
+const MRVer* SVFGBinaryReader::getMRVer(u32_t idx)
+{
+    if (mrVers[idx] == nullptr)
+    {
+        const SVFGBinary::MRVerRecord& rec = getRecords<SVFGBinary::MRVerRecord>(SVFGBinary::MRVerTable)[idx];
+        if (mrs[rec.mr] == nullptr)
+        {
+            const SVFGBinary::MRRecord& mrRec = getRecords<SVFGBinary::MRRecord>(SVFGBinary::MRTable)[rec.mr];
+            mrs[rec.mr] = new MemRegion(getPts(mrRec.pts));
+        }
+        MSSADEF* def = new MSSADEF(static_cast<MSSADEF::DEFTYPE>(rec.defType), mrs[rec.mr]);
+        defs.push_back(def);
+        mrVers[idx] = new MRVer(mrs[rec.mr], rec.version, def);
+    }
+    return mrVers[idx];
+}
@@ -30,6 +30,7 @@
 #include "Graphs/SVFG.h"
 #include "Graphs/SVFGStat.h"
 #include "Graphs/CallGraph.h"
+#include "MemoryModel/PointerAnalysisImpl.h"
 
 using namespace SVF;
 using namespace std;
@@ -39,6 +40,7 @@ const char* MemSSAStat::TimeOfGeneratingMemRegions  = "GenRegionTime";	///< Time
 const char* MemSSAStat::TimeOfCreateMUCHI  = "GenMUCHITime";	///< Time for generating mu/chi for load/store/calls
 const char* MemSSAStat::TimeOfInsertingPHI = "InsertPHITime";	///< Time for inserting phis
 const char* MemSSAStat::TimeOfSSARenaming = "SSARenameTime";	///< Time for SSA rename
+const char* MemSSAStat::TimeOfMaxSCCModRef = "MaxSCCModRefTime";	///< Time of mod-ref analysis of the slowest call graph SCC
 
 const char* MemSSAStat::NumOfMaxRegion = "MaxRegSize";	///< Number of max points-to set in region.
 const char* MemSSAStat::NumOfAveragePtsInRegion = "AverageRegSize";	///< Number of average points-to set in region.
@@ -58,6 +60,8 @@ const char* MemSSAStat::NumOfCSHasMu = "CSHasMu";	///< Number of call sites whic
 const char* MemSSAStat::NumOfLoadHasMu = "LoadHasMu";	///< Number of loads which have mu
 const char* MemSSAStat::NumOfStoreHasChi = "StoreHasChi";	///< Number of stores which have chi
 const char* MemSSAStat::NumOfBBHasMSSAPhi = "BBHasMSSAPhi";	///< Number of basic blocks which have mssa phi
+const char* MemSSAStat::NumOfModRefSCC = "ModRefSCC";	///< Number of call graph SCCs in mod-ref analysis
+const char* MemSSAStat::NumOfMaxModRefSCC = "MaxModRefSCCSize";	///< Number of functions in the slowest call graph SCC
 
 /*!
  * Constructor
@@ -118,8 +122,25 @@ void MemSSAStat::performStat()
     PTNumStatMap[NumOfStoreHasChi] = mssa->getStoreToChiSetMap().size();
     PTNumStatMap[NumOfBBHasMSSAPhi] = mssa->getBBToPhiSetMap().size();
 
+    const MRGenerator::SCCToTimeMap& sccTimeMap = mrGenerator->getSCCModRefTimeMap();
+    NodeID maxSCC = 0;
+    double maxSCCTime = -1;
+    for (const auto& it : sccTimeMap)
+    {
+        if (it.second > maxSCCTime)
+        {
+            maxSCC = it.first;
+            maxSCCTime = it.second;
+        }
+    }
+    timeStatMap[TimeOfMaxSCCModRef] = sccTimeMap.empty() ? 0 : maxSCCTime;
+    PTNumStatMap[NumOfModRefSCC] = sccTimeMap.size();
+    PTNumStatMap[NumOfMaxModRefSCC] = sccTimeMap.empty() ? 0 : mrGenerator->getCallGraphSCC()->subNodes(maxSCC).count();
+
     printStat();
 
+    printHotModRefSCCs();
+
 }
 
 /*!
@@ -130,6 +151,36 @@ void MemSSAStat::printStat(string str)
     PTAStat::printStat("Memory SSA Statistics");
 }
 
+/*!
+ * Print the call graph SCCs which take the most time in mod-ref analysis,
+ * to spot hot recursive clusters
+ */
+void MemSSAStat::printHotModRefSCCs(u32_t num)
+{
+    MRGenerator* mrGenerator = mssa->getMRGenerator();
+    const MRGenerator::SCCToTimeMap& sccTimeMap = mrGenerator->getSCCModRefTimeMap();
+    std::vector<std::pair<double, NodeID>> sccTimes;
+    for (const auto& it : sccTimeMap)
+        sccTimes.push_back(std::make_pair(it.second, it.first));
+    std::sort(sccTimes.begin(), sccTimes.end(), std::greater<std::pair<double, NodeID>>());
+    if (sccTimes.size() > num)
+        sccTimes.resize(num);
+
+    if (sccTimes.empty())
+        return;
+
+    const CallGraph* callGraph = mssa->getPTA()->getCallGraph();
+    SVFUtil::outs() << "Hot call graph SCCs in mod-ref analysis (time, size, functions):\n";
+    for (const std::pair<double, NodeID>& sccTime : sccTimes)
+    {
+        const NodeBS& subNodes = mrGenerator->getCallGraphSCC()->subNodes(sccTime.second);
+        SVFUtil::outs() << "  " << sccTime.first << "\t" << subNodes.count() << "\t{ ";
+        for (NodeID sub : subNodes)
+            SVFUtil::outs() << callGraph->getCallGraphNode(sub)->getFunction()->getName() << " ";
+        SVFUtil::outs() << "}\n";
+    }
+}
+
 /*!
  * Constructor
  */
@@ -143,6 +194,10 @@ SVFGStat::SVFGStat(SVFG* g) : PTAStat(nullptr)
     addTopLevelNodeTimeStart = addTopLevelNodeTimeEnd = 0;
     addAddrTakenNodeTimeStart = addAddrTakenNodeTimeEnd = 0;
     svfgOptTimeStart = svfgOptTimeEnd = 0;
+    svfgOptInterTimeStart = svfgOptInterTimeEnd = 0;
+    svfgOptIntraTimeStart = svfgOptIntraTimeEnd = 0;
+    svfgOptMergeTimeStart = svfgOptMergeTimeEnd = 0;
+    numOfOptRemovedNodes = numOfOptRemovedEdges = 0;
 }
 
 void SVFGStat::clear()
@@ -195,6 +250,12 @@ void SVFGStat::performStat()
 
     timeStatMap["OptTime"] = (svfgOptTimeEnd - svfgOptTimeStart)/TIMEINTERVAL;
 
+    timeStatMap["OptInterTime"] = (svfgOptInterTimeEnd - svfgOptInterTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["OptIntraTime"] = (svfgOptIntraTimeEnd - svfgOptIntraTimeStart)/TIMEINTERVAL;
+
+    timeStatMap["OptMergeTime"] = (svfgOptMergeTimeEnd - svfgOptMergeTimeStart)/TIMEINTERVAL;
+
     PTNumStatMap["TotalNode"] = numOfNodes;
 
     PTNumStatMap["FormalIn"] = numOfFormalIn;
@@ -216,6 +277,9 @@ void SVFGStat::performStat()
     PTNumStatMap["PHI"] = numOfPhi;
     PTNumStatMap["MSSAPhi"] = numOfMSSAPhi;
 
+    PTNumStatMap["OptRemovedNode"] = numOfOptRemovedNodes;
+    PTNumStatMap["OptRemovedEdge"] = numOfOptRemovedEdges;
+
     timeStatMap["AvgWeight"] = (totalIndInEdge == 0) ? 0 : ((double)avgWeight / totalIndInEdge);
 
     PTNumStatMap["TotalEdge"] = totalInEdge;
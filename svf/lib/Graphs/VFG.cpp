@@ -33,6 +33,8 @@
 #include "Graphs/VFG.h"
 #include "SVFIR/SVFModule.h"
 #include "Util/SVFUtil.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -742,132 +744,241 @@ VFGEdge* VFG::addRetEdge(NodeID srcId, NodeID dstId, CallSiteID csId)
 void VFG::connectDirectVFGEdges()
 {
 
+    if (Options::SVFGThreads() > 1)
+    {
+        connectIntraDirectVFGEdgesInParallel(Options::SVFGThreads());
+    }
+    else
+    {
+        for(iterator it = begin(), eit = end(); it!=eit; ++it)
+        {
+            NodeIDPairList edges;
+            collectIntraDirectVFGEdges(it->second, edges);
+            for (const std::pair<NodeID, NodeID>& edge : edges)
+                addIntraDirectVFEdge(edge.first, edge.second);
+        }
+    }
+
     for(iterator it = begin(), eit = end(); it!=eit; ++it)
     {
-        NodeID nodeId = it->first;
-        VFGNode* node = it->second;
+        connectInterDirectVFGEdges(it->second);
+    }
 
-        if(StmtVFGNode* stmtNode = SVFUtil::dyn_cast<StmtVFGNode>(node))
+    /// connect direct value-flow edges (parameter passing) for thread fork/join
+    if(Options::EnableThreadCallGraph())
+    {
+        /// add fork edge
+        SVFStmt::SVFStmtSetTy& forks = getPAGEdgeSet(SVFStmt::ThreadFork);
+        for (SVFStmt::SVFStmtSetTy::iterator iter = forks.begin(), eiter =
+                    forks.end(); iter != eiter; ++iter)
         {
-            /// do not handle AddrSVFG node, as it is already the source of a definition
-            if(SVFUtil::isa<AddrVFGNode>(stmtNode))
-                continue;
-            /// for all other cases, like copy/gep/load/ret, connect the RHS pointer to its def
-            if (stmtNode->getPAGSrcNode()->isConstDataOrAggDataButNotNullPtr() == false)
-                // for ptr vfg, we skip src node of integer type if it is at a int2ptr copystmt
-                if(isInterestedPAGNode(stmtNode->getPAGSrcNode()))
-                    addIntraDirectVFEdge(getDef(stmtNode->getPAGSrcNode()), nodeId);
-            if (const GepStmt* gepStmt = SVFUtil::dyn_cast<GepStmt>(stmtNode->getPAGEdge()))
-            {
-                for (const auto &varType: gepStmt->getOffsetVarAndGepTypePairVec())
-                {
-                    if(varType.first->isConstDataOrAggDataButNotNullPtr() || isInterestedPAGNode(varType.first) == false)
-                        continue;
-                    addIntraDirectVFEdge(getDef(varType.first), nodeId);
-                }
-            }
-            /// for store, connect the RHS/LHS pointer to its def
-            if(SVFUtil::isa<StoreVFGNode>(stmtNode) && (stmtNode->getPAGDstNode()->isConstDataOrAggDataButNotNullPtr() == false))
-            {
-                addIntraDirectVFEdge(getDef(stmtNode->getPAGDstNode()), nodeId);
-            }
-
+            TDForkPE* forkedge = SVFUtil::cast<TDForkPE>(*iter);
+            ActualParmVFGNode* acutalParm = getActualParmVFGNode(forkedge->getRHSVar(),forkedge->getCallSite());
+            FormalParmVFGNode* formalParm = getFormalParmVFGNode(forkedge->getLHSVar());
+            addInterEdgeFromAPToFP(acutalParm,formalParm,getCallSiteID(forkedge->getCallSite(), formalParm->getFun()));
         }
-        else if(PHIVFGNode* phiNode = SVFUtil::dyn_cast<PHIVFGNode>(node))
+        /// add join edge
+        SVFStmt::SVFStmtSetTy& joins = getPAGEdgeSet(SVFStmt::ThreadJoin);
+        for (SVFStmt::SVFStmtSetTy::iterator iter = joins.begin(), eiter =
+                    joins.end(); iter != eiter; ++iter)
         {
-            for (PHIVFGNode::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd(); it != eit; it++)
-            {
-                if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
-                    addIntraDirectVFEdge(getDef(it->second), nodeId);
-            }
+            TDJoinPE* joinedge = SVFUtil::cast<TDJoinPE>(*iter);
+            NodeID callsiteRev = getDef(joinedge->getLHSVar());
+            FormalRetVFGNode* calleeRet = getFormalRetVFGNode(joinedge->getRHSVar());
+            addRetEdge(calleeRet->getId(),callsiteRev, getCallSiteID(joinedge->getCallSite(), calleeRet->getFun()));
         }
-        else if(BinaryOPVFGNode* binaryNode = SVFUtil::dyn_cast<BinaryOPVFGNode>(node))
+    }
+}
+
+/*!
+ * Collect the intra-procedural direct value-flows (def -> use) into a node
+ */
+void VFG::collectIntraDirectVFGEdges(const VFGNode* node, NodeIDPairList& edges) const
+{
+    NodeID nodeId = node->getId();
+
+    if(const StmtVFGNode* stmtNode = SVFUtil::dyn_cast<StmtVFGNode>(node))
+    {
+        /// do not handle AddrSVFG node, as it is already the source of a definition
+        if(SVFUtil::isa<AddrVFGNode>(stmtNode))
+            return;
+        /// for all other cases, like copy/gep/load/ret, connect the RHS pointer to its def
+        if (stmtNode->getPAGSrcNode()->isConstDataOrAggDataButNotNullPtr() == false)
+            // for ptr vfg, we skip src node of integer type if it is at a int2ptr copystmt
+            if(isInterestedPAGNode(stmtNode->getPAGSrcNode()))
+                edges.push_back(std::make_pair(getDef(stmtNode->getPAGSrcNode()), nodeId));
+        if (const GepStmt* gepStmt = SVFUtil::dyn_cast<GepStmt>(stmtNode->getPAGEdge()))
         {
-            for (BinaryOPVFGNode::OPVers::const_iterator it = binaryNode->opVerBegin(), eit = binaryNode->opVerEnd(); it != eit; it++)
+            for (const auto &varType: gepStmt->getOffsetVarAndGepTypePairVec())
             {
-                if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
-                    addIntraDirectVFEdge(getDef(it->second), nodeId);
+                if(varType.first->isConstDataOrAggDataButNotNullPtr() || isInterestedPAGNode(varType.first) == false)
+                    continue;
+                edges.push_back(std::make_pair(getDef(varType.first), nodeId));
             }
         }
-        else if(UnaryOPVFGNode* unaryNode = SVFUtil::dyn_cast<UnaryOPVFGNode>(node))
+        /// for store, connect the RHS/LHS pointer to its def
+        if(SVFUtil::isa<StoreVFGNode>(stmtNode) && (stmtNode->getPAGDstNode()->isConstDataOrAggDataButNotNullPtr() == false))
         {
-            for (UnaryOPVFGNode::OPVers::const_iterator it = unaryNode->opVerBegin(), eit = unaryNode->opVerEnd(); it != eit; it++)
-            {
-                if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
-                    addIntraDirectVFEdge(getDef(it->second), nodeId);
-            }
+            edges.push_back(std::make_pair(getDef(stmtNode->getPAGDstNode()), nodeId));
         }
-        else if(CmpVFGNode* cmpNode = SVFUtil::dyn_cast<CmpVFGNode>(node))
+
+    }
+    else if(const PHIVFGNode* phiNode = SVFUtil::dyn_cast<PHIVFGNode>(node))
+    {
+        for (PHIVFGNode::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd(); it != eit; it++)
         {
-            for (CmpVFGNode::OPVers::const_iterator it = cmpNode->opVerBegin(), eit = cmpNode->opVerEnd(); it != eit; it++)
-            {
-                if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
-                    addIntraDirectVFEdge(getDef(it->second), nodeId);
-            }
+            if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
+                edges.push_back(std::make_pair(getDef(it->second), nodeId));
         }
-        else if(BranchVFGNode* branchNode = SVFUtil::dyn_cast<BranchVFGNode>(node))
+    }
+    else if(const BinaryOPVFGNode* binaryNode = SVFUtil::dyn_cast<BinaryOPVFGNode>(node))
+    {
+        for (BinaryOPVFGNode::OPVers::const_iterator it = binaryNode->opVerBegin(), eit = binaryNode->opVerEnd(); it != eit; it++)
         {
-            const SVFVar* cond = branchNode->getBranchStmt()->getCondition();
-            if (cond->isConstDataOrAggDataButNotNullPtr() == false)
-                addIntraDirectVFEdge(getDef(cond), nodeId);
+            if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
+                edges.push_back(std::make_pair(getDef(it->second), nodeId));
         }
-        else if(ActualParmVFGNode* actualParm = SVFUtil::dyn_cast<ActualParmVFGNode>(node))
+    }
+    else if(const UnaryOPVFGNode* unaryNode = SVFUtil::dyn_cast<UnaryOPVFGNode>(node))
+    {
+        for (UnaryOPVFGNode::OPVers::const_iterator it = unaryNode->opVerBegin(), eit = unaryNode->opVerEnd(); it != eit; it++)
         {
-            if (actualParm->getParam()->isConstDataOrAggDataButNotNullPtr() == false)
-                addIntraDirectVFEdge(getDef(actualParm->getParam()), nodeId);
+            if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
+                edges.push_back(std::make_pair(getDef(it->second), nodeId));
         }
-        else if(FormalParmVFGNode* formalParm = SVFUtil::dyn_cast<FormalParmVFGNode>(node))
+    }
+    else if(const CmpVFGNode* cmpNode = SVFUtil::dyn_cast<CmpVFGNode>(node))
+    {
+        for (CmpVFGNode::OPVers::const_iterator it = cmpNode->opVerBegin(), eit = cmpNode->opVerEnd(); it != eit; it++)
         {
-            for(CallPESet::const_iterator it = formalParm->callPEBegin(), eit = formalParm->callPEEnd();
-                    it!=eit; ++it)
-            {
-                const CallICFGNode* cs = (*it)->getCallSite();
-                ActualParmVFGNode* acutalParm = getActualParmVFGNode((*it)->getRHSVar(),cs);
-                addInterEdgeFromAPToFP(acutalParm,formalParm,getCallSiteID(cs, formalParm->getFun()));
-            }
+            if (it->second->isConstDataOrAggDataButNotNullPtr() == false)
+                edges.push_back(std::make_pair(getDef(it->second), nodeId));
         }
-        else if(FormalRetVFGNode* calleeRet = SVFUtil::dyn_cast<FormalRetVFGNode>(node))
+    }
+    else if(const BranchVFGNode* branchNode = SVFUtil::dyn_cast<BranchVFGNode>(node))
+    {
+        const SVFVar* cond = branchNode->getBranchStmt()->getCondition();
+        if (cond->isConstDataOrAggDataButNotNullPtr() == false)
+            edges.push_back(std::make_pair(getDef(cond), nodeId));
+    }
+    else if(const ActualParmVFGNode* actualParm = SVFUtil::dyn_cast<ActualParmVFGNode>(node))
+    {
+        if (actualParm->getParam()->isConstDataOrAggDataButNotNullPtr() == false)
+            edges.push_back(std::make_pair(getDef(actualParm->getParam()), nodeId));
+    }
+    else if(const FormalRetVFGNode* calleeRet = SVFUtil::dyn_cast<FormalRetVFGNode>(node))
+    {
+        /// connect formal ret to its definition node
+        edges.push_back(std::make_pair(getDef(calleeRet->getRet()), nodeId));
+    }
+}
+
+/*!
+ * Connect the inter-procedural direct value-flows (parameter passing) into a node
+ */
+void VFG::connectInterDirectVFGEdges(VFGNode* node)
+{
+    if(FormalParmVFGNode* formalParm = SVFUtil::dyn_cast<FormalParmVFGNode>(node))
+    {
+        for(CallPESet::const_iterator it = formalParm->callPEBegin(), eit = formalParm->callPEEnd();
+                it!=eit; ++it)
         {
-            /// connect formal ret to its definition node
-            addIntraDirectVFEdge(getDef(calleeRet->getRet()), nodeId);
+            const CallICFGNode* cs = (*it)->getCallSite();
+            ActualParmVFGNode* acutalParm = getActualParmVFGNode((*it)->getRHSVar(),cs);
+            addInterEdgeFromAPToFP(acutalParm,formalParm,getCallSiteID(cs, formalParm->getFun()));
+        }
+    }
+    else if(FormalRetVFGNode* calleeRet = SVFUtil::dyn_cast<FormalRetVFGNode>(node))
+    {
+        /// connect formal ret to actual ret
+        for(RetPESet::const_iterator it = calleeRet->retPEBegin(), eit = calleeRet->retPEEnd(); it!=eit; ++it)
+        {
+            ActualRetVFGNode* callsiteRev = getActualRetVFGNode((*it)->getLHSVar());
+            const CallICFGNode* retBlockNode = (*it)->getCallSite();
+            CallICFGNode* callBlockNode = pag->getICFG()->getCallICFGNode(retBlockNode->getCallSite());
+            addInterEdgeFromFRToAR(calleeRet,callsiteRev, getCallSiteID(callBlockNode, calleeRet->getFun()));
+        }
+    }
+}
 
-            /// connect formal ret to actual ret
-            for(RetPESet::const_iterator it = calleeRet->retPEBegin(), eit = calleeRet->retPEEnd(); it!=eit; ++it)
-            {
-                ActualRetVFGNode* callsiteRev = getActualRetVFGNode((*it)->getLHSVar());
-                const CallICFGNode* retBlockNode = (*it)->getCallSite();
-                CallICFGNode* callBlockNode = pag->getICFG()->getCallICFGNode(retBlockNode->getCallSite());
-                addInterEdgeFromFRToAR(calleeRet,callsiteRev, getCallSiteID(callBlockNode, calleeRet->getFun()));
-            }
+/*!
+ * Connect intra-procedural direct value-flows function by function in parallel.
+ * A worker only adds edges whose two ends are in the function it handles, as
+ * nodes of different functions never share edge sets. Edges from/to nodes
+ * outside any function (e.g., globals) are buffered and added afterwards.
+ */
+void VFG::connectIntraDirectVFGEdgesInParallel(u32_t numThreads)
+{
+    std::vector<const SVFFunction*> funs;
+    std::vector<std::vector<NodeID>> groups;
+    getNodeGroupsOfFunctions(funs, groups);
+
+    std::vector<NodeIDPairList> deferredEdges(groups.size());
+    parallelForEach(groups.size(), numThreads, [this, &funs, &groups, &deferredEdges](u32_t i)
+    {
+        const SVFFunction* fun = funs[i];
+        NodeIDPairList edges;
+        for (NodeID id : groups[i])
+            collectIntraDirectVFGEdges(getVFGNode(id), edges);
+        for (const std::pair<NodeID, NodeID>& edge : edges)
+        {
+            if (fun != nullptr && getVFGNode(edge.first)->getFun() == fun)
+                addIntraDirectVFEdge(edge.first, edge.second);
+            else
+                deferredEdges[i].push_back(edge);
         }
-        /// Do not process FormalRetVFGNode, as they are connected by copy within callee
-        /// We assume one procedure only has unique return
+    });
+
+    for (const NodeIDPairList& edges : deferredEdges)
+    {
+        for (const std::pair<NodeID, NodeID>& edge : edges)
+            addIntraDirectVFEdge(edge.first, edge.second);
     }
+}
 
-    /// connect direct value-flow edges (parameter passing) for thread fork/join
-    if(Options::EnableThreadCallGraph())
+/*!
+ * Group node IDs by their functions in ID order
+ */
+void VFG::getNodeGroupsOfFunctions(std::vector<const SVFFunction*>& funs, std::vector<std::vector<NodeID>>& groups) const
+{
+    Map<const SVFFunction*, u32_t> funToGroup;
+    std::vector<NodeID> nonFunNodes;
+    for(const_iterator it = begin(), eit = end(); it!=eit; ++it)
     {
-        /// add fork edge
-        SVFStmt::SVFStmtSetTy& forks = getPAGEdgeSet(SVFStmt::ThreadFork);
-        for (SVFStmt::SVFStmtSetTy::iterator iter = forks.begin(), eiter =
-                    forks.end(); iter != eiter; ++iter)
+        const SVFFunction* fun = it->second->getFun();
+        if (fun == nullptr)
         {
-            TDForkPE* forkedge = SVFUtil::cast<TDForkPE>(*iter);
-            ActualParmVFGNode* acutalParm = getActualParmVFGNode(forkedge->getRHSVar(),forkedge->getCallSite());
-            FormalParmVFGNode* formalParm = getFormalParmVFGNode(forkedge->getLHSVar());
-            addInterEdgeFromAPToFP(acutalParm,formalParm,getCallSiteID(forkedge->getCallSite(), formalParm->getFun()));
+            nonFunNodes.push_back(it->first);
+            continue;
         }
-        /// add join edge
-        SVFStmt::SVFStmtSetTy& joins = getPAGEdgeSet(SVFStmt::ThreadJoin);
-        for (SVFStmt::SVFStmtSetTy::iterator iter = joins.begin(), eiter =
-                    joins.end(); iter != eiter; ++iter)
+        auto git = funToGroup.find(fun);
+        if (git == funToGroup.end())
         {
-            TDJoinPE* joinedge = SVFUtil::cast<TDJoinPE>(*iter);
-            NodeID callsiteRev = getDef(joinedge->getLHSVar());
-            FormalRetVFGNode* calleeRet = getFormalRetVFGNode(joinedge->getRHSVar());
-            addRetEdge(calleeRet->getId(),callsiteRev, getCallSiteID(joinedge->getCallSite(), calleeRet->getFun()));
+            git = funToGroup.emplace(fun, groups.size()).first;
+            funs.push_back(fun);
+            groups.emplace_back();
         }
+        groups[git->second].push_back(it->first);
     }
+    funs.push_back(nullptr);
+    groups.push_back(std::move(nonFunNodes));
+}
+
+/*!
+ * Run tasks with a fixed number of workers, each picking the next unprocessed task
+ */
+void VFG::parallelForEach(u32_t numTasks, u32_t numThreads, const std::function<void(u32_t)>& task)
+{
+    std::atomic<u32_t> nextTask(0);
+    auto worker = [&nextTask, numTasks, &task]()
+    {
+        for (u32_t i = nextTask++; i < numTasks; i = nextTask++)
+            task(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (u32_t i = 0; i < numThreads; ++i) workers.push_back(std::thread(worker));
+    for (std::thread& w : workers) w.join();
 }
 
 /*!
@@ -126,14 +126,13 @@ void IntraDisjointMRG::partitionMRs()
     {
         const SVFFunction* fun = it->first;
 
+        std::vector<const NodeBS*> cptsList;
         for(PointsToList::iterator cit = it->second.begin(), ecit = it->second.end();
                 cit!=ecit; ++cit)
         {
-            const NodeBS& cpts = *cit;
-
-            PointsToList& inters = getIntersList(fun);
-            computeIntersections(cpts, inters);
+            cptsList.push_back(&(*cit));
         }
+        computeDisjointPartition(cptsList, getIntersList(fun));
 
         /// Create memory regions.
         const PointsToList& inters = getIntersList(fun);
@@ -147,83 +146,38 @@ void IntraDisjointMRG::partitionMRs()
 }
 
 /**
- * Compute intersections between cpts and computed cpts intersections before.
+ * Compute the disjoint intersections of all cpts in cptsList in one pass.
+ * Two objects are in the same intersection iff they are contained in exactly
+ * the same cpts, so each object gets a signature ID which is refined by every
+ * cpts containing it (objects of signature s inside cpts move to a new
+ * signature s'), and objects are finally grouped by signature.
+ * This gives the same intersections as repeatedly splitting the intersections
+ * computed so far by each cpts, in time linear in the total size of cptsList.
  */
-void IntraDisjointMRG::computeIntersections(const NodeBS& cpts, PointsToList& inters)
+void IntraDisjointMRG::computeDisjointPartition(const std::vector<const NodeBS*>& cptsList, PointsToList& inters)
 {
-    if (inters.find(cpts) != inters.end())
-    {
-        // Skip this cpts if it is already in the map.
-        return;
-    }
-    else if (cpts.count() == 1)
+    /// Signature 0 is reserved for objects not contained in any cpts
+    Map<NodeID, u32_t> objToSig;
+    u32_t sigNum = 0;
+    for (const NodeBS* cpts : cptsList)
     {
-        // If this cpts has only one element, it will not intersect with any cpts in inters,
-        // just add it into intersection set.
-        inters.insert(cpts);
-        return;
-    }
-    else
-    {
-        PointsToList toBeDeleted;
-        PointsToList newInters;
-
-        NodeBS cpts_copy = cpts;	// make a copy since cpts may be changed.
-
-        // check intersections with existing cpts in subSetMap
-        for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
-                interIt != interEit; ++interIt)
+        Map<u32_t, u32_t> refinedSig;
+        for (NodeID obj : *cpts)
         {
-            const NodeBS& inter = *interIt;
-
-            if (cpts_copy.intersects(inter))
-            {
-                // compute intersection between cpts and inter
-                NodeBS new_inter = inter;
-                new_inter &= cpts_copy;
-
-                // remove old intersection and add new one if possible
-                if (new_inter != inter)
-                {
-                    toBeDeleted.insert(inter);
-                    newInters.insert(new_inter);
-
-                    // compute complement after intersection
-                    NodeBS complement = inter;
-                    complement.intersectWithComplement(new_inter);
-                    if (complement.empty() == false)
-                    {
-                        newInters.insert(complement);
-                    }
-                }
-
-                cpts_copy.intersectWithComplement(new_inter);
-
-                if (cpts_copy.empty())
-                    break;
-            }
+            u32_t& sig = objToSig[obj];
+            auto rit = refinedSig.find(sig);
+            if (rit == refinedSig.end())
+                rit = refinedSig.emplace(sig, ++sigNum).first;
+            sig = rit->second;
         }
+    }
 
-        // remove old intersections
-        for (PointsToList::const_iterator it = toBeDeleted.begin(), eit = toBeDeleted.end();
-                it != eit; ++it)
-        {
-            const NodeBS& temp_cpts = *it;
-            inters.erase(temp_cpts);
-        }
+    Map<u32_t, NodeBS> sigToObjs;
+    for (const auto& it : objToSig)
+        sigToObjs[it.second].set(it.first);
 
-        // add new intersections
-        for (PointsToList::const_iterator it = newInters.begin(), eit = newInters.end();
-                it != eit; ++it)
-        {
-            const NodeBS& temp_cpts = *it;
-            inters.insert(temp_cpts);
-        }
-
-        // add remaining set into inters
-        if (cpts_copy.empty() == false)
-            inters.insert(cpts_copy);
-    }
+    for (const auto& it : sigToObjs)
+        inters.insert(it.second);
 }
 
 /**
@@ -269,17 +223,26 @@ void IntraDisjointMRG::getMRsForCallSiteRef(MRSet& aliasMRs, const NodeBS& cpts,
 void InterDisjointMRG::partitionMRs()
 {
     /// Generate disjoint cpts.
+    std::vector<const NodeBS*> cptsList;
     for(FunToPointsTosMap::iterator it = getFunToPointsToList().begin(),
             eit = getFunToPointsToList().end(); it!=eit; ++it)
     {
         for(PointsToList::iterator cit = it->second.begin(), ecit = it->second.end();
                 cit!=ecit; ++cit)
         {
-            const NodeBS& cpts = *cit;
-
-            computeIntersections(cpts, inters);
+            cptsList.push_back(&(*cit));
         }
     }
+    computeDisjointPartition(cptsList, inters);
+
+    /// Every intersection is either contained in or disjoint from a cpts,
+    /// so the intersections of a cpts are found via the objects in it.
+    Map<NodeID, const NodeBS*> objToInter;
+    for (const NodeBS& inter : inters)
+    {
+        for (NodeID obj : inter)
+            objToInter[obj] = &inter;
+    }
 
     /// Create memory regions.
     for(FunToPointsTosMap::iterator it = getFunToPointsToList().begin(),
@@ -292,13 +255,21 @@ void InterDisjointMRG::partitionMRs()
         {
             const NodeBS& cpts = *cit;
 
-            for (PointsToList::const_iterator interIt = inters.begin(), interEit = inters.end();
-                    interIt != interEit; ++interIt)
+            Set<const NodeBS*> visited;
+            std::vector<const NodeBS*> cptsInters;
+            for (NodeID obj : cpts)
             {
-                const NodeBS& inter = *interIt;
-                if (cpts.contains(inter))
-                    createDisjointMR(fun, inter);
+                const NodeBS* inter = objToInter.at(obj);
+                if (visited.insert(inter).second)
+                    cptsInters.push_back(inter);
             }
+            /// Keep the order of inters so that regions are created in the same order
+            std::sort(cptsInters.begin(), cptsInters.end(), [](const NodeBS* lhs, const NodeBS* rhs)
+            {
+                return SVFUtil::equalNodeBS()(*lhs, *rhs);
+            });
+            for (const NodeBS* inter : cptsInters)
+                createDisjointMR(fun, *inter);
         }
     }
 }
@@ -31,6 +31,10 @@
 #include "SVFIR/SVFModule.h"
 #include "MSSA/MemRegion.h"
 #include "MSSA/MSSAMuChi.h"
+#include "Util/SVFStat.h"
+#include <queue>
+#include <thread>
+#include <condition_variable>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -238,19 +242,29 @@ void MRGenerator::collectModRefForCall()
 
     DBOUT(DGENERAL, outs() << pasMsg("\t\tPerform Callsite Mod-Ref \n"));
 
-    WorkList worklist;
-    getCallGraphSCCRevTopoOrder(worklist);
-
-    while(!worklist.empty())
+    if (Options::ModRefThreads() > 1)
     {
-        NodeID callGraphNodeID = worklist.pop();
-        /// handle all sub scc nodes of this rep node
-        const NodeBS& subNodes = callGraphSCC->subNodes(callGraphNodeID);
-        for(NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it!=eit; ++it)
+        parallelModRefAnalysis(Options::ModRefThreads());
+    }
+    else
+    {
+        WorkList worklist;
+        getCallGraphSCCRevTopoOrder(worklist);
+
+        while(!worklist.empty())
         {
-            CallGraphNode* subCallGraphNode = callGraph->getCallGraphNode(*it);
-            /// Get mod-ref of all callsites calling callGraphNode
-            modRefAnalysis(subCallGraphNode,worklist);
+            NodeID callGraphNodeID = worklist.pop();
+            double sccStart = SVFStat::getClk(true);
+            /// handle all sub scc nodes of this rep node
+            const NodeBS& subNodes = callGraphSCC->subNodes(callGraphNodeID);
+            for(NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it!=eit; ++it)
+            {
+                CallGraphNode* subCallGraphNode = callGraph->getCallGraphNode(*it);
+                /// Get mod-ref of all callsites calling callGraphNode
+                modRefAnalysis(subCallGraphNode,worklist);
+            }
+            if (!subNodes.empty())
+                sccModRefTimeMap[callGraphNodeID] += (SVFStat::getClk(true) - sccStart) / TIMEINTERVAL;
         }
     }
 
@@ -434,7 +448,12 @@ bool MRGenerator::addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeB
         refset &= getCallSiteArgsPts(cs);
         getEscapObjviaGlobals(refset,refs);
         addRefSideEffectOfFunction(cs->getCaller(),refset);
-        return csToRefsMap[cs] |= refset;
+        NodeBS* csRefs;
+        {
+            std::lock_guard<std::mutex> guard(csSideEffectMutex);
+            csRefs = &csToRefsMap[cs];
+        }
+        return *csRefs |= refset;
     }
     return false;
 }
@@ -450,7 +469,12 @@ bool MRGenerator::addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeB
         modset &= (getCallSiteArgsPts(cs) | getCallSiteRetPts(cs));
         getEscapObjviaGlobals(modset,mods);
         addModSideEffectOfFunction(cs->getCaller(),modset);
-        return csToModsMap[cs] |= modset;
+        NodeBS* csMods;
+        {
+            std::lock_guard<std::mutex> guard(csSideEffectMutex);
+            csMods = &csToModsMap[cs];
+        }
+        return *csMods |= modset;
     }
     return false;
 }
@@ -471,6 +495,144 @@ void MRGenerator::getCallGraphSCCRevTopoOrder(WorkList& worklist)
     }
 }
 
+/*!
+ * Bottom-up mod-ref analysis over the condensed call graph (a DAG of SCCs).
+ * An SCC becomes ready as soon as all of its callee SCCs are done, and ready
+ * SCCs are processed concurrently by numThreads workers.
+ *
+ * Each SCC only pulls mod-ref from its callees into its own callsites and
+ * functions, so a worker writes to the side-effect sets of its own SCC and
+ * only reads those of finished SCCs.
+ */
+void MRGenerator::parallelModRefAnalysis(u32_t numThreads)
+{
+    /// Build the SCC DAG: the number of unfinished callee SCCs of each SCC and the callers of each SCC
+    Map<NodeID, u32_t> pendingCallees;
+    Map<NodeID, NodeBS> callerSCCs;
+    for (const auto& item : *callGraph)
+    {
+        NodeID rep = item.first;
+        if (callGraphSCC->repNode(rep) != rep)
+            continue;
+        NodeBS calleeSCCs;
+        for (NodeID sub : callGraphSCC->subNodes(rep))
+        {
+            CallGraphNode* node = callGraph->getCallGraphNode(sub);
+            /// "Touch" maps so we don't need to lock on them.
+            funToRefsMap[node->getFunction()];
+            funToModsMap[node->getFunction()];
+            for (const CallGraphEdge* edge : node->getOutEdges())
+            {
+                NodeID calleeRep = callGraphSCC->repNode(edge->getDstID());
+                if (calleeRep != rep)
+                    calleeSCCs.set(calleeRep);
+                for (const CallICFGNode* cs : edge->getDirectCalls())
+                {
+                    csToCallSiteArgsPtsMap[cs];
+                    csToCallSiteRetPtsMap[cs];
+                }
+                for (const CallICFGNode* cs : edge->getIndirectCalls())
+                {
+                    csToCallSiteArgsPtsMap[cs];
+                    csToCallSiteRetPtsMap[cs];
+                }
+            }
+        }
+        pendingCallees[rep] = calleeSCCs.count();
+        for (NodeID calleeRep : calleeSCCs)
+            callerSCCs[calleeRep].set(rep);
+        callerSCCs[rep];
+        sccModRefTimeMap[rep] = 0;
+    }
+
+    std::queue<NodeID> readySCCs;
+    for (const auto& it : pendingCallees)
+    {
+        if (it.second == 0)
+            readySCCs.push(it.first);
+    }
+
+    u32_t numUnfinished = pendingCallees.size();
+    std::mutex schedulerMutex;
+    std::condition_variable schedulerCV;
+
+    auto modRefWorker = [this, &pendingCallees, &callerSCCs, &readySCCs, &numUnfinished,
+                                 &schedulerMutex, &schedulerCV]()
+    {
+        while (true)
+        {
+            NodeID rep;
+            {
+                std::unique_lock<std::mutex> lock(schedulerMutex);
+                schedulerCV.wait(lock, [&]()
+                {
+                    return !readySCCs.empty() || numUnfinished == 0;
+                });
+                // All SCCs are done.
+                if (readySCCs.empty()) return;
+                rep = readySCCs.front();
+                readySCCs.pop();
+            }
+
+            double sccStart = SVFStat::getClk(true);
+            modRefAnalysisOfSCC(rep);
+            sccModRefTimeMap.at(rep) = (SVFStat::getClk(true) - sccStart) / TIMEINTERVAL;
+
+            {
+                std::lock_guard<std::mutex> guard(schedulerMutex);
+                --numUnfinished;
+                for (NodeID callerRep : callerSCCs.at(rep))
+                {
+                    if (--pendingCallees.at(callerRep) == 0)
+                        readySCCs.push(callerRep);
+                }
+            }
+            schedulerCV.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (u32_t i = 0; i < numThreads; ++i) workers.push_back(std::thread(modRefWorker));
+    for (std::thread& worker : workers) worker.join();
+
+    assert(numUnfinished == 0 && "MRGenerator::parallelModRefAnalysis: call graph SCCs left unprocessed!");
+}
+
+/*!
+ * Mod-Ref analysis of all callsites inside the SCC represented by rep.
+ * All callee SCCs have been processed, so iterate until the mod-ref of the
+ * callsites reaches a fixed point (a single pass suffices without recursion).
+ */
+void MRGenerator::modRefAnalysisOfSCC(NodeID rep)
+{
+    bool inCycle = callGraphSCC->isInCycle(rep);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (NodeID sub : callGraphSCC->subNodes(rep))
+        {
+            CallGraphNode* callGraphNode = callGraph->getCallGraphNode(sub);
+            for (const CallGraphEdge* edge : callGraphNode->getOutEdges())
+            {
+                const SVFFunction* callee = edge->getDstNode()->getFunction();
+                for (const CallICFGNode* cs : edge->getDirectCalls())
+                {
+                    NodeBS mod, ref;
+                    changed |= handleCallsiteModRef(mod, ref, cs, callee);
+                }
+                for (const CallICFGNode* cs : edge->getIndirectCalls())
+                {
+                    NodeBS mod, ref;
+                    changed |= handleCallsiteModRef(mod, ref, cs, callee);
+                }
+            }
+        }
+        if (!inCycle)
+            break;
+    }
+}
+
 /*!
  * Get all objects might pass into and pass out of callee(s) from a callsite
  */
@@ -563,9 +725,12 @@ void MRGenerator::getEscapObjviaGlobals(NodeBS& globs, const NodeBS& calleeModRe
         const MemObj* obj = pta->getPAG()->getObject(*it);
         (void)obj; // Suppress warning of unused variable under release build
         assert(obj && "object not found!!");
-        if(allGlobals.test(*it))
-            globs.set(*it);
     }
+    /// Intersect rather than test() each object, as test() moves the cached
+    /// iterator of allGlobals, which is shared by the mod-ref workers
+    NodeBS escaped = calleeModRef;
+    escaped &= allGlobals;
+    globs |= escaped;
 }
 
 /*!
@@ -603,6 +768,8 @@ bool MRGenerator::handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGN
     /// if a callee is a heap allocator function, then its mod set of this callsite is the heap object.
     if(isHeapAllocExtCall(cs->getCallSite()))
     {
+        if (!hasSVFStmtList(cs->getCallSite()))
+            return false;
         SVFStmtList& pagEdgeList = getPAGEdgesFromInst(cs->getCallSite());
         for (SVFStmtList::const_iterator bit = pagEdgeList.begin(),
                 ebit = pagEdgeList.end(); bit != ebit; ++bit)
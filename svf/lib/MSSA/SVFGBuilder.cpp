@@ -54,10 +54,15 @@ SVFG* SVFGBuilder::buildFullSVFG(BVDataPTAImpl* pta)
 
 /*!
  * Create SVFG
+ * A function read lazily from a binary SVFG is only added on request, while most
+ * pointer analyses iterate over all nodes, so all functions are materialized here
+ * unless the client asked to materialize them itself.
  */
 void SVFGBuilder::buildSVFG()
 {
     svfg->buildSVFG();
+    if (!materializeOnDemand)
+        svfg->materializeAllFunctions();
 }
 
 /// Create DDA SVFG
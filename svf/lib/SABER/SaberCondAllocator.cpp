@@ -39,7 +39,7 @@
 using namespace SVF;
 using namespace SVFUtil;
 
-u64_t DPItem::maximumBudget = ULONG_MAX - 1;
+thread_local u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
 u32_t ContextCond::maximumCxt = 0;
 u32_t ContextCond::maximumPathLen = 0;
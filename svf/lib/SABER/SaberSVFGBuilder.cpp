@@ -43,6 +43,8 @@ void SaberSVFGBuilder::buildSVFG()
 
     MemSSA* mssa = svfg->getMSSA();
     svfg->buildSVFG();
+    /// The steps below and the checker traverse indirect edges directly
+    svfg->materializeAllFunctions();
     BVDataPTAImpl* pta = mssa->getPTA();
     DBOUT(DGENERAL, outs() << pasMsg("\tCollect Global Variables\n"));
 
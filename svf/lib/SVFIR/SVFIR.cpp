@@ -418,6 +418,7 @@ NodeID SVFIR::getGepObjVar(NodeID id, const APOffset& apOffset)
  * To support flexible field sensitive analysis with regard to MaxFieldOffset
  * offset = offset % obj->getMaxFieldOffsetLimit() to create limited number of mem objects
  * maximum number of field object creation is obj->getMaxFieldOffsetLimit()
+ * Nodes are created under a lock as parallel solvers (DDA and AE workers) may call this concurrently
  */
 NodeID SVFIR::getGepObjVar(const MemObj* obj, const APOffset& apOffset)
 {
@@ -432,6 +433,7 @@ NodeID SVFIR::getGepObjVar(const MemObj* obj, const APOffset& apOffset)
     // Base and first field are the same memory location.
     if (Options::FirstFieldEqBase() && newLS == 0) return base;
 
+    std::lock_guard<std::mutex> guard(gepObjVarLock);
     NodeOffsetMap::iterator iter = GepObjVarMap.find(std::make_pair(base, newLS));
     if (iter == GepObjVarMap.end())
     {
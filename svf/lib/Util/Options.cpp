@@ -75,6 +75,12 @@ const Option<u32_t> Options::CxtBudget(
     10000
 );
 
+const Option<u32_t> Options::CxtBudgetScale(
+    "cxt-bg-scale",
+    "Adapt context-sensitive step budgets per query, up to this multiple of cxt-bg (0: fixed budget)",
+    0
+);
+
 // DDAPass.cpp
 const Option<u32_t> Options::MaxPathLen(
     "max-path",
@@ -140,6 +146,24 @@ OptionMultiple<PointerAnalysis::PTATY> Options::DDASelected(
 }
 );
 
+const Option<u32_t> Options::DDAThreads(
+    "dda-threads",
+    "Number of threads answering DDA queries, each with its own solver",
+    1
+);
+
+const Option<std::string> Options::DDAQueryCacheFile(
+    "dda-cache",
+    "File keeping DDA query results across runs of the same module",
+    ""
+);
+
+const Option<u32_t> Options::DDABatchSize(
+    "dda-batch",
+    "Maximum number of queries of the same function answered in one batch sharing traversal state (0: no batching)",
+    0
+);
+
 // FlowDDA.cpp
 const Option<u32_t> Options::FlowBudget(
     "flow-bg",
@@ -394,6 +418,12 @@ const Option<bool> Options::IgnoreDeadFun(
     false
 );
 
+const Option<u32_t> Options::ModRefThreads(
+    "modref-threads",
+    "number of threads to use for the bottom-up mod-ref analysis over call graph SCCs",
+    1
+);
+
 
 // Base class of pointer analyses (MemSSA.cpp)
 const Option<bool> Options::DumpMSSA(
@@ -433,6 +463,12 @@ Option<bool> Options::OPTSVFG(
     false
 );
 
+const Option<u32_t> Options::SVFGThreads(
+    "svfg-threads",
+    "number of threads to use for building intra-procedural (S)VFG edges and optimising the SVFG of functions",
+    1
+);
+
 const Option<std::string> Options::WriteSVFG(
     "write-svfg",
     "Write SVFG's analysis results to a file",
@@ -445,6 +481,18 @@ const Option<std::string> Options::ReadSVFG(
     ""
 );
 
+const Option<bool> Options::SVFGBinary(
+    "svfg-binary",
+    "Write SVFG's analysis results in the binary format (-read-svfg detects the format of a file)",
+    false
+);
+
+const Option<bool> Options::SVFGLazyLoad(
+    "svfg-lazy-load",
+    "Materialize the address-taken nodes and indirect edges of a function in a binary SVFG only on request",
+    false
+);
+
 
 const Option<bool> Options::IntraLock(
     "intra-lock-td-edge",
@@ -759,6 +807,36 @@ const Option<bool> Options::POCRHybrid(
     false
 );
 
+const Option<u32_t> Options::CFLThreads(
+    "cfl-threads",
+    "Number of threads of the parallel CFL-reachability solver (1: sequential CFLSolver)",
+    1
+);
+
+const Option<bool> Options::CFLMatrix(
+    "cfl-matrix",
+    "When explicit to true, CFL reachability is solved on per-label boolean matrices.",
+    false
+);
+
+const Option<std::string> Options::CFLSolvedFile(
+    "cfl-solved-file",
+    "Start from the CFL edges solved by an earlier run in this file if they fit the graph, and save the solved edges to it",
+    ""
+);
+
+const Option<bool> Options::CFLSummary(
+    "cfl-summary",
+    "Solve the intra-procedural subgraph of each function separately and start from their summaries",
+    false
+);
+
+const Option<std::string> Options::CFLSummaryFile(
+    "cfl-summary-file",
+    "Reuse the CFL summaries of unchanged functions in this file and save the summaries to it",
+    ""
+);
+
 const Option<bool> Options::Customized(
     "customized",
     "When explicit to true, user can use any grammar file.",
@@ -773,12 +851,26 @@ const Option<bool> Options::LoopAnalysis(
 
 const Option<u32_t> Options::LoopBound(
     "loop-bound",
-    "Maximum number of loop",
+    "Maximum number of loop (used where the trip count of a loop is unknown)",
     1
 );
 
 const Option<u32_t> Options::WidenDelay(
     "widen-delay", "Loop Widen Delay", 3);
+const Option<bool> Options::AESummary(
+    "ae-summary", "Reuse the summary of a callee whose input state is subsumed by an earlier one", false);
+const Option<u32_t> Options::AESummaryLimit(
+    "ae-summary-limit", "Maximum number of summaries kept per callee, the oldest is dropped first (0: no limit)", 16);
+const Option<bool> Options::AESharedTopLevel(
+    "ae-shared-top-level", "Keep the values of top-level variables in one state shared by all nodes instead of copying them along the ICFG", false);
+const Option<u32_t> Options::AEThreads(
+    "ae-threads", "Number of threads analysing main and the functions without callers (with -run-uncall-fun)", 1);
+const Option<bool> Options::AEWidenThresholds(
+    "ae-widen-thresholds", "Widen to the constants of comparisons in the function before widening to infinity", false);
+const Option<u32_t> Options::AEExactLoopIter(
+    "ae-exact-loop-iter", "Iterate loops whose trip count (from loop analysis) is at most this bound without widening (0: off)", 0);
+const Option<std::string> Options::AEIncremental(
+    "ae-incremental", "Load the summaries of the unchanged functions from this file and save the summaries to it (implies -ae-summary, not with -ae-shared-top-level)", "");
 const Option<u32_t> Options::Timeout(
     "timeout", "time out (seconds), set -1 (no timeout), default 14400s",14400);
 const Option<std::string> Options::OutputName(
@@ -796,7 +888,7 @@ const Option<bool> Options::RaceCheck(
 const Option<bool> Options::GepUnknownIdx(
     "gep-unknown-idx","Skip Gep Unknown Index",false);
 const Option<bool> Options::RunUncallFuncs(
-    "run-uncall-fun","Skip Gep Unknown Index",false);
+    "run-uncall-fun","Also analyse the functions without callers from the global state",false);
 const Option<bool> Options::ICFGMergeAdjacentNodes(
     "icfg-merge-adjnodes","ICFG Simplification - Merge Adjacent Nodes in the Same Basic Block.",false);
 
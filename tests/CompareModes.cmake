@@ -0,0 +1,74 @@
+# Run TOOL on every bitcode file of SUITE (found in one of BC_DIRS) with REF_ARGS,
+# then RUNS times with MODE_ARGS, and fail if the exit code, stdout or stderr of a
+# run differs from the reference. @STATE@ is replaced by a per-input file, removed
+# before the reference run and before the first mode run. If the reference writes
+# it (e.g., -cfl-solved-file), the file of each mode run must have the same content.
+# Differing outputs are kept in WORK_DIR.
+#
+# cmake -DTOOL=<exe> -DBC_DIRS=<dir|dir> -DSUITE=<name> -DREF_ARGS=<arg|arg>
+#       -DMODE_ARGS=<arg|arg> -DRUNS=<n> -DWORK_DIR=<dir> -P CompareModes.cmake
+
+string(REPLACE "|" ";" BC_DIRS "${BC_DIRS}")
+string(REPLACE "|" ";" REF_ARGS "${REF_ARGS}")
+string(REPLACE "|" ";" MODE_ARGS "${MODE_ARGS}")
+
+set(inputs)
+foreach(dir ${BC_DIRS})
+  file(GLOB found "${dir}/${SUITE}/*.bc" "${dir}/${SUITE}/*.ll")
+  list(APPEND inputs ${found})
+endforeach()
+if(NOT inputs)
+  message(FATAL_ERROR "no bitcode of ${SUITE} in ${BC_DIRS}")
+endif()
+list(SORT inputs)
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+set(failures 0)
+foreach(input ${inputs})
+  get_filename_component(name "${input}" NAME)
+  set(refState "${WORK_DIR}/${name}.ref.state")
+  file(REMOVE "${refState}")
+  string(REPLACE "@STATE@" "${refState}" args "${REF_ARGS}")
+  execute_process(
+    COMMAND ${TOOL} ${args} ${input}
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE refResult OUTPUT_VARIABLE refOut ERROR_VARIABLE refErr)
+
+  set(state "${WORK_DIR}/${name}.state")
+  file(REMOVE "${state}")
+  string(REPLACE "@STATE@" "${state}" args "${MODE_ARGS}")
+  foreach(run RANGE 1 ${RUNS})
+    execute_process(
+      COMMAND ${TOOL} ${args} ${input}
+      WORKING_DIRECTORY "${WORK_DIR}"
+      RESULT_VARIABLE result OUTPUT_VARIABLE out ERROR_VARIABLE err)
+    set(sameState TRUE)
+    if(EXISTS "${refState}")
+      file(SHA256 "${refState}" refHash)
+      set(hash "")
+      if(EXISTS "${state}")
+        file(SHA256 "${state}" hash)
+      endif()
+      if(NOT hash STREQUAL refHash)
+        set(sameState FALSE)
+        message(STATUS "DIFF ${name} (run ${run}): ${state} differs from ${refState}")
+      endif()
+    endif()
+    if(NOT result STREQUAL refResult OR NOT out STREQUAL refOut OR NOT err STREQUAL refErr OR NOT sameState)
+      math(EXPR failures "${failures} + 1")
+      message(STATUS "DIFF ${name} (run ${run}): exit ${result} vs ${refResult}, outputs in ${WORK_DIR}")
+      file(WRITE "${WORK_DIR}/${name}.ref.out" "${refOut}")
+      file(WRITE "${WORK_DIR}/${name}.ref.err" "${refErr}")
+      file(WRITE "${WORK_DIR}/${name}.${run}.out" "${out}")
+      file(WRITE "${WORK_DIR}/${name}.${run}.err" "${err}")
+    endif()
+  endforeach()
+endforeach()
+
+list(LENGTH inputs numInputs)
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} runs differ from the reference (${numInputs} inputs)")
+endif()
+message(STATUS "${numInputs} inputs of ${SUITE} give the same results")
@@ -0,0 +1,170 @@
+//===- PersistentMapTest.cpp -- PersistentMap against std::map ---------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Random updates, copies, merges and comparisons of several versions of a
+ // PersistentMap, each checked against a std::map applying the same operations.
+ // Returns 1 and prints the first mismatch if they differ.
+ */
+#include <iostream>
+#include <map>
+#include <random>
+
+#include "Util/PersistentMap.h"
+
+using namespace SVF;
+
+typedef PersistentMap<s64_t> PMap;
+typedef std::map<u32_t, s64_t> RefMap;
+
+static u32_t numOfFailures = 0;
+
+static void check(bool cond, const std::string& msg, u32_t step)
+{
+    if (!cond && numOfFailures++ == 0)
+        std::cerr << "step " << step << ": " << msg << "\n";
+}
+
+/// The entries visited by the iterator, a key visited twice is reported as missing
+static RefMap toRef(const PMap& map)
+{
+    RefMap ref;
+    for (const auto& kv : map)
+    {
+        if (!ref.emplace(kv.first, kv.second).second)
+            return RefMap();
+    }
+    return ref;
+}
+
+/// Keys from a small range (dense tries) and from the whole range (deep paths)
+static u32_t randomKey(std::mt19937& rng)
+{
+    if (rng() % 2)
+        return rng() % 256;
+    return rng();
+}
+
+int main()
+{
+    const u32_t numOfVersions = 8;
+    const u32_t numOfSteps = 20000;
+    std::mt19937 rng(0);
+    std::vector<PMap> maps(numOfVersions);
+    std::vector<RefMap> refs(numOfVersions);
+    /// the version each map was last copied from, for forEachUpdated
+    std::vector<PMap> bases(numOfVersions);
+    std::vector<RefMap> baseRefs(numOfVersions);
+
+    for (u32_t step = 0; step < numOfSteps && numOfFailures == 0; ++step)
+    {
+        u32_t i = rng() % numOfVersions;
+        u32_t j = rng() % numOfVersions;
+        switch (rng() % 8)
+        {
+        case 0:
+        case 1:
+        case 2:
+        {
+            u32_t key = randomKey(rng);
+            s64_t val = rng() % 100;
+            maps[i][key] = val;
+            refs[i][key] = val;
+            break;
+        }
+        case 3:
+        {
+            u32_t key = rng() % 2 && !refs[i].empty() ? refs[i].begin()->first : randomKey(rng);
+            auto it = maps[i].find(key);
+            auto rit = refs[i].find(key);
+            check((it == maps[i].end()) == (rit == refs[i].end()), "find", step);
+            if (it != maps[i].end() && rit != refs[i].end())
+                check(it->second == rit->second, "find value", step);
+            break;
+        }
+        case 4:
+        {
+            maps[i] = maps[j];
+            refs[i] = refs[j];
+            bases[i] = maps[i];
+            baseRefs[i] = refs[i];
+            break;
+        }
+        case 5:
+        {
+            /// join: max of the values of both keys, adding the missing ones
+            bool addMissing = rng() % 2;
+            maps[i].mergeWith(maps[j], [](s64_t& mine, const s64_t& theirs)
+            {
+                mine = std::max(mine, theirs);
+            }, addMissing);
+            for (const auto& kv : refs[j])
+            {
+                auto rit = refs[i].find(kv.first);
+                if (rit != refs[i].end())
+                    rit->second = std::max(rit->second, kv.second);
+                else if (addMissing)
+                    refs[i].insert(kv);
+            }
+            break;
+        }
+        case 6:
+        {
+            bool eq = maps[i].equals(maps[j], [](const s64_t& a, const s64_t& b)
+            {
+                return a == b;
+            });
+            check(eq == (refs[i] == refs[j]), "equals", step);
+            break;
+        }
+        case 7:
+        {
+            /// all entries changed since the copy must be reported
+            RefMap updated;
+            maps[i].forEachUpdated(bases[i], [&](u32_t key, const s64_t& val)
+            {
+                updated[key] = val;
+            });
+            for (const auto& kv : refs[i])
+            {
+                auto bit = baseRefs[i].find(kv.first);
+                if (bit == baseRefs[i].end() || bit->second != kv.second)
+                    check(updated.count(kv.first) && updated[kv.first] == kv.second, "forEachUpdated", step);
+            }
+            break;
+        }
+        }
+        check(maps[i].size() == refs[i].size(), "size", step);
+        if (step % 64 == 0)
+            check(toRef(maps[i]) == refs[i], "entries", step);
+    }
+    for (u32_t i = 0; i < numOfVersions; ++i)
+        check(toRef(maps[i]) == refs[i], "final entries", numOfSteps);
+
+    if (numOfFailures > 0)
+    {
+        std::cerr << numOfFailures << " checks failed\n";
+        return 1;
+    }
+    std::cout << numOfSteps << " steps on " << numOfVersions << " versions match std::map\n";
+    return 0;
+}